@@ -1,95 +1,9 @@
+// Build: gcc -O2 -o Cpart2 Cpart2.c sort.c
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 
-// Global variable to count key comparisons
-int key_comparisons = 0;
-
-// Function prototypes
-void insertion_sort(int arr[], int left, int right);
-void merge(int arr[], int left, int mid, int right);
-void hybrid_merge_sort(int arr[], int left, int right, int threshold);
-void generate_random_array(int arr[], int size, int max_value);
-
-void insertion_sort(int arr[], int left, int right) {
-    int i, j, key;
-    for (i = left + 1; i <= right; i++) {
-        key = arr[i];
-        j = i - 1;
-        while (j >= left && arr[j] > key) {
-            key_comparisons++;
-            arr[j + 1] = arr[j];
-            j--;
-        }
-        arr[j + 1] = key;
-        if (j >= left) {
-            key_comparisons++;
-        }
-    }
-}
-
-void merge(int arr[], int left, int mid, int right) {
-    int n1 = mid - left + 1;
-    int n2 = right - mid;
-
-    int *L = (int *)malloc(n1 * sizeof(int));
-    int *R = (int *)malloc(n2 * sizeof(int));
-
-    for (int i = 0; i < n1; i++)
-        L[i] = arr[left + i];
-    for (int j = 0; j < n2; j++)
-        R[j] = arr[mid + 1 + j];
-
-    int i = 0, j = 0, k = left;
-
-    while (i < n1 && j < n2) {
-        key_comparisons++;
-        if (L[i] <= R[j]) {
-            arr[k] = L[i];
-            i++;
-        } else {
-            arr[k] = R[j];
-            j++;
-        }
-        k++;
-    }
-
-    while (i < n1) {
-        arr[k] = L[i];
-        i++;
-        k++;
-    }
-
-    while (j < n2) {
-        arr[k] = R[j];
-        j++;
-        k++;
-    }
-
-    free(L);
-    free(R);
-}
-
-void hybrid_merge_sort(int arr[], int left, int right, int threshold) {
-    if (left < right) {
-        if ((right - left + 1) <= threshold) {
-            insertion_sort(arr, left, right);
-        } else {
-            int mid = (left + right) / 2;
-
-            hybrid_merge_sort(arr, left, mid, threshold);
-            hybrid_merge_sort(arr, mid + 1, right, threshold);
-
-            merge(arr, left, mid, right);
-        }
-    }
-}
-
-void generate_random_array(int arr[], int size, int max_value) {
-    for (int i = 0; i < size; i++) {
-        arr[i] = rand() % max_value + 1; // Generate a random number in the range [1, max_value]
-    }
-}
+#include "sort.h"
 
 int main() {
     // Seed the random number generator
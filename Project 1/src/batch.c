@@ -0,0 +1,319 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "batch.h"
+#include "sort.h"
+
+// Arrays of at least 2 * SPLIT_CHUNK elements are split into a power-of-two number of chunks
+// (at most one per worker, each at least SPLIT_CHUNK long) that are merged back pairwise.
+#define SPLIT_CHUNK 131072
+// Arrays below PACK_LIMIT elements are packed into tasks of about PACK_ELEMENTS elements.
+#define PACK_LIMIT 65536
+#define PACK_ELEMENTS 262144
+
+// A piece of work: the jobs in order[first .. first + count - 1] sorted whole, or merge tree node
+// `node` when node >= 0
+struct task {
+    int first;
+    int count;
+    int node;
+};
+
+// A node of the merge tree of a split array. Nodes of one array are stored heap-style
+// from nodes[base + 1] (the whole array) to nodes[base + 2k - 1] (the k chunks).
+struct merge_node {
+    int job;
+    int base;
+    int left, mid, right;
+    int pending;  // Children still to finish before this node can be merged
+};
+
+struct worker {
+    struct batch_sorter *sorter;
+    pthread_t thread;
+    int *scratch;
+    int scratch_size;
+};
+
+struct batch_sorter {
+    int threads;
+    int threshold;
+    struct worker *workers;
+
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    long generation;  // Bumped for every batch
+    int active;       // Workers still running the current batch
+    int stopping;
+
+    // The current batch; the arrays are kept and grown across batches
+    struct sort_job *jobs;
+    long *order;  // (size << 32 | job) of every job, largest first
+    struct task *tasks;
+    int task_count, task_capacity;
+    int next_task;
+    struct merge_node *nodes;
+    int node_capacity;
+    int order_capacity;
+    double start;
+};
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void ensure_scratch(struct worker *w, int n) {
+    if (n > w->scratch_size) {
+        w->scratch_size = n;
+        w->scratch = (int *)realloc(w->scratch, n * sizeof(int));
+    }
+}
+
+static void run_whole(struct batch_sorter *s, struct worker *w, const struct task *t) {
+    for (int i = t->first; i < t->first + t->count; i++) {
+        struct sort_job *job = &s->jobs[(int)s->order[i]];
+        long comparisons = 0;
+
+        ensure_scratch(w, (job->size + 2) / 2);
+        hybrid_merge_sort_r(job->arr, 0, job->size - 1, s->threshold, w->scratch, &comparisons);
+        job->comparisons = comparisons;
+        job->latency = now_seconds() - s->start;
+    }
+}
+
+// Sort one chunk, then keep merging upwards for as long as this worker finished the last child
+static void run_chunk(struct batch_sorter *s, struct worker *w, const struct task *t) {
+    struct merge_node *node = &s->nodes[t->node];
+    struct sort_job *job = &s->jobs[node->job];
+    int base = node->base;
+    int local = t->node - base;
+    long comparisons = 0;
+
+    ensure_scratch(w, (node->right - node->left + 2) / 2);
+    hybrid_merge_sort_r(job->arr, node->left, node->right, s->threshold, w->scratch, &comparisons);
+
+    while (local > 1) {
+        local /= 2;
+        node = &s->nodes[base + local];
+        if (__atomic_sub_fetch(&node->pending, 1, __ATOMIC_ACQ_REL) != 0) {
+            local = 0;
+            break;
+        }
+        ensure_scratch(w, node->mid - node->left + 1);
+        merge_r(job->arr, node->left, node->mid, node->right, w->scratch, &comparisons);
+    }
+
+    __atomic_add_fetch(&job->comparisons, comparisons, __ATOMIC_RELAXED);
+    if (local == 1) {
+        job->latency = now_seconds() - s->start;
+    }
+}
+
+static void *worker_main(void *arg) {
+    struct worker *w = (struct worker *)arg;
+    struct batch_sorter *s = w->sorter;
+    long seen = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&s->lock);
+        while (s->generation == seen && !s->stopping) {
+            pthread_cond_wait(&s->work_ready, &s->lock);
+        }
+        if (s->stopping) {
+            pthread_mutex_unlock(&s->lock);
+            return NULL;
+        }
+        seen = s->generation;
+        pthread_mutex_unlock(&s->lock);
+
+        for (;;) {
+            int i = __atomic_fetch_add(&s->next_task, 1, __ATOMIC_RELAXED);
+            if (i >= s->task_count) {
+                break;
+            }
+            if (s->tasks[i].node >= 0) {
+                run_chunk(s, w, &s->tasks[i]);
+            } else {
+                run_whole(s, w, &s->tasks[i]);
+            }
+        }
+
+        pthread_mutex_lock(&s->lock);
+        if (--s->active == 0) {
+            pthread_cond_signal(&s->work_done);
+        }
+        pthread_mutex_unlock(&s->lock);
+    }
+}
+
+struct batch_sorter *batch_sorter_create(int threads, int threshold) {
+    if (threads <= 0) {
+        threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (threads <= 0) {
+            threads = 1;
+        }
+    }
+
+    struct batch_sorter *s = (struct batch_sorter *)calloc(1, sizeof(struct batch_sorter));
+    s->threads = threads;
+    s->threshold = threshold;
+    s->workers = (struct worker *)calloc(threads, sizeof(struct worker));
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->work_ready, NULL);
+    pthread_cond_init(&s->work_done, NULL);
+
+    for (int i = 0; i < threads; i++) {
+        s->workers[i].sorter = s;
+        if (pthread_create(&s->workers[i].thread, NULL, worker_main, &s->workers[i]) != 0) {
+            fprintf(stderr, "Failed to start batch sort worker %d.\n", i);
+            s->threads = i;
+            batch_sorter_destroy(s);
+            return NULL;
+        }
+    }
+    return s;
+}
+
+int batch_sorter_threads(struct batch_sorter *sorter) {
+    return sorter->threads;
+}
+
+static void add_task(struct batch_sorter *s, int first, int count, int node) {
+    if (s->task_count == s->task_capacity) {
+        s->task_capacity = s->task_capacity ? 2 * s->task_capacity : 1024;
+        s->tasks = (struct task *)realloc(s->tasks, s->task_capacity * sizeof(struct task));
+    }
+    s->tasks[s->task_count].first = first;
+    s->tasks[s->task_count].count = count;
+    s->tasks[s->task_count].node = node;
+    s->task_count++;
+}
+
+// Set up the merge tree of a job split into k chunks and queue one task per chunk.
+// Returns the number of nodes used.
+static int add_split_job(struct batch_sorter *s, int job, int k, int base) {
+    struct merge_node *nodes = &s->nodes[base];
+    int size = s->jobs[job].size;
+
+    for (int i = 0; i < k; i++) {
+        struct merge_node *leaf = &nodes[k + i];
+        leaf->left = (int)((long)size * i / k);
+        leaf->right = (int)((long)size * (i + 1) / k) - 1;
+    }
+    for (int l = k - 1; l >= 1; l--) {
+        nodes[l].left = nodes[2 * l].left;
+        nodes[l].mid = nodes[2 * l].right;
+        nodes[l].right = nodes[2 * l + 1].right;
+        nodes[l].pending = 2;
+    }
+    for (int l = 1; l < 2 * k; l++) {
+        nodes[l].job = job;
+        nodes[l].base = base;
+    }
+    for (int i = 0; i < k; i++) {
+        add_task(s, -1, 1, base + k + i);
+    }
+    return 2 * k;
+}
+
+// Number of chunks to split an array into, 1 to sort it whole
+static int split_count(struct batch_sorter *s, int size) {
+    int k = 1;
+    while (2 * k <= s->threads && (long)size / (2 * k) >= SPLIT_CHUNK) {
+        k *= 2;
+    }
+    return k;
+}
+
+static int compare_descending(const void *a, const void *b) {
+    long x = *(const long *)a, y = *(const long *)b;
+    return (x < y) - (x > y);
+}
+
+void batch_sort(struct batch_sorter *s, struct sort_job jobs[], int count) {
+    s->start = now_seconds();
+    s->jobs = jobs;
+    s->task_count = 0;
+    s->next_task = 0;
+
+    // Largest arrays first, so that the long tasks do not end up last on one worker
+    if (count > s->order_capacity) {
+        s->order_capacity = count;
+        s->order = (long *)realloc(s->order, count * sizeof(long));
+    }
+    for (int i = 0; i < count; i++) {
+        s->order[i] = (long)jobs[i].size << 32 | i;
+        jobs[i].comparisons = 0;
+        jobs[i].latency = 0;
+    }
+    qsort(s->order, count, sizeof(long), compare_descending);
+
+    int nodes_needed = 0;
+    for (int i = 0; i < count; i++) {
+        int k = split_count(s, jobs[(int)s->order[i]].size);
+        if (k == 1) {
+            break;
+        }
+        nodes_needed += 2 * k;
+    }
+    if (nodes_needed > s->node_capacity) {
+        s->node_capacity = nodes_needed;
+        s->nodes = (struct merge_node *)realloc(s->nodes, nodes_needed * sizeof(struct merge_node));
+    }
+
+    int used = 0;
+    for (int i = 0; i < count;) {
+        int size = jobs[(int)s->order[i]].size;
+        int k = split_count(s, size);
+        if (k > 1) {
+            used += add_split_job(s, (int)s->order[i], k, used);
+            i++;
+        } else if (size >= PACK_LIMIT) {
+            add_task(s, i, 1, -1);
+            i++;
+        } else {
+            int first = i;
+            long elements = 0;
+            while (i < count && elements < PACK_ELEMENTS) {
+                elements += jobs[(int)s->order[i]].size;
+                i++;
+            }
+            add_task(s, first, i - first, -1);
+        }
+    }
+
+    pthread_mutex_lock(&s->lock);
+    s->active = s->threads;
+    s->generation++;
+    pthread_cond_broadcast(&s->work_ready);
+    while (s->active > 0) {
+        pthread_cond_wait(&s->work_done, &s->lock);
+    }
+    pthread_mutex_unlock(&s->lock);
+}
+
+void batch_sorter_destroy(struct batch_sorter *s) {
+    pthread_mutex_lock(&s->lock);
+    s->stopping = 1;
+    pthread_cond_broadcast(&s->work_ready);
+    pthread_mutex_unlock(&s->lock);
+
+    for (int i = 0; i < s->threads; i++) {
+        pthread_join(s->workers[i].thread, NULL);
+        free(s->workers[i].scratch);
+    }
+    pthread_mutex_destroy(&s->lock);
+    pthread_cond_destroy(&s->work_ready);
+    pthread_cond_destroy(&s->work_done);
+    free(s->workers);
+    free(s->order);
+    free(s->tasks);
+    free(s->nodes);
+    free(s);
+}
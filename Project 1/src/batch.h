@@ -0,0 +1,32 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+// Batch sort service: sorts many independent arrays concurrently with hybrid_merge_sort_r.
+// Arrays are scheduled largest first; large arrays are split into chunks that are sorted on
+// several workers and merged back, small arrays are packed several to a task, and every worker
+// keeps its merge scratch buffer from one batch to the next.
+
+// One array to sort. latency and comparisons are filled in by batch_sort().
+struct sort_job {
+    int *arr;
+    int size;
+    double latency;     // Seconds from the start of batch_sort() until this array was sorted
+    long comparisons;   // Key comparisons spent on this array
+};
+
+struct batch_sorter;
+
+// Create a pool of threads workers (0 = one per online CPU) sorting with the given
+// insertion sort threshold. Returns NULL if the threads cannot be started.
+struct batch_sorter *batch_sorter_create(int threads, int threshold);
+
+// Number of worker threads in the pool
+int batch_sorter_threads(struct batch_sorter *sorter);
+
+// Sort every jobs[i].arr in place and return once all of them are sorted.
+// Only one batch may run on a sorter at a time.
+void batch_sort(struct batch_sorter *sorter, struct sort_job jobs[], int count);
+
+void batch_sorter_destroy(struct batch_sorter *sorter);
+
+#endif
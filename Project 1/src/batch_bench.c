@@ -0,0 +1,148 @@
+// Build: gcc -O2 -pthread -o batch_bench batch_bench.c batch.c sort.c -lm
+// Usage: ./batch_bench [arrays=500] [min size=10000] [max size=1000000] [threads=all CPUs] [threshold=16] [batches=3]
+// Sorts a batch of independent random arrays (sizes log-uniform between min and max) with the
+// batch sort service and, for comparison, one array after the other with hybrid_merge_sort as
+// withTime.c does. Every batch is checked and written to batch_results.csv.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "batch.h"
+#include "sort.h"
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const double sorted[], int n, double p) {
+    return n > 0 ? sorted[(int)(p * (n - 1) + 0.5)] : 0;
+}
+
+// Check that arr is sorted and holds the same elements as input (by sum), 1 if it does
+static int check_sorted(const int arr[], const int input[], int size) {
+    long sum = 0, expected = 0;
+    for (int i = 0; i < size; i++) {
+        if (i > 0 && arr[i - 1] > arr[i]) {
+            return 0;
+        }
+        sum += arr[i];
+        expected += input[i];
+    }
+    return sum == expected;
+}
+
+int main(int argc, char *argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 500;
+    int min_size = argc > 2 ? atoi(argv[2]) : 10000;
+    int max_size = argc > 3 ? atoi(argv[3]) : 1000000;
+    int threads = argc > 4 ? atoi(argv[4]) : 0;
+    int threshold = argc > 5 ? atoi(argv[5]) : 16;
+    int batches = argc > 6 ? atoi(argv[6]) : 3;
+    int max_value = 1000000;
+
+    if (count <= 0 || min_size <= 0 || max_size < min_size || batches <= 0) {
+        fprintf(stderr, "Usage: batch_bench [arrays] [min size] [max size] [threads] [threshold] [batches]\n");
+        return 1;
+    }
+    srand(12345);
+
+    struct sort_job *jobs = (struct sort_job *)malloc(count * sizeof(struct sort_job));
+    int **inputs = (int **)malloc(count * sizeof(int *));
+    double *latency = (double *)malloc(count * sizeof(double));
+    long total = 0;
+    for (int i = 0; i < count; i++) {
+        double u = (double)rand() / RAND_MAX;
+        int size = (int)(min_size * pow((double)max_size / min_size, u));
+        inputs[i] = (int *)malloc(size * sizeof(int));
+        jobs[i].arr = (int *)malloc(size * sizeof(int));
+        if (inputs[i] == NULL || jobs[i].arr == NULL) {
+            fprintf(stderr, "Memory allocation failed for array %d of size %d!\n", i, size);
+            return 1;
+        }
+        jobs[i].size = size;
+        generate_random_array(inputs[i], size, max_value);
+        total += size;
+    }
+
+    struct batch_sorter *sorter = batch_sorter_create(threads, threshold);
+    if (sorter == NULL) {
+        return 1;
+    }
+    threads = batch_sorter_threads(sorter);
+
+    FILE *file = fopen("batch_results.csv", "w");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening file for writing.\n");
+        return 1;
+    }
+    fprintf(file, "Mode,Threads,Batch,Arrays,Elements,Time Taken (seconds),Elements per Second,"
+                  "p50 Latency (ms),p90 Latency (ms),p99 Latency (ms),Max Latency (ms),Key Comparisons\n");
+
+    printf("%d arrays, %ld elements, %d worker threads, threshold %d\n", count, total, threads, threshold);
+    printf("%-10s %5s %10s %14s %10s %10s %10s %10s %14s\n", "mode", "batch", "seconds", "elements/s",
+           "p50 ms", "p90 ms", "p99 ms", "max ms", "comparisons");
+
+    long mismatches = 0;
+    for (int mode = 0; mode < 2; mode++) {
+        const char *name = mode == 0 ? "sequential" : "batch";
+        for (int b = 0; b < batches; b++) {
+            for (int i = 0; i < count; i++) {
+                memcpy(jobs[i].arr, inputs[i], jobs[i].size * sizeof(int));
+            }
+
+            long comparisons = 0;
+            double start = now_seconds();
+            if (mode == 0) {
+                // One array at a time; an array's latency includes the wait for the ones before it
+                for (int i = 0; i < count; i++) {
+                    key_comparisons = 0;
+                    hybrid_merge_sort(jobs[i].arr, 0, jobs[i].size - 1, threshold);
+                    jobs[i].comparisons = key_comparisons;
+                    jobs[i].latency = now_seconds() - start;
+                }
+            } else {
+                batch_sort(sorter, jobs, count);
+            }
+            double elapsed = now_seconds() - start;
+
+            for (int i = 0; i < count; i++) {
+                if (!check_sorted(jobs[i].arr, inputs[i], jobs[i].size)) {
+                    mismatches++;
+                }
+                latency[i] = jobs[i].latency * 1e3;
+                comparisons += jobs[i].comparisons;
+            }
+            qsort(latency, count, sizeof(double), compare_doubles);
+
+            double p50 = percentile(latency, count, 0.50);
+            double p90 = percentile(latency, count, 0.90);
+            double p99 = percentile(latency, count, 0.99);
+            printf("%-10s %5d %10.3f %14.0f %10.1f %10.1f %10.1f %10.1f %14ld\n", name, b, elapsed,
+                   total / elapsed, p50, p90, p99, latency[count - 1], comparisons);
+            fprintf(file, "%s,%d,%d,%d,%ld,%f,%.0f,%.3f,%.3f,%.3f,%.3f,%ld\n", name, mode == 0 ? 1 : threads,
+                    b, count, total, elapsed, total / elapsed, p50, p90, p99, latency[count - 1], comparisons);
+        }
+    }
+    fclose(file);
+
+    batch_sorter_destroy(sorter);
+    for (int i = 0; i < count; i++) {
+        free(inputs[i]);
+        free(jobs[i].arr);
+    }
+    free(inputs);
+    free(jobs);
+    free(latency);
+
+    printf("Results have been saved to batch_results.csv (%ld mismatches)\n", mismatches);
+    return mismatches != 0;
+}
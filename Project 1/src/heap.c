@@ -0,0 +1,50 @@
+#include "heap.h"
+
+static void swap(int *x, int *y) {
+    int temp = *x;
+    *x = *y;
+    *y = temp;
+}
+
+void fix_heap(int heap[], int size, int root, long *comparisons) {
+    int smallest = root;
+    int left = 2 * root + 1;
+    int right = 2 * root + 2;
+
+    // Compare root with its children and find the smallest element
+    if (left < size) {
+        (*comparisons)++;
+        if (heap[left] < heap[smallest]) {
+            smallest = left;
+        }
+    }
+    if (right < size) {
+        (*comparisons)++;
+        if (heap[right] < heap[smallest]) {
+            smallest = right;
+        }
+    }
+
+    // If the smallest is not the root, swap and recursively fix the heap
+    if (smallest != root) {
+        swap(&heap[root], &heap[smallest]);
+        fix_heap(heap, size, smallest, comparisons);
+    }
+}
+
+void build_heap(int heap[], int size, long *comparisons) {
+    for (int i = size / 2 - 1; i >= 0; i--) {
+        fix_heap(heap, size, i, comparisons);
+    }
+}
+
+int delete_min(int heap[], int *size, long *comparisons) {
+    int root = heap[0];
+
+    // Move the last element to the root and restore the heap property
+    heap[0] = heap[*size - 1];
+    (*size)--;
+    fix_heap(heap, *size, 0, comparisons);
+
+    return root;
+}
@@ -0,0 +1,16 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+// The array min-heap of Project 2/test/partB.c (fixHeap, buildHeap, deleteMin), with every
+// key comparison counted into *comparisons.
+
+// Restore the heap property below root after heap[root] grew
+void fix_heap(int heap[], int size, int root, long *comparisons);
+
+// Turn heap[0 .. size - 1] into a min-heap, bottom up
+void build_heap(int heap[], int size, long *comparisons);
+
+// Remove and return the minimum, shrinking *size by one
+int delete_min(int heap[], int *size, long *comparisons);
+
+#endif
@@ -0,0 +1,148 @@
+// Build: gcc -O2 -o lowmem_bench lowmem_bench.c sort.c
+// Usage: ./lowmem_bench [size=10000000] [threshold=16] [repetitions=1]
+// Sorts the same random array with each merge mode in a child process of its own, so that the
+// peak RSS reported by wait4() belongs to that mode alone, and writes lowmem_results.csv.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "sort.h"
+
+enum merge_mode { MODE_MALLOC, MODE_BUFFERED, MODE_SQRT, MODE_IN_PLACE };
+static const char *mode_names[] = {"malloc", "buffered", "sqrt", "in-place"};
+
+// What a child reports back through the pipe
+struct mode_result {
+    double seconds;
+    long comparisons;
+    long extra_ints;
+    int sorted;
+};
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void run_mode(int mode, int size, int threshold, unsigned seed, struct mode_result *result) {
+    int *arr = (int *)malloc(size * sizeof(int));
+    int *buffer = NULL;
+    int buffer_size = 0;
+
+    srand(seed);
+    generate_random_array(arr, size, 1000000);
+    if (mode == MODE_BUFFERED) {
+        buffer_size = size / 2 + 1;
+    } else if (mode == MODE_SQRT) {
+        while ((long)buffer_size * buffer_size < size) {
+            buffer_size++;
+        }
+    }
+    if (buffer_size > 0) {
+        buffer = (int *)malloc(buffer_size * sizeof(int));
+    }
+
+    result->comparisons = 0;
+    result->extra_ints = buffer_size;
+    double start = now_seconds();
+    switch (mode) {
+    case MODE_MALLOC:
+        key_comparisons = 0;
+        hybrid_merge_sort(arr, 0, size - 1, threshold);
+        result->comparisons = key_comparisons;
+        result->extra_ints = size;  // L[] and R[] of the top merge
+        break;
+    case MODE_BUFFERED:
+        hybrid_merge_sort_r(arr, 0, size - 1, threshold, buffer, &result->comparisons);
+        break;
+    default:
+        hybrid_merge_sort_low_memory_r(arr, 0, size - 1, threshold, buffer, buffer_size, &result->comparisons);
+        break;
+    }
+    result->seconds = now_seconds() - start;
+
+    result->sorted = 1;
+    for (int i = 1; i < size; i++) {
+        if (arr[i - 1] > arr[i]) {
+            result->sorted = 0;
+            break;
+        }
+    }
+    free(buffer);
+    free(arr);
+}
+
+int main(int argc, char *argv[]) {
+    int size = argc > 1 ? atoi(argv[1]) : 10000000;
+    int threshold = argc > 2 ? atoi(argv[2]) : 16;
+    int repetitions = argc > 3 ? atoi(argv[3]) : 1;
+    if (size <= 0 || repetitions <= 0) {
+        fprintf(stderr, "Usage: lowmem_bench [size] [threshold] [repetitions]\n");
+        return 1;
+    }
+
+    FILE *file = fopen("lowmem_results.csv", "w");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening file for writing.\n");
+        return 1;
+    }
+    fprintf(file, "Mode,Size,Threshold,Repetition,Key Comparisons,Time Taken (seconds),Extra Memory (bytes),"
+                  "Peak RSS (KB)\n");
+
+    printf("n = %d, threshold %d, input %.1f MB\n", size, threshold, size * sizeof(int) / 1048576.0);
+    printf("%-10s %12s %14s %14s %14s\n", "mode", "seconds", "comparisons", "extra MB", "peak RSS MB");
+
+    long mismatches = 0;
+    for (int r = 0; r < repetitions; r++) {
+        for (int mode = MODE_MALLOC; mode <= MODE_IN_PLACE; mode++) {
+            int fds[2];
+            if (pipe(fds) != 0) {
+                perror("pipe");
+                return 1;
+            }
+
+            struct mode_result result;
+            pid_t pid = fork();
+            if (pid < 0) {
+                perror("fork");
+                return 1;
+            }
+            if (pid == 0) {
+                close(fds[0]);
+                run_mode(mode, size, threshold, 12345 + r, &result);
+                _exit(write(fds[1], &result, sizeof(result)) == sizeof(result) ? 0 : 1);
+            }
+            close(fds[1]);
+
+            int status;
+            struct rusage usage;
+            ssize_t got = read(fds[0], &result, sizeof(result));
+            close(fds[0]);
+            if (wait4(pid, &status, 0, &usage) < 0 || got != sizeof(result) || !WIFEXITED(status) ||
+                WEXITSTATUS(status) != 0) {
+                fprintf(stderr, "The %s run failed.\n", mode_names[mode]);
+                mismatches++;
+                continue;
+            }
+            if (!result.sorted) {
+                mismatches++;
+            }
+
+            printf("%-10s %12.3f %14ld %14.2f %14.1f\n", mode_names[mode], result.seconds, result.comparisons,
+                   result.extra_ints * sizeof(int) / 1048576.0, usage.ru_maxrss / 1024.0);
+            fprintf(file, "%s,%d,%d,%d,%ld,%f,%ld,%ld\n", mode_names[mode], size, threshold, r,
+                    result.comparisons, result.seconds, result.extra_ints * (long)sizeof(int), usage.ru_maxrss);
+        }
+    }
+    fclose(file);
+
+    printf("Results have been saved to lowmem_results.csv (%ld mismatches)\n", mismatches);
+    return mismatches != 0;
+}
@@ -0,0 +1,182 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "select.h"
+#include "heap.h"
+#include "sort.h"
+
+// Ranges of at most this many elements are finished with insertion sort
+#define SELECT_THRESHOLD 16
+
+// Quickselect levels allowed per log2(n) before switching to median-of-medians pivots
+#ifndef SELECT_DEPTH_FACTOR
+#define SELECT_DEPTH_FACTOR 2
+#endif
+
+static void select_range(int arr[], int lo, int hi, int k, int depth, long *comparisons);
+
+static void swap(int *x, int *y) {
+    int temp = *x;
+    *x = *y;
+    *y = temp;
+}
+
+static int median_of_three(int a, int b, int c, long *comparisons) {
+    (*comparisons) += 2;
+    if (a < b) {
+        if (b < c) {
+            return b;
+        }
+        (*comparisons)++;
+        return a < c ? c : a;
+    }
+    if (a < c) {
+        return a;
+    }
+    (*comparisons)++;
+    return b < c ? c : b;
+}
+
+// Median of the medians of groups of five: moves the group medians to the front of the range
+// and selects their median with median-of-medians pivots throughout
+static int median_of_medians(int arr[], int lo, int hi, long *comparisons) {
+    int groups = 0;
+    for (int left = lo; left <= hi; left += 5) {
+        int right = left + 4 < hi ? left + 4 : hi;
+        insertion_sort_r(arr, left, right, comparisons);
+        swap(&arr[lo + groups], &arr[(left + right) / 2]);
+        groups++;
+    }
+
+    int mid = lo + (groups - 1) / 2;
+    select_range(arr, lo, lo + groups - 1, mid, 0, comparisons);
+    return arr[mid];
+}
+
+// Three-way partition around pivot: arr[lo .. *lt - 1] < pivot, arr[*lt .. *gt] == pivot,
+// arr[*gt + 1 .. hi] > pivot. Equal keys are grouped, so duplicates cannot make it quadratic.
+static void partition3(int arr[], int lo, int hi, int pivot, int *lt, int *gt, long *comparisons) {
+    int i = lo;
+    *lt = lo;
+    *gt = hi;
+    while (i <= *gt) {
+        (*comparisons)++;
+        if (arr[i] < pivot) {
+            swap(&arr[(*lt)++], &arr[i++]);
+            continue;
+        }
+        (*comparisons)++;
+        if (arr[i] > pivot) {
+            swap(&arr[i], &arr[(*gt)--]);
+        } else {
+            i++;
+        }
+    }
+}
+
+static void select_range(int arr[], int lo, int hi, int k, int depth, long *comparisons) {
+    int bad_split = 0;
+    while (hi - lo + 1 > SELECT_THRESHOLD) {
+        int size = hi - lo + 1;
+        int pivot, lt, gt;
+        if (depth > 0 && !bad_split) {
+            depth--;
+            pivot = median_of_three(arr[lo], arr[lo + (hi - lo) / 2], arr[hi], comparisons);
+        } else {
+            pivot = median_of_medians(arr, lo, hi, comparisons);
+        }
+
+        partition3(arr, lo, hi, pivot, &lt, &gt, comparisons);
+        if (k < lt) {
+            hi = lt - 1;
+        } else if (k > gt) {
+            lo = gt + 1;
+        } else {
+            return;
+        }
+
+        // A split that keeps more than 3/4 of the range is followed by a guaranteed one
+        bad_split = hi - lo + 1 > size - size / 4;
+    }
+    insertion_sort_r(arr, lo, hi, comparisons);
+}
+
+void nth_element(int arr[], int n, int k, long *comparisons) {
+    if (k < 0 || k >= n) {
+        return;
+    }
+    int depth = 0;
+    for (int m = n; m > 1; m /= 2) {
+        depth += SELECT_DEPTH_FACTOR;
+    }
+    select_range(arr, 0, n - 1, k, depth, comparisons);
+}
+
+void partial_sort(int arr[], int n, int k, long *comparisons) {
+    if (k > n) {
+        k = n;
+    }
+    if (k <= 0) {
+        return;
+    }
+
+    nth_element(arr, n, k - 1, comparisons);
+    int *scratch = (int *)malloc(((k + 1) / 2 + 1) * sizeof(int));
+    hybrid_merge_sort_r(arr, 0, k - 1, SELECT_THRESHOLD, scratch, comparisons);
+    free(scratch);
+}
+
+void topk_init(struct topk *acc, int k) {
+    acc->heap = (int *)malloc((k > 0 ? k : 1) * sizeof(int));
+    acc->k = k;
+    acc->size = 0;
+    acc->comparisons = 0;
+}
+
+void topk_add(struct topk *acc, const int chunk[], int n) {
+    int i = 0;
+    if (acc->k <= 0) {
+        return;
+    }
+
+    // Fill up to k first and heapify once, rather than sifting every insertion
+    if (acc->size < acc->k) {
+        while (i < n && acc->size < acc->k) {
+            acc->heap[acc->size++] = ~chunk[i++];
+        }
+        if (acc->size == acc->k) {
+            build_heap(acc->heap, acc->size, &acc->comparisons);
+        }
+    }
+
+    // ~x is order reversing, so x beats the largest kept element when ~x > heap[0]
+    for (; i < n; i++) {
+        acc->comparisons++;
+        if (~chunk[i] > acc->heap[0]) {
+            acc->heap[0] = ~chunk[i];
+            fix_heap(acc->heap, acc->size, 0, &acc->comparisons);
+        }
+    }
+}
+
+int topk_result(struct topk *acc, int out[]) {
+    int size = acc->size;
+    int *heap = (int *)malloc((size > 0 ? size : 1) * sizeof(int));
+    memcpy(heap, acc->heap, size * sizeof(int));
+    if (size < acc->k) {
+        build_heap(heap, size, &acc->comparisons);
+    }
+
+    // The heap gives the largest kept element first
+    for (int i = size - 1, left = size; i >= 0; i--) {
+        out[i] = ~delete_min(heap, &left, &acc->comparisons);
+    }
+    free(heap);
+    return size;
+}
+
+void topk_free(struct topk *acc) {
+    free(acc->heap);
+    acc->heap = NULL;
+    acc->k = acc->size = 0;
+}
@@ -0,0 +1,36 @@
+#ifndef SELECT_H
+#define SELECT_H
+
+// Selection and partial sorting for when only the smallest k elements or the k-th order
+// statistic are needed. All functions count key comparisons into *comparisons, the same way
+// hybrid_merge_sort_r does, so the costs can be set against a full sort.
+
+// Rearrange arr[0 .. n - 1] so that arr[k] is the element a full sort would put there, with
+// nothing greater before it and nothing smaller after it. Introselect: quickselect with a
+// median-of-three pivot, taking a median-of-medians pivot after any split that kept more than
+// 3/4 of the range and for good once 2 log2(n) levels are used, so the worst case stays O(n).
+void nth_element(int arr[], int n, int k, long *comparisons);
+
+// Put the k smallest elements of arr[0 .. n - 1] in sorted order at the front, the rest in
+// unspecified order behind them. O(n + k log k).
+void partial_sort(int arr[], int n, int k, long *comparisons);
+
+// Streaming top-k: keeps the k smallest elements seen so far in a bounded max-heap,
+// so a stream of any length is reduced in O(k) memory and O(n log k) comparisons.
+struct topk {
+    int *heap;        // Complemented keys (~x) in a min-heap, so the root is the largest kept
+    int k;
+    int size;
+    long comparisons;
+};
+
+void topk_init(struct topk *acc, int k);
+void topk_add(struct topk *acc, const int chunk[], int n);
+
+// Write the kept elements to out[] in ascending order, returns how many there are (at most k).
+// The accumulator can keep consuming afterwards.
+int topk_result(struct topk *acc, int out[]);
+
+void topk_free(struct topk *acc);
+
+#endif
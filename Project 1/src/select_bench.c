@@ -0,0 +1,146 @@
+// Build: gcc -O2 -o select_bench select_bench.c select.c heap.c sort.c
+// Usage: ./select_bench [size=1000000] [workload=random|sorted|reversed|equal|organ] [chunk=65536]
+// Compares nth_element, partial_sort and the streaming top-k accumulator against a full
+// hybrid merge sort for a range of k, checking every result against the full sort.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "select.h"
+#include "sort.h"
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Fill arr with the named workload, returns 0 if the name is unknown
+static int generate_workload(int arr[], int size, const char *workload) {
+    if (strcmp(workload, "random") == 0) {
+        generate_random_array(arr, size, 1000000);
+    } else if (strcmp(workload, "sorted") == 0) {
+        for (int i = 0; i < size; i++) arr[i] = i;
+    } else if (strcmp(workload, "reversed") == 0) {
+        for (int i = 0; i < size; i++) arr[i] = size - i;
+    } else if (strcmp(workload, "equal") == 0) {
+        for (int i = 0; i < size; i++) arr[i] = 42;
+    } else if (strcmp(workload, "organ") == 0) {
+        for (int i = 0; i < size; i++) arr[i] = i < size / 2 ? i : size - i;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+static void write_row(FILE *file, const char *workload, int size, int k, const char *algorithm,
+                      long comparisons, double seconds, long full) {
+    fprintf(file, "%s,%d,%d,%s,%ld,%f,%f\n", workload, size, k, algorithm, comparisons, seconds,
+            (double)comparisons / full);
+}
+
+int main(int argc, char *argv[]) {
+    int size = argc > 1 ? atoi(argv[1]) : 1000000;
+    const char *workload = argc > 2 ? argv[2] : "random";
+    int chunk = argc > 3 ? atoi(argv[3]) : 65536;
+    if (size <= 0 || chunk <= 0) {
+        fprintf(stderr, "Usage: select_bench [size] [workload] [chunk]\n");
+        return 1;
+    }
+
+    srand(12345);
+    int *input = (int *)malloc(size * sizeof(int));
+    int *sorted = (int *)malloc(size * sizeof(int));
+    int *arr = (int *)malloc(size * sizeof(int));
+    int *scratch = (int *)malloc((size / 2 + 1) * sizeof(int));
+    if (input == NULL || sorted == NULL || arr == NULL || scratch == NULL) {
+        fprintf(stderr, "Memory allocation failed for size %d!\n", size);
+        return 1;
+    }
+    if (!generate_workload(input, size, workload)) {
+        fprintf(stderr, "Unknown workload %s\n", workload);
+        return 1;
+    }
+
+    // The full sort everything is measured against
+    long full = 0;
+    memcpy(sorted, input, size * sizeof(int));
+    double start = now_seconds();
+    hybrid_merge_sort_r(sorted, 0, size - 1, 16, scratch, &full);
+    double full_time = now_seconds() - start;
+
+    FILE *file = fopen("select_results.csv", "w");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening file for writing.\n");
+        return 1;
+    }
+    fprintf(file, "Workload,Size,K,Algorithm,Key Comparisons,Time Taken (seconds),Comparisons vs Full Sort\n");
+
+    printf("%s, n = %d: full sort %ld comparisons in %.3f s\n", workload, size, full, full_time);
+    printf("%10s %14s %8s %14s %8s %14s %8s\n", "k", "nth_element", "x full", "partial_sort", "x full",
+           "top-k stream", "x full");
+
+    int ks[] = {1, 10, 100, 1000, 10000, 100000, size / 2, size};
+    int num_ks = sizeof(ks) / sizeof(ks[0]);
+    int *out = (int *)malloc(size * sizeof(int));
+    long mismatches = 0;
+    for (int t = 0; t < num_ks; t++) {
+        int k = ks[t];
+        if (k < 1 || k > size || (t > 0 && k <= ks[t - 1])) {
+            continue;
+        }
+
+        // nth_element: arr[k - 1] is in place and partitions the array
+        long nth = 0;
+        memcpy(arr, input, size * sizeof(int));
+        start = now_seconds();
+        nth_element(arr, size, k - 1, &nth);
+        double nth_time = now_seconds() - start;
+        if (arr[k - 1] != sorted[k - 1]) {
+            mismatches++;
+        }
+        for (int i = 0; i < size; i++) {
+            if ((i < k - 1 && arr[i] > arr[k - 1]) || (i > k - 1 && arr[i] < arr[k - 1])) {
+                mismatches++;
+                break;
+            }
+        }
+
+        long partial = 0;
+        memcpy(arr, input, size * sizeof(int));
+        start = now_seconds();
+        partial_sort(arr, size, k, &partial);
+        double partial_time = now_seconds() - start;
+        mismatches += memcmp(arr, sorted, k * sizeof(int)) != 0;
+
+        // The top-k accumulator sees the input one chunk at a time
+        struct topk acc;
+        topk_init(&acc, k);
+        start = now_seconds();
+        for (int i = 0; i < size; i += chunk) {
+            topk_add(&acc, input + i, size - i < chunk ? size - i : chunk);
+        }
+        int kept = topk_result(&acc, out);
+        double topk_time = now_seconds() - start;
+        mismatches += kept != k || memcmp(out, sorted, k * sizeof(int)) != 0;
+
+        printf("%10d %14ld %8.3f %14ld %8.3f %14ld %8.3f\n", k, nth, (double)nth / full, partial,
+               (double)partial / full, acc.comparisons, (double)acc.comparisons / full);
+        write_row(file, workload, size, k, "nth_element", nth, nth_time, full);
+        write_row(file, workload, size, k, "partial_sort", partial, partial_time, full);
+        write_row(file, workload, size, k, "topk_stream", acc.comparisons, topk_time, full);
+        topk_free(&acc);
+    }
+    write_row(file, workload, size, size, "hybrid_merge_sort", full, full_time, full);
+    fclose(file);
+
+    free(input);
+    free(sorted);
+    free(arr);
+    free(scratch);
+    free(out);
+
+    printf("Results have been saved to select_results.csv (%ld mismatches)\n", mismatches);
+    return mismatches != 0;
+}
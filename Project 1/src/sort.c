@@ -0,0 +1,342 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sort.h"
+
+// Global variable to count key comparisons
+int key_comparisons = 0;
+
+void insertion_sort(int arr[], int left, int right) {
+    int i, j, key;
+    for (i = left + 1; i <= right; i++) {
+        key = arr[i];
+        j = i - 1;
+        while (j >= left && arr[j] > key) {
+            key_comparisons++;
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+        if (j >= left) {
+            key_comparisons++;
+        }
+    }
+}
+
+void merge(int arr[], int left, int mid, int right) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+
+    int *L = (int *)malloc(n1 * sizeof(int));
+    int *R = (int *)malloc(n2 * sizeof(int));
+
+    for (int i = 0; i < n1; i++)
+        L[i] = arr[left + i];
+    for (int j = 0; j < n2; j++)
+        R[j] = arr[mid + 1 + j];
+
+    int i = 0, j = 0, k = left;
+
+    while (i < n1 && j < n2) {
+        key_comparisons++;
+        if (L[i] <= R[j]) {
+            arr[k] = L[i];
+            i++;
+        } else {
+            arr[k] = R[j];
+            j++;
+        }
+        k++;
+    }
+
+    while (i < n1) {
+        arr[k] = L[i];
+        i++;
+        k++;
+    }
+
+    while (j < n2) {
+        arr[k] = R[j];
+        j++;
+        k++;
+    }
+
+    free(L);
+    free(R);
+}
+
+void hybrid_merge_sort(int arr[], int left, int right, int threshold) {
+    if (left < right) {
+        if ((right - left + 1) <= threshold) {
+            insertion_sort(arr, left, right);
+        } else {
+            int mid = (left + right) / 2;
+
+            hybrid_merge_sort(arr, left, mid, threshold);
+            hybrid_merge_sort(arr, mid + 1, right, threshold);
+
+            merge(arr, left, mid, right);
+        }
+    }
+}
+
+void generate_random_array(int arr[], int size, int max_value) {
+    for (int i = 0; i < size; i++) {
+        arr[i] = rand() % max_value + 1; // Generate a random number in the range [1, max_value]
+    }
+}
+
+void insertion_sort_r(int arr[], int left, int right, long *comparisons) {
+    int i, j, key;
+    for (i = left + 1; i <= right; i++) {
+        key = arr[i];
+        j = i - 1;
+        while (j >= left && arr[j] > key) {
+            (*comparisons)++;
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+        if (j >= left) {
+            (*comparisons)++;
+        }
+    }
+}
+
+void merge_r(int arr[], int left, int mid, int right, int scratch[], long *comparisons) {
+    int n1 = mid - left + 1;
+
+    // Only the left run is copied out; the merged output never overtakes the right run
+    for (int i = 0; i < n1; i++)
+        scratch[i] = arr[left + i];
+
+    int i = 0, j = mid + 1, k = left;
+
+    while (i < n1 && j <= right) {
+        (*comparisons)++;
+        if (scratch[i] <= arr[j]) {
+            arr[k] = scratch[i];
+            i++;
+        } else {
+            arr[k] = arr[j];
+            j++;
+        }
+        k++;
+    }
+
+    while (i < n1) {
+        arr[k] = scratch[i];
+        i++;
+        k++;
+    }
+}
+
+void hybrid_merge_sort_r(int arr[], int left, int right, int threshold, int scratch[], long *comparisons) {
+    if (left < right) {
+        if ((right - left + 1) <= threshold) {
+            insertion_sort_r(arr, left, right, comparisons);
+        } else {
+            int mid = (left + right) / 2;
+
+            hybrid_merge_sort_r(arr, left, mid, threshold, scratch, comparisons);
+            hybrid_merge_sort_r(arr, mid + 1, right, threshold, scratch, comparisons);
+
+            merge_r(arr, left, mid, right, scratch, comparisons);
+        }
+    }
+}
+
+// Children of i in the 4-ary heap are 4i + 1 .. 4i + 4
+static int largest_child(const int arr[], int first, int last, long *comparisons) {
+    int best = first;
+    for (int j = first + 1; j <= last; j++) {
+        (*comparisons)++;
+        if (arr[j] > arr[best]) {
+            best = j;
+        }
+    }
+    return best;
+}
+
+static void sift_down_4(int arr[], int n, int i, long *comparisons) {
+    int x = arr[i];
+    for (int first = 4 * i + 1; first < n; first = 4 * i + 1) {
+        int best = largest_child(arr, first, first + 3 < n - 1 ? first + 3 : n - 1, comparisons);
+        (*comparisons)++;
+        if (arr[best] <= x) {
+            break;
+        }
+        arr[i] = arr[best];
+        i = best;
+    }
+    arr[i] = x;
+}
+
+void heap_sort_r(int arr[], int n, long *comparisons) {
+    // Floyd's construction: sift down every internal node, last first
+    for (int i = (n - 2) / 4; i >= 0; i--) {
+        sift_down_4(arr, n, i, comparisons);
+    }
+
+    for (int end = n - 1; end > 0; end--) {
+        int x = arr[end];
+        arr[end] = arr[0];
+
+        // The element taken from the end almost always belongs near the bottom, so move the
+        // hole all the way down first and then sift x up, instead of comparing x on every level
+        int i = 0;
+        for (int first = 1; first < end; first = 4 * i + 1) {
+            i = largest_child(arr, first, first + 3 < end - 1 ? first + 3 : end - 1, comparisons);
+            arr[(i - 1) / 4] = arr[i];
+        }
+        while (i > 0) {
+            int parent = (i - 1) / 4;
+            (*comparisons)++;
+            if (arr[parent] >= x) {
+                break;
+            }
+            arr[i] = arr[parent];
+            i = parent;
+        }
+        arr[i] = x;
+    }
+}
+
+void heap_sort(int arr[], int n) {
+    long comparisons = 0;
+    heap_sort_r(arr, n, &comparisons);
+    key_comparisons += (int)comparisons;
+}
+
+static void reverse(int arr[], int first, int last) {
+    for (last--; first < last; first++, last--) {
+        int temp = arr[first];
+        arr[first] = arr[last];
+        arr[last] = temp;
+    }
+}
+
+// Swap the blocks arr[first .. middle - 1] and arr[middle .. last - 1]
+static void rotate(int arr[], int first, int middle, int last, int buffer[], int buffer_size) {
+    int len1 = middle - first, len2 = last - middle;
+    if (len1 == 0 || len2 == 0) {
+        return;
+    }
+    if (len1 <= len2 && len1 <= buffer_size) {
+        memcpy(buffer, arr + first, len1 * sizeof(int));
+        memmove(arr + first, arr + middle, len2 * sizeof(int));
+        memcpy(arr + first + len2, buffer, len1 * sizeof(int));
+    } else if (len2 <= buffer_size) {
+        memcpy(buffer, arr + middle, len2 * sizeof(int));
+        memmove(arr + first + len2, arr + first, len1 * sizeof(int));
+        memcpy(arr + first, buffer, len2 * sizeof(int));
+    } else {
+        reverse(arr, first, middle);
+        reverse(arr, middle, last);
+        reverse(arr, first, last);
+    }
+}
+
+// First position in arr[first .. last - 1] whose element is >= key (> key if upper)
+static int search(const int arr[], int first, int last, int key, int upper, long *comparisons) {
+    while (first < last) {
+        int mid = first + (last - first) / 2;
+        (*comparisons)++;
+        if (upper ? arr[mid] <= key : arr[mid] < key) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    return first;
+}
+
+// Stable merge of the sorted runs arr[first .. middle - 1] and arr[middle .. last - 1]
+static void merge_low_memory(int arr[], int first, int middle, int last, int buffer[], int buffer_size,
+                             long *comparisons) {
+    int len1 = middle - first, len2 = last - middle;
+    if (len1 == 0 || len2 == 0) {
+        return;
+    }
+
+    // Already in order: a single comparison, which also makes presorted input linear
+    (*comparisons)++;
+    if (arr[middle - 1] <= arr[middle]) {
+        return;
+    }
+    if (len1 == 1 && len2 == 1) {
+        int temp = arr[first];
+        arr[first] = arr[middle];
+        arr[middle] = temp;
+        return;
+    }
+
+    if (len1 <= buffer_size) {
+        merge_r(arr, first, middle - 1, last - 1, buffer, comparisons);
+        return;
+    }
+    if (len2 <= buffer_size) {
+        // Merge backwards from the right run in the buffer
+        memcpy(buffer, arr + middle, len2 * sizeof(int));
+        int i = middle - 1, j = len2 - 1, k = last - 1;
+        while (i >= first && j >= 0) {
+            (*comparisons)++;
+            if (arr[i] > buffer[j]) {
+                arr[k--] = arr[i--];
+            } else {
+                arr[k--] = buffer[j--];
+            }
+        }
+        memcpy(arr + first, buffer, (j + 1) * sizeof(int));
+        return;
+    }
+
+    // Cut the longer run in half and find where its middle element goes in the other one:
+    // equal elements of the left run stay in front of those of the right run
+    int cut1, cut2;
+    if (len1 > len2) {
+        cut1 = first + len1 / 2;
+        cut2 = search(arr, middle, last, arr[cut1], 0, comparisons);
+    } else {
+        cut2 = middle + len2 / 2;
+        cut1 = search(arr, first, middle, arr[cut2], 1, comparisons);
+    }
+    rotate(arr, cut1, middle, cut2, buffer, buffer_size);
+    int new_middle = cut1 + (cut2 - middle);
+
+    merge_low_memory(arr, first, cut1, new_middle, buffer, buffer_size, comparisons);
+    merge_low_memory(arr, new_middle, cut2, last, buffer, buffer_size, comparisons);
+}
+
+void hybrid_merge_sort_low_memory_r(int arr[], int left, int right, int threshold, int buffer[],
+                                    int buffer_size, long *comparisons) {
+    if (left < right) {
+        if ((right - left + 1) <= threshold) {
+            insertion_sort_r(arr, left, right, comparisons);
+        } else {
+            int mid = (left + right) / 2;
+
+            hybrid_merge_sort_low_memory_r(arr, left, mid, threshold, buffer, buffer_size, comparisons);
+            hybrid_merge_sort_low_memory_r(arr, mid + 1, right, threshold, buffer, buffer_size, comparisons);
+
+            merge_low_memory(arr, left, mid + 1, right + 1, buffer, buffer_size, comparisons);
+        }
+    }
+}
+
+void hybrid_merge_sort_low_memory(int arr[], int left, int right, int threshold) {
+    int buffer_size = 1;
+    while ((long)buffer_size * buffer_size < right - left + 1) {
+        buffer_size++;
+    }
+    int *buffer = (int *)malloc(buffer_size * sizeof(int));
+    long comparisons = 0;
+
+    if (buffer == NULL) {
+        buffer_size = 0;
+    }
+    hybrid_merge_sort_low_memory_r(arr, left, right, threshold, buffer, buffer_size, &comparisons);
+    key_comparisons += (int)comparisons;
+    free(buffer);
+}
@@ -0,0 +1,39 @@
+#ifndef SORT_H
+#define SORT_H
+
+// Global variable to count key comparisons
+extern int key_comparisons;
+
+// Hybrid merge sort from the report: insertion sort below the threshold, merge sort above.
+// These count into key_comparisons and are not safe to call from several threads.
+void insertion_sort(int arr[], int left, int right);
+void merge(int arr[], int left, int mid, int right);
+void hybrid_merge_sort(int arr[], int left, int right, int threshold);
+void generate_random_array(int arr[], int size, int max_value);
+
+// Reentrant versions for concurrent callers: comparisons go to *comparisons and merges copy
+// the left run into the caller's scratch buffer (mid - left + 1 ints, so (right - left + 2) / 2
+// for a whole hybrid_merge_sort_r) instead of calling malloc. They make exactly the
+// comparisons the versions above make.
+void insertion_sort_r(int arr[], int left, int right, long *comparisons);
+void merge_r(int arr[], int left, int mid, int right, int scratch[], long *comparisons);
+void hybrid_merge_sort_r(int arr[], int left, int right, int threshold, int scratch[], long *comparisons);
+
+// In-place heap sort of arr[0 .. n - 1] with O(1) extra memory: a 4-ary max-heap built bottom
+// up (Floyd), then extracted with bounce-down sifts, which walk the hole at the root down to a
+// leaf along the larger children and sift the displaced last element back up from there.
+// heap_sort counts into key_comparisons, heap_sort_r into *comparisons.
+void heap_sort(int arr[], int n);
+void heap_sort_r(int arr[], int n, long *comparisons);
+
+// Low-memory hybrid merge sort for when n / 2 extra ints are not available. Merges go through
+// buffer[] (buffer_size ints, may be 0) whenever the shorter run fits in it, otherwise the
+// runs are split around a binary-searched cut, rotated into place and merged recursively.
+// Stable, O(log n) stack; with a sqrt(n) buffer it is a small constant slower than merge_r,
+// without any buffer O(n log^2 n). hybrid_merge_sort_low_memory allocates a sqrt(n) buffer
+// itself and counts into key_comparisons.
+void hybrid_merge_sort_low_memory(int arr[], int left, int right, int threshold);
+void hybrid_merge_sort_low_memory_r(int arr[], int left, int right, int threshold, int buffer[],
+                                    int buffer_size, long *comparisons);
+
+#endif
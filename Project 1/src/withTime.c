@@ -1,95 +1,10 @@
+// Build: gcc -O2 -o withTime withTime.c sort.c
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
-// Global variable to count key comparisons
-int key_comparisons = 0;
-
-// Function prototypes
-void insertion_sort(int arr[], int left, int right);
-void merge(int arr[], int left, int mid, int right);
-void hybrid_merge_sort(int arr[], int left, int right, int threshold);
-void generate_random_array(int arr[], int size, int max_value);
-
-void insertion_sort(int arr[], int left, int right) {
-    int i, j, key;
-    for (i = left + 1; i <= right; i++) {
-        key = arr[i];
-        j = i - 1;
-        while (j >= left && arr[j] > key) {
-            key_comparisons++;
-            arr[j + 1] = arr[j];
-            j--;
-        }
-        arr[j + 1] = key;
-        if (j >= left) {
-            key_comparisons++;
-        }
-    }
-}
-
-void merge(int arr[], int left, int mid, int right) {
-    int n1 = mid - left + 1;
-    int n2 = right - mid;
-
-    int *L = (int *)malloc(n1 * sizeof(int));
-    int *R = (int *)malloc(n2 * sizeof(int));
-
-    for (int i = 0; i < n1; i++)
-        L[i] = arr[left + i];
-    for (int j = 0; j < n2; j++)
-        R[j] = arr[mid + 1 + j];
-
-    int i = 0, j = 0, k = left;
-
-    while (i < n1 && j < n2) {
-        key_comparisons++;
-        if (L[i] <= R[j]) {
-            arr[k] = L[i];
-            i++;
-        } else {
-            arr[k] = R[j];
-            j++;
-        }
-        k++;
-    }
-
-    while (i < n1) {
-        arr[k] = L[i];
-        i++;
-        k++;
-    }
-
-    while (j < n2) {
-        arr[k] = R[j];
-        j++;
-        k++;
-    }
-
-    free(L);
-    free(R);
-}
-
-void hybrid_merge_sort(int arr[], int left, int right, int threshold) {
-    if (left < right) {
-        if ((right - left + 1) <= threshold) {
-            insertion_sort(arr, left, right);
-        } else {
-            int mid = (left + right) / 2;
-
-            hybrid_merge_sort(arr, left, mid, threshold);
-            hybrid_merge_sort(arr, mid + 1, right, threshold);
-
-            merge(arr, left, mid, right);
-        }
-    }
-}
-
-void generate_random_array(int arr[], int size, int max_value) {
-    for (int i = 0; i < size; i++) {
-        arr[i] = rand() % max_value + 1; // Generate a random number in the range [1, max_value]
-    }
-}
+#include "sort.h"
 
 int main() {
     // Seed the random number generator
@@ -110,12 +25,13 @@ int main() {
     }
 
     // Write CSV header
-    fprintf(file, "Size,Key Comparisons,Time Taken (seconds)\n");
+    fprintf(file, "Size,Key Comparisons,Time Taken (seconds),Heap Sort Key Comparisons,Heap Sort Time Taken (seconds)\n");
 
     // Generate arrays of increasing sizes and write results to CSV
     for (int size = min_size; size <= max_size; size += interval) {
         int *arr = (int *)malloc(size * sizeof(int));
-        if (arr == NULL) {
+        int *heap_arr = (int *)malloc(size * sizeof(int));
+        if (arr == NULL || heap_arr == NULL) {
             fprintf(stderr, "Memory allocation failed for size %d!\n", size);
             fclose(file);
             return 1;
@@ -123,6 +39,7 @@ int main() {
 
         // Generate random data
         generate_random_array(arr, size, max_value);
+        memcpy(heap_arr, arr, size * sizeof(int));
 
         // Record start time
         clock_t start_time = clock();
@@ -136,12 +53,26 @@ int main() {
 
         // Calculate time taken
         double time_taken = (double)(end_time - start_time) / CLOCKS_PER_SEC;
+        int comparisons = key_comparisons;
+
+        // Sort the same data with the in-place heap sort
+        key_comparisons = 0;
+        start_time = clock();
+        heap_sort(heap_arr, size);
+        end_time = clock();
+        double heap_time_taken = (double)(end_time - start_time) / CLOCKS_PER_SEC;
+
+        // Both sorts must agree
+        if (memcmp(arr, heap_arr, size * sizeof(int)) != 0) {
+            fprintf(stderr, "Heap sort and hybrid merge sort disagree at size %d!\n", size);
+        }
 
         // Write the results to the CSV file
-        fprintf(file, "%d,%d,%f\n", size, key_comparisons, time_taken);
+        fprintf(file, "%d,%d,%f,%d,%f\n", size, comparisons, time_taken, key_comparisons, heap_time_taken);
 
         // Free the allocated memory
         free(arr);
+        free(heap_arr);
     }
 
     // Close the CSV file
@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arena.h"
+
+#define ARENA_ALIGN 8  // Enough for pointers, longs and doubles, without padding 8-byte nodes
+
+// Function to set up an empty arena; the first block is allocated on first use
+void arenaInit(struct Arena* arena, size_t initialBlockSize) {
+    arena->head = NULL;
+    arena->current = NULL;
+    arena->cursor = NULL;
+    arena->limit = NULL;
+    arena->blockSize = initialBlockSize > 4096 ? initialBlockSize : 4096;
+    arena->bytesUsed = 0;
+}
+
+// Function to make block the current block
+static void useBlock(struct Arena* arena, struct ArenaBlock* block) {
+    arena->current = block;
+    arena->cursor = block->data;
+    arena->limit = block->data + block->size;
+}
+
+// Function to allocate size bytes, 8-byte aligned
+void* arenaAlloc(struct Arena* arena, size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1);
+
+    while (arena->cursor == NULL || (size_t) (arena->limit - arena->cursor) < size) {
+        struct ArenaBlock* next = arena->current ? arena->current->next : arena->head;
+
+        // After a reset, move on to the blocks that are already there
+        if (next != NULL && next->size >= size) {
+            useBlock(arena, next);
+            continue;
+        }
+
+        size_t blockSize = arena->blockSize > size ? arena->blockSize : size;
+        struct ArenaBlock* block = (struct ArenaBlock*) malloc(sizeof(struct ArenaBlock) + blockSize);
+        if (block == NULL) {
+            fprintf(stderr, "Arena allocation of %zu bytes failed.\n", blockSize);
+            exit(1);
+        }
+        block->size = blockSize;
+        block->next = next;
+        if (arena->current) {
+            arena->current->next = block;
+        } else {
+            arena->head = block;
+        }
+        arena->blockSize *= 2;
+        useBlock(arena, block);
+    }
+
+    void* result = arena->cursor;
+    arena->cursor += size;
+    arena->bytesUsed += size;
+    return result;
+}
+
+// Function to forget every allocation but keep the blocks for reuse. O(1).
+void arenaReset(struct Arena* arena) {
+    arena->bytesUsed = 0;
+    if (arena->head) {
+        useBlock(arena, arena->head);
+    }
+}
+
+// Function to release every block
+void arenaFree(struct Arena* arena) {
+    struct ArenaBlock* block = arena->head;
+    while (block) {
+        struct ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->head = NULL;
+    arena->current = NULL;
+    arena->cursor = NULL;
+    arena->limit = NULL;
+    arena->bytesUsed = 0;
+}
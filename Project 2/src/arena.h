@@ -0,0 +1,36 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// A bump allocator: objects are carved out of large blocks one after another,
+// so neighbouring allocations sit next to each other in memory, and everything
+// is released at once instead of with one free() per object.
+struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t size;       // Usable bytes in data
+    char data[];
+};
+
+struct Arena {
+    struct ArenaBlock *head;     // First block; blocks are kept in allocation order
+    struct ArenaBlock *current;  // Block being bumped
+    char *cursor;                // Next free byte in current
+    char *limit;                 // End of current
+    size_t blockSize;            // Size of the next block to allocate, doubles as the arena grows
+    size_t bytesUsed;            // Bytes handed out since the last reset
+};
+
+// Function to set up an empty arena; the first block is allocated on first use
+void arenaInit(struct Arena* arena, size_t initialBlockSize);
+
+// Function to allocate size bytes, 8-byte aligned
+void* arenaAlloc(struct Arena* arena, size_t size);
+
+// Function to forget every allocation but keep the blocks for reuse. O(1).
+void arenaReset(struct Arena* arena);
+
+// Function to release every block. Blocks double in size, so this is O(log bytes).
+void arenaFree(struct Arena* arena);
+
+#endif
@@ -0,0 +1,148 @@
+// Build: gcc -O2 -o build_bench build_bench.c csr.c graphio.c -lpthread -lm
+// Usage: ./build_bench [V] [E] [max threads] [stream file]
+// Times CSR construction from unordered edges at 1, 2, 4, ... threads: the build itself, row
+// sorting, deduplication, and the whole path from an edge stream file on disk.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "csr.h"
+#include "graphio.h"
+#include "rng.h"
+
+// Function to read a monotonic clock in seconds
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Function to fill one edge list per thread with uniform random edges in no order, about a
+// tenth of them repeated so that deduplication has work to do. The first edge ends at V - 1,
+// so the V of the stream file (largest id plus one) is V too.
+static void generateEdges(int V, long E, int threads, struct EdgeList* lists) {
+    for (int t = 0; t < threads; ++t) {
+        long count = E * (t + 1) / threads - E * t / threads;
+        struct Rng rng;
+        rngSeed(&rng, 1, t);
+        initEdgeList(&lists[t], count);
+        for (long i = 0; i < count; ++i) {
+            if (t == 0 && i == 0) {
+                pushEdge(&lists[t], 0, V - 1, 1);
+            } else if (i > 0 && rngBounded(&rng, 10) == 0) {
+                struct EdgeRecord repeat = lists[t].edges[rngBounded(&rng, i)];
+                pushEdge(&lists[t], repeat.src, repeat.dest, 1 + (int) rngBounded(&rng, 10));
+            } else {
+                pushEdge(&lists[t], (int) rngBounded(&rng, V), (int) rngBounded(&rng, V),
+                         1 + (int) rngBounded(&rng, 10));
+            }
+        }
+    }
+}
+
+// Function to hash a CSR graph's rows, so that builds at different thread counts can be compared
+static unsigned long long hashCSRGraph(struct CSRGraph* csr) {
+    unsigned long long hash = 1469598103934665603ULL ^ (unsigned long long) csr->E;
+    for (int v = 0; v <= csr->V; ++v) {
+        hash = (hash ^ (unsigned long long) csr->offsets[v]) * 1099511628211ULL;
+    }
+    for (long e = 0; e < csr->E; ++e) {
+        hash = (hash ^ (unsigned) csr->targets[e]) * 1099511628211ULL;
+        hash = (hash ^ (unsigned) csr->weights[e]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Function to step through 1, 2, 4, ... threads with maxThreads last, 0 after it
+static int nextThreadCount(int threads, int maxThreads) {
+    if (threads == maxThreads) {
+        return 0;
+    }
+    return 2 * threads < maxThreads ? 2 * threads : maxThreads;
+}
+
+int main(int argc, char* argv[]) {
+    int V = argc > 1 ? atoi(argv[1]) : 1000000;
+    long E = argc > 2 ? atol(argv[2]) : 8L * V;
+    int maxThreads = argc > 3 ? atoi(argv[3]) : defaultThreadCount();
+    const char* streamFile = argc > 4 ? argv[4] : "build_edges.bin";
+    if (V < 1 || E < 1 || maxThreads < 1) {
+        fprintf(stderr, "Usage: build_bench [V] [E] [max threads] [stream file]\n");
+        return 1;
+    }
+
+    struct EdgeList* lists = (struct EdgeList*) malloc(maxThreads * sizeof(struct EdgeList));
+    generateEdges(V, E, maxThreads, lists);
+    if (writeEdgeStream(streamFile, lists, maxThreads) != 0) {
+        return 1;
+    }
+    printf("V=%d E=%ld, edges in %d lists, stream file %s (%.1f MB)\n", V, E, maxThreads, streamFile,
+           E * (double) sizeof(struct EdgeRecord) / 1e6);
+
+    FILE* file = fopen("build_results.csv", "w");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening file for writing.\n");
+        return 1;
+    }
+    fprintf(file, "V,E,Threads,Build (s),Sort (s),Dedup (s),Dedup Edges,Stream (s),Build M edges/s,Stream M edges/s\n");
+    printf("%7s %10s %10s %10s %12s %10s %14s %15s\n", "threads", "build (s)", "sort (s)", "dedup (s)",
+           "dedup edges", "stream (s)", "build Medges/s", "stream Medges/s");
+
+    unsigned long long sortedHash = 0, dedupHash = 0;
+    int mismatches = 0;
+
+    for (int threads = 1; threads > 0; threads = nextThreadCount(threads, maxThreads)) {
+        // The build, then the sort on its result
+        double start = nowSeconds();
+        struct CSRGraph* csr = buildCSRGraph(V, lists, maxThreads, threads);
+        double buildTime = nowSeconds() - start;
+        start = nowSeconds();
+        normalizeCSRGraph(csr, CSR_SORT_ROWS, threads);
+        double sortTime = nowSeconds() - start;
+        unsigned long long hash = hashCSRGraph(csr);
+        freeCSRGraph(csr);
+
+        // Deduplication on a fresh build
+        csr = buildCSRGraph(V, lists, maxThreads, threads);
+        start = nowSeconds();
+        normalizeCSRGraph(csr, CSR_DEDUP, threads);
+        double dedupTime = nowSeconds() - start;
+        long dedupEdges = csr->E;
+        unsigned long long dedup = hashCSRGraph(csr);
+        freeCSRGraph(csr);
+
+        // From disk to a deduplicated graph; the file is in the page cache after the write
+        start = nowSeconds();
+        csr = readEdgeStreamGraph(streamFile, CSR_DEDUP, threads);
+        double streamTime = nowSeconds() - start;
+        if (csr == NULL) {
+            return 1;
+        }
+        unsigned long long streamed = csr->V == V ? hashCSRGraph(csr) : 0;
+        freeCSRGraph(csr);
+
+        if (threads == 1) {
+            sortedHash = hash;
+            dedupHash = dedup;
+        }
+        if (hash != sortedHash || dedup != dedupHash || streamed != dedupHash) {
+            fprintf(stderr, "Mismatch at %d threads\n", threads);
+            mismatches++;
+        }
+
+        printf("%7d %10.3f %10.3f %10.3f %12ld %10.3f %14.1f %15.1f\n", threads, buildTime, sortTime, dedupTime,
+               dedupEdges, streamTime, E / buildTime / 1e6, E / streamTime / 1e6);
+        fprintf(file, "%d,%ld,%d,%f,%f,%f,%ld,%f,%f,%f\n", V, E, threads, buildTime, sortTime, dedupTime, dedupEdges,
+                streamTime, E / buildTime / 1e6, E / streamTime / 1e6);
+    }
+    fclose(file);
+    remove(streamFile);
+    printf("Results have been saved to build_results.csv (%d mismatches)\n", mismatches);
+
+    for (int t = 0; t < maxThreads; ++t) {
+        freeEdgeList(&lists[t]);
+    }
+    free(lists);
+    return mismatches != 0;
+}
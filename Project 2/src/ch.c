@@ -0,0 +1,572 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "ch.h"
+#include "minheap.h"
+#include "distance.h"
+
+#define WITNESS_SETTLE_LIMIT 500  // Give up a witness search after this many settled vertices
+#define CH_MAGIC "CH01"
+
+// A growable list of (neighbor, weight) pairs used while contracting
+struct DynList {
+    int count;
+    int capacity;
+    int *to;
+    int *weight;
+};
+
+// An edge list that grows as vertices are contracted
+struct EdgeBuffer {
+    int count;
+    int capacity;
+    int *at;      // The vertex whose CSR row holds the edge
+    int *to;
+    int *weight;
+};
+
+// A Dijkstra workspace that remembers which vertices it touched,
+// so resetting it costs only what the last search visited
+struct LocalSearch {
+    int *dist;
+    int *state;                 // 0 = unreached, 1 = in heap, 2 = settled
+    struct MinHeapNode *nodes;  // nodes[v] is the heap node of vertex v
+    struct MinHeap *minHeap;
+    int *touched;
+    int touchedCount;
+};
+
+struct CHQuery {
+    struct LocalSearch *forward;
+    struct LocalSearch *backward;
+};
+
+// The graph being contracted, with in- and out-lists restricted to uncontracted vertices
+struct Contraction {
+    int V;
+    struct DynList *out;
+    struct DynList *in;
+    int *deletedNeighbors;      // Number of already contracted neighbors, part of the priority
+    struct LocalSearch *search; // Workspace for witness searches
+    struct EdgeBuffer pending;  // Shortcuts found by the last processVertex()
+};
+
+// Function to add an edge to a list, keeping only the lighter of parallel edges.
+// Returns 1 if the list changed.
+static int dynAdd(struct DynList* list, int to, int weight) {
+    for (int i = 0; i < list->count; ++i) {
+        if (list->to[i] == to) {
+            if (weight < list->weight[i]) {
+                list->weight[i] = weight;
+                return 1;
+            }
+            return 0;
+        }
+    }
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? 2 * list->capacity : 4;
+        list->to = (int*) realloc(list->to, list->capacity * sizeof(int));
+        list->weight = (int*) realloc(list->weight, list->capacity * sizeof(int));
+    }
+    list->to[list->count] = to;
+    list->weight[list->count] = weight;
+    list->count++;
+    return 1;
+}
+
+// Function to remove the edge to a vertex from a list
+static void dynRemove(struct DynList* list, int to) {
+    for (int i = 0; i < list->count; ++i) {
+        if (list->to[i] == to) {
+            list->count--;
+            list->to[i] = list->to[list->count];
+            list->weight[i] = list->weight[list->count];
+            return;
+        }
+    }
+}
+
+static void edgeBufferAdd(struct EdgeBuffer* buffer, int at, int to, int weight) {
+    if (buffer->count == buffer->capacity) {
+        buffer->capacity = buffer->capacity ? 2 * buffer->capacity : 1024;
+        buffer->at = (int*) realloc(buffer->at, buffer->capacity * sizeof(int));
+        buffer->to = (int*) realloc(buffer->to, buffer->capacity * sizeof(int));
+        buffer->weight = (int*) realloc(buffer->weight, buffer->capacity * sizeof(int));
+    }
+    buffer->at[buffer->count] = at;
+    buffer->to[buffer->count] = to;
+    buffer->weight[buffer->count] = weight;
+    buffer->count++;
+}
+
+static struct LocalSearch* createLocalSearch(int V) {
+    struct LocalSearch* s = (struct LocalSearch*) malloc(sizeof(struct LocalSearch));
+    s->dist = (int*) malloc(V * sizeof(int));
+    s->state = (int*) calloc(V, sizeof(int));
+    s->nodes = (struct MinHeapNode*) malloc(V * sizeof(struct MinHeapNode));
+    s->minHeap = createMinHeap(V);
+    s->touched = (int*) malloc(V * sizeof(int));
+    s->touchedCount = 0;
+    for (int v = 0; v < V; ++v) {
+        s->dist[v] = INF;
+    }
+    return s;
+}
+
+static void freeLocalSearch(struct LocalSearch* s) {
+    free(s->dist);
+    free(s->state);
+    free(s->nodes);
+    freeMinHeap(s->minHeap);
+    free(s->touched);
+    free(s);
+}
+
+// Function to undo the last search on only the vertices it touched
+static void resetLocalSearch(struct LocalSearch* s) {
+    for (int i = 0; i < s->touchedCount; ++i) {
+        s->dist[s->touched[i]] = INF;
+        s->state[s->touched[i]] = 0;
+    }
+    s->touchedCount = 0;
+    s->minHeap->size = 0;
+}
+
+// Function to queue v with key dist[v], or lower its key if it is already queued
+static void localPush(struct LocalSearch* s, int v, int* comparisonCount) {
+    if (s->state[v] == 1) {
+        decreaseKey(s->minHeap, v, s->dist[v], comparisonCount);
+        return;
+    }
+    s->touched[s->touchedCount++] = v;
+    s->state[v] = 1;
+    s->nodes[v].v = v;
+    s->nodes[v].dist = s->dist[v];
+    insertMinHeap(s->minHeap, &s->nodes[v], comparisonCount);
+}
+
+static int localPop(struct LocalSearch* s, int* comparisonCount) {
+    int u = extractMin(s->minHeap, comparisonCount)->v;
+    s->state[u] = 2;
+    return u;
+}
+
+// Function to run a bounded Dijkstra from src that ignores the vertex being contracted
+static void witnessSearch(struct Contraction* c, int src, int skip, int maxDist, int* comparisonCount) {
+    struct LocalSearch* s = c->search;
+    int settled = 0;
+
+    resetLocalSearch(s);
+    s->dist[src] = 0;
+    localPush(s, src, comparisonCount);
+
+    while (s->minHeap->size > 0) {
+        if (s->minHeap->array[0]->dist > maxDist || settled++ > WITNESS_SETTLE_LIMIT) {
+            break;
+        }
+        int u = localPop(s, comparisonCount);
+
+        struct DynList* out = &c->out[u];
+        for (int i = 0; i < out->count; ++i) {
+            int v = out->to[i];
+            if (v == skip) {
+                continue;
+            }
+            (*comparisonCount)++;
+            if (s->state[v] != 2 && addDistInt(s->dist[u], out->weight[i], INF) < s->dist[v]) {
+                s->dist[v] = addDistInt(s->dist[u], out->weight[i], INF);
+                localPush(s, v, comparisonCount);
+            }
+        }
+    }
+}
+
+// Function to find the shortcuts needed to contract v; they are left in c->pending.
+// Returns the number of shortcuts.
+static int processVertex(struct Contraction* c, int v, int* comparisonCount) {
+    struct DynList* in = &c->in[v];
+    struct DynList* out = &c->out[v];
+
+    c->pending.count = 0;
+    if (in->count == 0 || out->count == 0) {
+        return 0;
+    }
+
+    int maxOut = 0;
+    for (int j = 0; j < out->count; ++j) {
+        if (out->weight[j] > maxOut) {
+            maxOut = out->weight[j];
+        }
+    }
+
+    for (int i = 0; i < in->count; ++i) {
+        int u = in->to[i];
+        witnessSearch(c, u, v, addDistInt(in->weight[i], maxOut, INF), comparisonCount);
+
+        for (int j = 0; j < out->count; ++j) {
+            int w = out->to[j];
+            int via = addDistInt(in->weight[i], out->weight[j], INF);
+
+            // A shortcut u->w is needed unless a witness path avoids v; a path of INF or more
+            // never is, since every distance stops at INF
+            if (w != u && c->search->dist[w] > via) {
+                edgeBufferAdd(&c->pending, u, w, via);
+            }
+        }
+    }
+    return c->pending.count;
+}
+
+// Function to compute the edge difference priority of v
+static int edgeDifference(struct Contraction* c, int v, int* comparisonCount) {
+    int shortcuts = processVertex(c, v, comparisonCount);
+    return shortcuts - c->in[v].count - c->out[v].count + c->deletedNeighbors[v];
+}
+
+// Function to build a CSR from an edge buffer, grouping edges by their 'at' vertex
+static void buildCSR(struct EdgeBuffer* buffer, int V, int** offsets, int** targets, int** weights) {
+    *offsets = (int*) calloc(V + 1, sizeof(int));
+    *targets = (int*) malloc((buffer->count + 1) * sizeof(int));
+    *weights = (int*) malloc((buffer->count + 1) * sizeof(int));
+
+    for (int i = 0; i < buffer->count; ++i) {
+        (*offsets)[buffer->at[i] + 1]++;
+    }
+    for (int v = 0; v < V; ++v) {
+        (*offsets)[v + 1] += (*offsets)[v];
+    }
+
+    int* next = (int*) malloc(V * sizeof(int));
+    memcpy(next, *offsets, V * sizeof(int));
+    for (int i = 0; i < buffer->count; ++i) {
+        int slot = next[buffer->at[i]]++;
+        (*targets)[slot] = buffer->to[i];
+        (*weights)[slot] = buffer->weight[i];
+    }
+    free(next);
+}
+
+// Function to contract the graph by edge difference and build the query CSRs
+struct CHGraph* buildCH(struct Graph* graph, int* comparisonCount) {
+    int V = graph->V;
+    struct Contraction c;
+    c.V = V;
+    c.out = (struct DynList*) calloc(V, sizeof(struct DynList));
+    c.in = (struct DynList*) calloc(V, sizeof(struct DynList));
+    c.deletedNeighbors = (int*) calloc(V, sizeof(int));
+    c.search = createLocalSearch(V);
+    memset(&c.pending, 0, sizeof(c.pending));
+
+    for (int u = 0; u < V; ++u) {
+        struct Edge* pCrawl = graph->array[u].head;
+        while (pCrawl != NULL) {
+            if (pCrawl->dest != u) {
+                dynAdd(&c.out[u], pCrawl->dest, pCrawl->weight);
+                dynAdd(&c.in[pCrawl->dest], u, pCrawl->weight);
+            }
+            pCrawl = pCrawl->next;
+        }
+    }
+
+    struct CHGraph* ch = (struct CHGraph*) malloc(sizeof(struct CHGraph));
+    ch->V = V;
+    ch->shortcuts = 0;
+    ch->rank = (int*) malloc(V * sizeof(int));
+
+    struct EdgeBuffer up = {0};
+    struct EdgeBuffer down = {0};
+
+    // Initial node order by edge difference
+    struct MinHeap* order = createMinHeap(V);
+    struct MinHeapNode* nodes = (struct MinHeapNode*) malloc(V * sizeof(struct MinHeapNode));
+    for (int v = 0; v < V; ++v) {
+        nodes[v].v = v;
+        nodes[v].dist = edgeDifference(&c, v, comparisonCount);
+        insertMinHeap(order, &nodes[v], comparisonCount);
+    }
+
+    int nextRank = 0;
+    while (order->size > 0) {
+        struct MinHeapNode* node = extractMin(order, comparisonCount);
+        int v = node->v;
+
+        // Lazy update: if the priority went up, put v back and try the new minimum
+        int priority = edgeDifference(&c, v, comparisonCount);
+        if (order->size > 0 && priority > order->array[0]->dist) {
+            node->dist = priority;
+            insertMinHeap(order, node, comparisonCount);
+            continue;
+        }
+
+        // pending still holds v's shortcuts from the edgeDifference() call above
+        for (int k = 0; k < c.pending.count; ++k) {
+            int u = c.pending.at[k];
+            int w = c.pending.to[k];
+            if (dynAdd(&c.out[u], w, c.pending.weight[k])) {
+                dynAdd(&c.in[w], u, c.pending.weight[k]);
+                ch->shortcuts++;
+            }
+        }
+
+        // Every remaining neighbor of v is contracted later, so it ranks higher
+        for (int j = 0; j < c.out[v].count; ++j) {
+            int w = c.out[v].to[j];
+            edgeBufferAdd(&up, v, w, c.out[v].weight[j]);
+            dynRemove(&c.in[w], v);
+            c.deletedNeighbors[w]++;
+        }
+        for (int i = 0; i < c.in[v].count; ++i) {
+            int u = c.in[v].to[i];
+            edgeBufferAdd(&down, v, u, c.in[v].weight[i]);
+            dynRemove(&c.out[u], v);
+            c.deletedNeighbors[u]++;
+        }
+        c.out[v].count = 0;
+        c.in[v].count = 0;
+
+        ch->rank[v] = nextRank++;
+    }
+
+    buildCSR(&up, V, &ch->upOffsets, &ch->upTargets, &ch->upWeights);
+    buildCSR(&down, V, &ch->downOffsets, &ch->downTargets, &ch->downWeights);
+
+    for (int v = 0; v < V; ++v) {
+        free(c.out[v].to);
+        free(c.out[v].weight);
+        free(c.in[v].to);
+        free(c.in[v].weight);
+    }
+    free(c.out);
+    free(c.in);
+    free(c.deletedNeighbors);
+    free(c.pending.at);
+    free(c.pending.to);
+    free(c.pending.weight);
+    freeLocalSearch(c.search);
+    free(up.at);
+    free(up.to);
+    free(up.weight);
+    free(down.at);
+    free(down.to);
+    free(down.weight);
+    freeMinHeap(order);
+    free(nodes);
+
+    return ch;
+}
+
+// Function to write the hierarchy to a binary file, returns 0 on success
+int saveCH(struct CHGraph* ch, const char* filename) {
+    FILE* file = fopen(filename, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening %s for writing.\n", filename);
+        return -1;
+    }
+
+    int V = ch->V;
+    int header[4] = {V, ch->shortcuts, ch->upOffsets[V], ch->downOffsets[V]};
+    size_t ok = fwrite(CH_MAGIC, 1, 4, file) == 4
+             && fwrite(header, sizeof(int), 4, file) == 4
+             && fwrite(ch->rank, sizeof(int), V, file) == (size_t) V
+             && fwrite(ch->upOffsets, sizeof(int), V + 1, file) == (size_t) V + 1
+             && fwrite(ch->upTargets, sizeof(int), header[2], file) == (size_t) header[2]
+             && fwrite(ch->upWeights, sizeof(int), header[2], file) == (size_t) header[2]
+             && fwrite(ch->downOffsets, sizeof(int), V + 1, file) == (size_t) V + 1
+             && fwrite(ch->downTargets, sizeof(int), header[3], file) == (size_t) header[3]
+             && fwrite(ch->downWeights, sizeof(int), header[3], file) == (size_t) header[3];
+
+    if (fclose(file) != 0 || !ok) {
+        fprintf(stderr, "Error writing %s.\n", filename);
+        return -1;
+    }
+    return 0;
+}
+
+// Function to check one CSR of a loaded hierarchy: offsets from 0 to count, non-decreasing,
+// targets in range and weights not negative, returns 0 if valid
+static int validateCHRows(int V, const int* offsets, const int* targets, const int* weights, int count) {
+    if (offsets[0] != 0 || offsets[V] != count) {
+        return -1;
+    }
+    for (int v = 0; v < V; ++v) {
+        if (offsets[v + 1] < offsets[v]) {
+            return -1;
+        }
+    }
+    for (int e = 0; e < count; ++e) {
+        if (targets[e] < 0 || targets[e] >= V || weights[e] < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Function to check that rank is a permutation of 0 .. V-1, returns 0 if it is
+static int validateCHRank(int V, const int* rank) {
+    char* seen = (char*) calloc(V > 0 ? V : 1, 1);
+    int valid = 1;
+    for (int v = 0; v < V && valid; ++v) {
+        valid = rank[v] >= 0 && rank[v] < V && !seen[rank[v]];
+        if (valid) {
+            seen[rank[v]] = 1;
+        }
+    }
+    free(seen);
+    return valid ? 0 : -1;
+}
+
+// Function to load a hierarchy written by saveCH(), returns NULL on failure
+struct CHGraph* loadCH(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening %s for reading.\n", filename);
+        return NULL;
+    }
+
+    // The counts are checked against the file size before anything is allocated from them
+    char magic[4];
+    int header[4];
+    long fileSize = -1;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        fileSize = ftell(file);
+        rewind(file);
+    }
+    if (fileSize < 0 || fread(magic, 1, 4, file) != 4 || memcmp(magic, CH_MAGIC, 4) != 0
+        || fread(header, sizeof(int), 4, file) != 4 || header[0] < 0 || header[0] == INT_MAX
+        || header[2] < 0 || header[2] == INT_MAX || header[3] < 0 || header[3] == INT_MAX
+        || header[1] < 0 || header[1] > (long) header[2] + header[3]
+        || fileSize != 4 + (long) sizeof(header)
+                       + (long) sizeof(int) * (3L * header[0] + 2 + 2L * header[2] + 2L * header[3])) {
+        fprintf(stderr, "%s is not a contraction hierarchy file.\n", filename);
+        fclose(file);
+        return NULL;
+    }
+
+    int V = header[0];
+    struct CHGraph* ch = (struct CHGraph*) calloc(1, sizeof(struct CHGraph));
+    if (ch == NULL) {
+        fprintf(stderr, "Out of memory loading %s.\n", filename);
+        fclose(file);
+        return NULL;
+    }
+    ch->V = V;
+    ch->shortcuts = header[1];
+    ch->rank = (int*) malloc((V + 1) * sizeof(int));
+    ch->upOffsets = (int*) malloc((V + 1) * sizeof(int));
+    ch->upTargets = (int*) malloc((header[2] + 1) * sizeof(int));
+    ch->upWeights = (int*) malloc((header[2] + 1) * sizeof(int));
+    ch->downOffsets = (int*) malloc((V + 1) * sizeof(int));
+    ch->downTargets = (int*) malloc((header[3] + 1) * sizeof(int));
+    ch->downWeights = (int*) malloc((header[3] + 1) * sizeof(int));
+    if (ch->rank == NULL || ch->upOffsets == NULL || ch->upTargets == NULL || ch->upWeights == NULL
+        || ch->downOffsets == NULL || ch->downTargets == NULL || ch->downWeights == NULL) {
+        fprintf(stderr, "Out of memory loading %s.\n", filename);
+        fclose(file);
+        freeCH(ch);
+        return NULL;
+    }
+
+    size_t ok = fread(ch->rank, sizeof(int), V, file) == (size_t) V
+             && fread(ch->upOffsets, sizeof(int), V + 1, file) == (size_t) V + 1
+             && fread(ch->upTargets, sizeof(int), header[2], file) == (size_t) header[2]
+             && fread(ch->upWeights, sizeof(int), header[2], file) == (size_t) header[2]
+             && fread(ch->downOffsets, sizeof(int), V + 1, file) == (size_t) V + 1
+             && fread(ch->downTargets, sizeof(int), header[3], file) == (size_t) header[3]
+             && fread(ch->downWeights, sizeof(int), header[3], file) == (size_t) header[3];
+    fclose(file);
+
+    // Queries index by these without further checks, so a corrupt file must not get through
+    if (!ok || validateCHRank(V, ch->rank) != 0
+        || validateCHRows(V, ch->upOffsets, ch->upTargets, ch->upWeights, header[2]) != 0
+        || validateCHRows(V, ch->downOffsets, ch->downTargets, ch->downWeights, header[3]) != 0) {
+        fprintf(stderr, "%s is truncated or corrupt.\n", filename);
+        freeCH(ch);
+        return NULL;
+    }
+    return ch;
+}
+
+// Function to free the hierarchy
+void freeCH(struct CHGraph* ch) {
+    free(ch->rank);
+    free(ch->upOffsets);
+    free(ch->upTargets);
+    free(ch->upWeights);
+    free(ch->downOffsets);
+    free(ch->downTargets);
+    free(ch->downWeights);
+    free(ch);
+}
+
+// Function to create and free the query state for a hierarchy
+struct CHQuery* createCHQuery(struct CHGraph* ch) {
+    struct CHQuery* query = (struct CHQuery*) malloc(sizeof(struct CHQuery));
+    query->forward = createLocalSearch(ch->V);
+    query->backward = createLocalSearch(ch->V);
+    return query;
+}
+
+void freeCHQuery(struct CHQuery* query) {
+    freeLocalSearch(query->forward);
+    freeLocalSearch(query->backward);
+    free(query);
+}
+
+// Function to find the shortest src-target distance, INF if unreachable
+int chQuery(struct CHGraph* ch, struct CHQuery* query, int src, int target,
+            int* settled, int* comparisonCount) {
+    struct LocalSearch* forward = query->forward;
+    struct LocalSearch* backward = query->backward;
+    int best = INF;
+
+    resetLocalSearch(forward);
+    resetLocalSearch(backward);
+    forward->dist[src] = 0;
+    localPush(forward, src, comparisonCount);
+    backward->dist[target] = 0;
+    localPush(backward, target, comparisonCount);
+
+    while (1) {
+        int topForward = forward->minHeap->size > 0 ? forward->minHeap->array[0]->dist : INF;
+        int topBackward = backward->minHeap->size > 0 ? backward->minHeap->array[0]->dist : INF;
+
+        // Both upward searches are past the best meeting point
+        (*comparisonCount)++;
+        if ((topForward < topBackward ? topForward : topBackward) >= best) {
+            break;
+        }
+
+        struct LocalSearch* side = forward;
+        struct LocalSearch* other = backward;
+        int* offsets = ch->upOffsets;
+        int* targets = ch->upTargets;
+        int* weights = ch->upWeights;
+        if (topBackward < topForward) {
+            side = backward;
+            other = forward;
+            offsets = ch->downOffsets;
+            targets = ch->downTargets;
+            weights = ch->downWeights;
+        }
+
+        int u = localPop(side, comparisonCount);
+        (*settled)++;
+
+        if (other->dist[u] != INF && addDistInt(side->dist[u], other->dist[u], INF) < best) {
+            best = addDistInt(side->dist[u], other->dist[u], INF);
+        }
+
+        for (int i = offsets[u]; i < offsets[u + 1]; ++i) {
+            int v = targets[i];
+            (*comparisonCount)++;
+            if (side->state[v] != 2 && addDistInt(side->dist[u], weights[i], INF) < side->dist[v]) {
+                side->dist[v] = addDistInt(side->dist[u], weights[i], INF);
+                localPush(side, v, comparisonCount);
+            }
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,44 @@
+#ifndef CH_H
+#define CH_H
+
+#include "graph.h"
+
+// A contraction hierarchy: every vertex has a rank, and the original edges plus
+// shortcuts are split into an upward CSR (forward search) and a downward CSR
+// stored reversed at the lower endpoint (backward search). Both searches only go up.
+struct CHGraph {
+    int V;            // Number of vertices
+    int shortcuts;    // Number of shortcut edges added during contraction
+    int *rank;        // rank[v] = position of v in the contraction order
+    int *upOffsets;   // Edges u->v with rank[v] > rank[u] are upTargets[upOffsets[u] .. upOffsets[u+1])
+    int *upTargets;
+    int *upWeights;
+    int *downOffsets; // Edges u->v with rank[u] > rank[v] are stored at v as downTargets = u
+    int *downTargets;
+    int *downWeights;
+};
+
+// Reusable state for CH queries so that each query only touches the vertices it visits
+struct CHQuery;
+
+// Function to contract the graph by edge difference and build the query CSRs
+struct CHGraph* buildCH(struct Graph* graph, int* comparisonCount);
+
+// Function to write the hierarchy to a binary file, returns 0 on success
+int saveCH(struct CHGraph* ch, const char* filename);
+
+// Function to load a hierarchy written by saveCH(), returns NULL on failure
+struct CHGraph* loadCH(const char* filename);
+
+// Function to free the hierarchy
+void freeCH(struct CHGraph* ch);
+
+// Function to create and free the query state for a hierarchy
+struct CHQuery* createCHQuery(struct CHGraph* ch);
+void freeCHQuery(struct CHQuery* query);
+
+// Function to find the shortest src-target distance, INF if unreachable
+int chQuery(struct CHGraph* ch, struct CHQuery* query, int src, int target,
+            int* settled, int* comparisonCount);
+
+#endif
@@ -0,0 +1,120 @@
+// Build: gcc -O2 -o ch_bench ch_bench.c graph.c arena.c minheap.c dheap.c trace.c dijkstra.c p2p.c ch.c
+// Usage: ./ch_bench [V] [E] [queries] [ch file]
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "graph.h"
+#include "p2p.h"
+#include "ch.h"
+
+// Function to read a monotonic clock in microseconds
+static double nowMicros(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static int compareDoubles(const void* a, const void* b) {
+    double x = *(const double*) a;
+    double y = *(const double*) b;
+    return (x > y) - (x < y);
+}
+
+// Function to read the p-th percentile from a sorted array
+static double percentile(double* sorted, int n, double p) {
+    int idx = (int) (p / 100.0 * (n - 1) + 0.5);
+    return sorted[idx];
+}
+
+int main(int argc, char* argv[]) {
+    int V = argc > 1 ? atoi(argv[1]) : 5000;
+    int E = argc > 2 ? atoi(argv[2]) : 5 * V / 2;
+    int queries = argc > 3 ? atoi(argv[3]) : 1000;
+    const char* chFile = argc > 4 ? argv[4] : "graph.ch";
+
+    // Fixed seed so that runs are repeatable
+    srand(1);
+
+    struct Graph* graph = createGraph(V);
+    generateRandomGraph(graph, E);
+
+    // Preprocess and write the hierarchy to disk
+    int comparisonCount = 0;
+    double start = nowMicros();
+    struct CHGraph* built = buildCH(graph, &comparisonCount);
+    double preprocessMs = (nowMicros() - start) / 1e3;
+    if (saveCH(built, chFile) != 0) {
+        return 1;
+    }
+    printf("Preprocessing: %.1f ms, %d shortcuts (%d original edges), %d comparisons\n",
+           preprocessMs, built->shortcuts, E, comparisonCount);
+    freeCH(built);
+
+    // Queries run on the hierarchy as it would be loaded at startup
+    start = nowMicros();
+    struct CHGraph* ch = loadCH(chFile);
+    if (ch == NULL) {
+        return 1;
+    }
+    printf("Loaded %s in %.1f ms\n", chFile, (nowMicros() - start) / 1e3);
+
+    struct CHQuery* query = createCHQuery(ch);
+    double* chLatency = (double*) malloc(queries * sizeof(double));
+    double* dijkstraLatency = (double*) malloc(queries * sizeof(double));
+    double chSettled = 0, dijkstraSettled = 0;
+    int mismatches = 0;
+
+    FILE* file = fopen("ch_results.csv", "w");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening file for writing.\n");
+        return 1;
+    }
+    fprintf(file, "Query,Source,Target,Distance,CH Settled,CH Latency (us),Dijkstra Settled,Dijkstra Latency (us)\n");
+
+    for (int q = 0; q < queries; ++q) {
+        int src = rand() % V;
+        int target = rand() % V;
+        int settled = 0, baselineSettled = 0;
+
+        comparisonCount = 0;
+        start = nowMicros();
+        int dist = chQuery(ch, query, src, target, &settled, &comparisonCount);
+        chLatency[q] = nowMicros() - start;
+
+        start = nowMicros();
+        int expected = dijkstraTo(graph, src, target, &baselineSettled, &comparisonCount);
+        dijkstraLatency[q] = nowMicros() - start;
+
+        if (dist != expected) {
+            fprintf(stderr, "Mismatch on query %d (%d -> %d): CH gave %d, expected %d\n",
+                    q, src, target, dist, expected);
+            mismatches++;
+        }
+        chSettled += settled;
+        dijkstraSettled += baselineSettled;
+        fprintf(file, "%d,%d,%d,%d,%d,%f,%d,%f\n", q, src, target, dist,
+                settled, chLatency[q], baselineSettled, dijkstraLatency[q]);
+    }
+    fclose(file);
+
+    qsort(chLatency, queries, sizeof(double), compareDoubles);
+    qsort(dijkstraLatency, queries, sizeof(double), compareDoubles);
+
+    printf("%-10s %10s %10s %10s %10s %12s\n", "engine", "p50 (us)", "p90 (us)", "p99 (us)", "max (us)", "avg settled");
+    printf("%-10s %10.1f %10.1f %10.1f %10.1f %12.1f\n", "ch",
+           percentile(chLatency, queries, 50), percentile(chLatency, queries, 90),
+           percentile(chLatency, queries, 99), chLatency[queries - 1], chSettled / queries);
+    printf("%-10s %10.1f %10.1f %10.1f %10.1f %12.1f\n", "dijkstraTo",
+           percentile(dijkstraLatency, queries, 50), percentile(dijkstraLatency, queries, 90),
+           percentile(dijkstraLatency, queries, 99), dijkstraLatency[queries - 1], dijkstraSettled / queries);
+    printf("Results have been saved to ch_results.csv (%d mismatches)\n", mismatches);
+
+    free(chLatency);
+    free(dijkstraLatency);
+    freeCHQuery(query);
+    freeCH(ch);
+    freeGraph(graph);
+
+    return mismatches != 0;
+}
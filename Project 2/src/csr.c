@@ -0,0 +1,384 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "csr.h"
+
+// Shared state of one parallel CSR build
+struct CSRBuild {
+    int V;
+    int threads;
+    struct EdgeList *lists;
+    int numLists;
+    long **counts;      // counts[t][v]: edges from v in the lists of thread t, later its write cursor
+    long *rangeTotals;  // Edges whose source lies in the vertex range of thread t
+    struct CSRGraph *csr;
+    // normalizeCSRGraph() only
+    int flags;
+    int *rangeFirst;    // Thread t owns the rows rangeFirst[t] .. rangeFirst[t+1]
+    long *kept;         // Edges each row keeps
+    int *newTargets;    // Compacted rows, when edges were dropped
+    int *newWeights;
+};
+
+// The argument handed to each worker thread
+struct CSRWorker {
+    struct CSRBuild *build;
+    int t;
+};
+
+// Function to return the number of worker threads to use by default (online CPUs)
+int defaultThreadCount(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int) n : 1;
+}
+
+// Functions to manage an edge list
+int initEdgeList(struct EdgeList* list, long capacity) {
+    list->count = 0;
+    list->capacity = capacity > 0 ? capacity : 16;
+    list->edges = (struct EdgeRecord*) malloc(list->capacity * sizeof(struct EdgeRecord));
+    if (list->edges == NULL) {
+        list->capacity = 0;
+        return -1;
+    }
+    return 0;
+}
+
+int pushEdge(struct EdgeList* list, int src, int dest, int weight) {
+    if (list->count == list->capacity) {
+        long capacity = list->capacity > 0 ? 2 * list->capacity : 16;
+        struct EdgeRecord* edges = (struct EdgeRecord*) realloc(list->edges, capacity * sizeof(struct EdgeRecord));
+        if (edges == NULL) {
+            return -1;
+        }
+        list->edges = edges;
+        list->capacity = capacity;
+    }
+    list->edges[list->count].src = src;
+    list->edges[list->count].dest = dest;
+    list->edges[list->count].weight = weight;
+    list->count++;
+    return 0;
+}
+
+void freeEdgeList(struct EdgeList* list) {
+    free(list->edges);
+    list->edges = NULL;
+    list->count = list->capacity = 0;
+}
+
+// Function to run fn on every worker and wait for all of them
+static void runWorkers(struct CSRBuild* build, void* (*fn)(void*)) {
+    pthread_t* tids = (pthread_t*) malloc(build->threads * sizeof(pthread_t));
+    struct CSRWorker* workers = (struct CSRWorker*) malloc(build->threads * sizeof(struct CSRWorker));
+
+    for (int t = 0; t < build->threads; ++t) {
+        workers[t].build = build;
+        workers[t].t = t;
+        pthread_create(&tids[t], NULL, fn, &workers[t]);
+    }
+    for (int t = 0; t < build->threads; ++t) {
+        pthread_join(tids[t], NULL);
+    }
+
+    free(tids);
+    free(workers);
+}
+
+// Function to get the first list of thread t: each thread takes a contiguous block of lists, so
+// that cursors handed out in thread order keep the lists in order within a row
+static int firstList(struct CSRBuild* build, int t) {
+    return (int) ((long) build->numLists * t / build->threads);
+}
+
+// Phase 1: every thread counts the out-degrees of the lists it owns
+static void* countDegrees(void* arg) {
+    struct CSRWorker* worker = (struct CSRWorker*) arg;
+    struct CSRBuild* build = worker->build;
+    long* counts = build->counts[worker->t];
+
+    for (int i = firstList(build, worker->t); i < firstList(build, worker->t + 1); ++i) {
+        struct EdgeList* list = &build->lists[i];
+        for (long e = 0; e < list->count; ++e) {
+            counts[list->edges[e].src]++;
+        }
+    }
+    return NULL;
+}
+
+// Phase 2a: every thread sums the degrees in its vertex range
+static void* sumRange(void* arg) {
+    struct CSRWorker* worker = (struct CSRWorker*) arg;
+    struct CSRBuild* build = worker->build;
+    int first = (int) ((long) build->V * worker->t / build->threads);
+    int last = (int) ((long) build->V * (worker->t + 1) / build->threads);
+    long total = 0;
+
+    for (int v = first; v < last; ++v) {
+        for (int t = 0; t < build->threads; ++t) {
+            total += build->counts[t][v];
+        }
+    }
+    build->rangeTotals[worker->t] = total;
+    return NULL;
+}
+
+// Phase 2b: every thread writes offsets for its range and turns counts into write cursors
+static void* fillOffsets(void* arg) {
+    struct CSRWorker* worker = (struct CSRWorker*) arg;
+    struct CSRBuild* build = worker->build;
+    int first = (int) ((long) build->V * worker->t / build->threads);
+    int last = (int) ((long) build->V * (worker->t + 1) / build->threads);
+    long running = build->rangeTotals[worker->t];  // Already turned into an exclusive prefix sum
+
+    for (int v = first; v < last; ++v) {
+        build->csr->offsets[v] = running;
+        for (int t = 0; t < build->threads; ++t) {
+            long count = build->counts[t][v];
+            build->counts[t][v] = running;
+            running += count;
+        }
+    }
+    return NULL;
+}
+
+// Phase 3: every thread scatters its lists through its own cursors
+static void* scatterEdges(void* arg) {
+    struct CSRWorker* worker = (struct CSRWorker*) arg;
+    struct CSRBuild* build = worker->build;
+    long* cursor = build->counts[worker->t];
+
+    for (int i = firstList(build, worker->t); i < firstList(build, worker->t + 1); ++i) {
+        struct EdgeList* list = &build->lists[i];
+        for (long e = 0; e < list->count; ++e) {
+            long slot = cursor[list->edges[e].src]++;
+            build->csr->targets[slot] = list->edges[e].dest;
+            build->csr->weights[slot] = list->edges[e].weight;
+        }
+    }
+    return NULL;
+}
+
+// Function to build a CSR graph from several edge lists in parallel
+struct CSRGraph* buildCSRGraph(int V, struct EdgeList* lists, int numLists, int threads) {
+    struct CSRBuild build;
+    build.V = V;
+    build.threads = threads > 0 ? threads : 1;
+    build.lists = lists;
+    build.numLists = numLists;
+    build.counts = (long**) malloc(build.threads * sizeof(long*));
+    build.rangeTotals = (long*) malloc(build.threads * sizeof(long));
+    for (int t = 0; t < build.threads; ++t) {
+        build.counts[t] = (long*) calloc(V, sizeof(long));
+    }
+
+    long E = 0;
+    for (int i = 0; i < numLists; ++i) {
+        E += lists[i].count;
+    }
+
+    struct CSRGraph* csr = (struct CSRGraph*) malloc(sizeof(struct CSRGraph));
+    csr->V = V;
+    csr->E = E;
+    csr->offsets = (long*) malloc((V + 1) * sizeof(long));
+    csr->targets = (int*) malloc((E + 1) * sizeof(int));
+    csr->weights = (int*) malloc((E + 1) * sizeof(int));
+    build.csr = csr;
+
+    runWorkers(&build, countDegrees);
+    runWorkers(&build, sumRange);
+
+    // Exclusive prefix sum over the per-range totals
+    long running = 0;
+    for (int t = 0; t < build.threads; ++t) {
+        long total = build.rangeTotals[t];
+        build.rangeTotals[t] = running;
+        running += total;
+    }
+    csr->offsets[V] = running;
+
+    runWorkers(&build, fillOffsets);
+    runWorkers(&build, scatterEdges);
+
+    for (int t = 0; t < build.threads; ++t) {
+        free(build.counts[t]);
+    }
+    free(build.counts);
+    free(build.rangeTotals);
+    return csr;
+}
+
+// Function to free a CSR graph
+void freeCSRGraph(struct CSRGraph* csr) {
+    free(csr->offsets);
+    free(csr->targets);
+    free(csr->weights);
+    free(csr);
+}
+
+// Function to narrow the weights of csr to 16 bits; NULL if one is outside 0 .. UINT16_MAX
+struct CSRGraph16* narrowCSRWeights(const struct CSRGraph* csr) {
+    for (long i = 0; i < csr->E; ++i) {
+        if (csr->weights[i] < 0 || csr->weights[i] > UINT16_MAX) {
+            return NULL;
+        }
+    }
+    struct CSRGraph16* narrow = (struct CSRGraph16*) malloc(sizeof(struct CSRGraph16));
+    narrow->V = csr->V;
+    narrow->E = csr->E;
+    narrow->offsets = csr->offsets;
+    narrow->targets = csr->targets;
+    narrow->weights = (uint16_t*) malloc((csr->E > 0 ? csr->E : 1) * sizeof(uint16_t));
+    for (long i = 0; i < csr->E; ++i) {
+        narrow->weights[i] = (uint16_t) csr->weights[i];
+    }
+    return narrow;
+}
+
+// Function to free a narrowed CSR graph, leaving the borrowed rows alone
+void freeCSRGraph16(struct CSRGraph16* narrow) {
+    free(narrow->weights);
+    free(narrow);
+}
+
+// Function to sort row keys ((target << 32) | weight) in place: insertion sort for the short
+// rows most graphs are made of, qsort for the rest
+static int compareRowKeys(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*) a, y = *(const uint64_t*) b;
+    return (x > y) - (x < y);
+}
+
+static void sortRowKeys(uint64_t* keys, long n) {
+    if (n > 32) {
+        qsort(keys, n, sizeof(uint64_t), compareRowKeys);
+        return;
+    }
+    for (long i = 1; i < n; ++i) {
+        uint64_t key = keys[i];
+        long j = i - 1;
+        while (j >= 0 && keys[j] > key) {
+            keys[j + 1] = keys[j];
+            j--;
+        }
+        keys[j + 1] = key;
+    }
+}
+
+// Normalize phase 1: every thread sorts the rows of its range in place and drops the
+// duplicates and self-loops, counting what each row keeps
+static void* sortRows(void* arg) {
+    struct CSRWorker* worker = (struct CSRWorker*) arg;
+    struct CSRBuild* build = worker->build;
+    struct CSRGraph* csr = build->csr;
+    uint64_t* keys = NULL;
+    long capacity = 0, total = 0;
+
+    for (int v = build->rangeFirst[worker->t]; v < build->rangeFirst[worker->t + 1]; ++v) {
+        long begin = csr->offsets[v];
+        long degree = csr->offsets[v + 1] - begin;
+        if (degree > capacity) {
+            capacity = degree > 2 * capacity ? degree : 2 * capacity;
+            keys = (uint64_t*) realloc(keys, capacity * sizeof(uint64_t));
+        }
+        for (long i = 0; i < degree; ++i) {
+            keys[i] = (uint64_t) (uint32_t) csr->targets[begin + i] << 32 | (uint32_t) csr->weights[begin + i];
+        }
+        sortRowKeys(keys, degree);
+
+        long kept = 0;
+        for (long i = 0; i < degree; ++i) {
+            int target = (int) (keys[i] >> 32);
+            if ((build->flags & CSR_DROP_SELF_LOOPS) && target == v) {
+                continue;
+            }
+            if ((build->flags & CSR_DEDUP) && kept > 0 && csr->targets[begin + kept - 1] == target) {
+                continue;  // The lightest one came first
+            }
+            csr->targets[begin + kept] = target;
+            csr->weights[begin + kept] = (int) (uint32_t) keys[i];
+            kept++;
+        }
+        build->kept[v] = kept;
+        total += kept;
+    }
+    build->rangeTotals[worker->t] = total;
+    free(keys);
+    return NULL;
+}
+
+// Normalize phase 2: every thread copies the kept part of its rows to their new place. Each
+// thread reads and rewrites only the offsets of its own rows.
+static void* compactRows(void* arg) {
+    struct CSRWorker* worker = (struct CSRWorker*) arg;
+    struct CSRBuild* build = worker->build;
+    struct CSRGraph* csr = build->csr;
+    long running = build->rangeTotals[worker->t];  // Already turned into an exclusive prefix sum
+
+    for (int v = build->rangeFirst[worker->t]; v < build->rangeFirst[worker->t + 1]; ++v) {
+        long begin = csr->offsets[v];
+        long kept = build->kept[v];
+        memcpy(build->newTargets + running, csr->targets + begin, kept * sizeof(int));
+        memcpy(build->newWeights + running, csr->weights + begin, kept * sizeof(int));
+        csr->offsets[v] = running;
+        running += kept;
+    }
+    return NULL;
+}
+
+// Function to sort, and optionally deduplicate, the rows of csr in parallel
+void normalizeCSRGraph(struct CSRGraph* csr, int flags, int threads) {
+    struct CSRBuild build;
+    memset(&build, 0, sizeof(build));
+    build.V = csr->V;
+    build.threads = threads > 0 ? threads : 1;
+    build.csr = csr;
+    build.flags = flags;
+    build.rangeTotals = (long*) malloc(build.threads * sizeof(long));
+    build.kept = (long*) malloc((csr->V > 0 ? csr->V : 1) * sizeof(long));
+
+    // Ranges with about E / threads edges each, so a few heavy rows do not land on one thread
+    build.rangeFirst = (int*) malloc((build.threads + 1) * sizeof(int));
+    build.rangeFirst[0] = 0;
+    for (int t = 1; t < build.threads; ++t) {
+        long target = csr->E * t / build.threads;
+        int low = build.rangeFirst[t - 1], high = csr->V;
+        while (low < high) {
+            int mid = low + (high - low) / 2;
+            if (csr->offsets[mid] < target) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        build.rangeFirst[t] = low;
+    }
+    build.rangeFirst[build.threads] = csr->V;
+
+    runWorkers(&build, sortRows);
+
+    long running = 0;
+    for (int t = 0; t < build.threads; ++t) {
+        long total = build.rangeTotals[t];
+        build.rangeTotals[t] = running;
+        running += total;
+    }
+    if (running != csr->E) {
+        build.newTargets = (int*) malloc((running + 1) * sizeof(int));
+        build.newWeights = (int*) malloc((running + 1) * sizeof(int));
+        runWorkers(&build, compactRows);
+        free(csr->targets);
+        free(csr->weights);
+        csr->targets = build.newTargets;
+        csr->weights = build.newWeights;
+        csr->offsets[csr->V] = running;
+        csr->E = running;
+    }
+
+    free(build.rangeFirst);
+    free(build.kept);
+    free(build.rangeTotals);
+}
@@ -0,0 +1,76 @@
+#ifndef CSR_H
+#define CSR_H
+
+#include <stdint.h>
+
+// One weighted edge in an edge list
+struct EdgeRecord {
+    int src;
+    int dest;
+    int weight;
+};
+
+// A growable edge list; generators fill one per thread
+struct EdgeList {
+    long count;
+    long capacity;
+    struct EdgeRecord *edges;
+};
+
+// A graph in compressed sparse row form: the out-edges of u are
+// targets[offsets[u] .. offsets[u+1]) with matching weights
+struct CSRGraph {
+    int V;          // Number of vertices
+    long E;         // Number of edges
+    long *offsets;  // V + 1 entries
+    int *targets;
+    int *weights;
+};
+
+// A CSR graph with 16-bit weights, 6 instead of 8 bytes per edge for graphs whose weights
+// all fit. offsets and targets are borrowed from the struct CSRGraph it was narrowed from.
+struct CSRGraph16 {
+    int V;
+    long E;
+    long *offsets;
+    int *targets;
+    uint16_t *weights;
+};
+
+// Function to return the number of worker threads to use by default (online CPUs)
+int defaultThreadCount(void);
+
+// Functions to manage an edge list; initEdgeList() and pushEdge() return -1 when out of memory
+// and leave the list valid
+int initEdgeList(struct EdgeList* list, long capacity);
+int pushEdge(struct EdgeList* list, int src, int dest, int weight);
+void freeEdgeList(struct EdgeList* list);
+
+// Function to build a CSR graph from several edge lists in parallel: per-thread degree
+// histograms, a prefix sum over vertex ranges, then a scatter with no atomics.
+// Each thread takes a contiguous block of lists, so within a row edges keep the order of
+// lists[0], lists[1], ... for any number of threads.
+// The lists are only read: they may be views of a mapped edge stream (graphio.h).
+struct CSRGraph* buildCSRGraph(int V, struct EdgeList* lists, int numLists, int threads);
+
+// Options of normalizeCSRGraph(); each of them sorts the rows
+#define CSR_SORT_ROWS 1        // Order every row by target, then weight
+#define CSR_DEDUP 2            // Keep one edge per (u, v): the lightest
+#define CSR_DROP_SELF_LOOPS 4  // Drop the edges (u, u)
+
+// Function to sort, and optionally deduplicate, the rows of csr in parallel, over ranges with
+// about the same number of edges each. Weights must not be negative. When edges are dropped,
+// targets and weights are compacted into new arrays and E shrinks.
+void normalizeCSRGraph(struct CSRGraph* csr, int flags, int threads);
+
+// Function to free a CSR graph
+void freeCSRGraph(struct CSRGraph* csr);
+
+// Function to narrow the weights of csr to 16 bits; NULL if one is outside 0 .. UINT16_MAX.
+// The result shares the rows of csr and must be freed before it.
+struct CSRGraph16* narrowCSRWeights(const struct CSRGraph* csr);
+
+// Function to free a narrowed CSR graph, leaving the borrowed rows alone
+void freeCSRGraph16(struct CSRGraph16* narrow);
+
+#endif
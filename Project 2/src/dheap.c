@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dheap.h"
+
+#define ARITY 4
+#define CACHE_LINE 64
+
+// Function to create an empty heap for vertex ids 0..capacity-1
+struct DaryHeap* createDaryHeap(int capacity) {
+    struct DaryHeap* heap = (struct DaryHeap*) malloc(sizeof(struct DaryHeap));
+    heap->size = 0;
+    heap->capacity = capacity;
+
+    // keys[1] starts a cache line, so each group of four siblings 4i+1..4i+4 shares one line
+    size_t bytes = ((capacity + CACHE_LINE / sizeof(int)) * sizeof(int) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    heap->keyBlock = (int*) aligned_alloc(CACHE_LINE, bytes);
+    heap->keys = heap->keyBlock + CACHE_LINE / sizeof(int) - 1;
+    heap->ids = (int*) malloc(capacity * sizeof(int));
+    heap->pos = (int*) malloc(capacity * sizeof(int));
+
+    for (int v = 0; v < capacity; ++v) {
+        heap->pos[v] = -1;
+    }
+    return heap;
+}
+
+// Function to free the heap
+void freeDaryHeap(struct DaryHeap* heap) {
+    free(heap->keyBlock);
+    free(heap->ids);
+    free(heap->pos);
+    free(heap);
+}
+
+// Function to empty the heap; only the slots in use are cleared
+void clearDaryHeap(struct DaryHeap* heap) {
+    for (int i = 0; i < heap->size; ++i) {
+        heap->pos[heap->ids[i]] = -1;
+    }
+    heap->size = 0;
+}
+
+// Function to move the entry (v, key) up from slot i, shifting parents down into the hole
+static void siftUp(struct DaryHeap* heap, int i, int v, int key, int* comparisonCount) {
+    int* keys = heap->keys;
+    int* ids = heap->ids;
+
+    while (i > 0) {
+        int parent = (i - 1) / ARITY;
+        (*comparisonCount)++;
+        if (keys[parent] <= key) {
+            break;
+        }
+        keys[i] = keys[parent];
+        ids[i] = ids[parent];
+        heap->pos[ids[i]] = i;
+        i = parent;
+    }
+    keys[i] = key;
+    ids[i] = v;
+    heap->pos[v] = i;
+}
+
+// Function to move the entry (v, key) down from slot i, shifting the smallest child up into the hole
+static void siftDown(struct DaryHeap* heap, int i, int v, int key, int* comparisonCount) {
+    int* keys = heap->keys;
+    int* ids = heap->ids;
+    int size = heap->size;
+
+    for (;;) {
+        int first = ARITY * i + 1;
+        if (first >= size) {
+            break;
+        }
+
+        // The grandchildren are read on the next level; start loading their lines now
+        int grandchild = ARITY * first + 1;
+        if (grandchild < size) {
+            __builtin_prefetch(&keys[grandchild]);
+            __builtin_prefetch(&keys[grandchild + ARITY * ARITY - 1]);
+        }
+
+        int best = first;
+        int last = first + ARITY < size ? first + ARITY : size;
+        for (int c = first + 1; c < last; ++c) {
+            (*comparisonCount)++;
+            if (keys[c] < keys[best]) {
+                best = c;
+            }
+        }
+
+        (*comparisonCount)++;
+        if (keys[best] >= key) {
+            break;
+        }
+        keys[i] = keys[best];
+        ids[i] = ids[best];
+        heap->pos[ids[i]] = i;
+        i = best;
+    }
+    keys[i] = key;
+    ids[i] = v;
+    heap->pos[v] = i;
+}
+
+// Function to insert v with the given key
+void daryPush(struct DaryHeap* heap, int v, int key, int* comparisonCount) {
+    siftUp(heap, heap->size++, v, key, comparisonCount);
+}
+
+// Function to lower the key of v, which must be in the heap
+void daryDecreaseKey(struct DaryHeap* heap, int v, int key, int* comparisonCount) {
+    siftUp(heap, heap->pos[v], v, key, comparisonCount);
+}
+
+// Function to remove the vertex with the smallest key
+int daryPopMin(struct DaryHeap* heap, int* key, int* comparisonCount) {
+    int v = heap->ids[0];
+    if (key != NULL) {
+        *key = heap->keys[0];
+    }
+    heap->pos[v] = -1;
+
+    // Sift the last entry down from the root
+    heap->size--;
+    if (heap->size > 0) {
+        int last = heap->size;
+        siftDown(heap, 0, heap->ids[last], heap->keys[last], comparisonCount);
+    }
+    return v;
+}
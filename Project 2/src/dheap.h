@@ -0,0 +1,39 @@
+#ifndef DHEAP_H
+#define DHEAP_H
+
+// A 4-ary min-heap over vertex ids stored as parallel arrays. A sift-down compares the
+// four children of a slot, which sit next to each other in keys[], instead of chasing
+// one pointer per child as struct MinHeap does.
+struct DaryHeap {
+    int size;
+    int capacity;  // Largest vertex id + 1
+    int *keys;     // keys[i] = priority of slot i
+    int *ids;      // ids[i] = vertex in slot i
+    int *pos;      // pos[v] = slot of v, -1 if v is not in the heap
+    int *keyBlock; // Allocation behind keys, offset so that every group of siblings is 16-byte aligned
+};
+
+// Function to create an empty heap for vertex ids 0..capacity-1
+struct DaryHeap* createDaryHeap(int capacity);
+
+// Function to free the heap
+void freeDaryHeap(struct DaryHeap* heap);
+
+// Function to empty the heap; O(size), only the slots in use are cleared
+void clearDaryHeap(struct DaryHeap* heap);
+
+// Function to insert v with the given key
+void daryPush(struct DaryHeap* heap, int v, int key, int* comparisonCount);
+
+// Function to lower the key of v, which must be in the heap
+void daryDecreaseKey(struct DaryHeap* heap, int v, int key, int* comparisonCount);
+
+// Function to remove the vertex with the smallest key, storing its key in *key if not NULL
+int daryPopMin(struct DaryHeap* heap, int* key, int* comparisonCount);
+
+// Function to check whether v is in the heap
+static inline int daryContains(struct DaryHeap* heap, int v) {
+    return heap->pos[v] >= 0;
+}
+
+#endif
@@ -0,0 +1,174 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dijkstra.h"
+#include "distance.h"
+#include "minheap.h"
+#include "dheap.h"
+#include "trace.h"
+
+// Trace the engines below record their heap operations into, NULL when not tracing
+static struct Trace* heapTrace = NULL;
+
+// Function to start (trace != NULL) or stop recording heap operations
+void setDijkstraTrace(struct Trace* trace) {
+    heapTrace = trace;
+}
+
+static inline void traceHeapOp(int type, int v, int key) {
+    if (heapTrace != NULL) {
+        appendTraceOp(heapTrace, type, v, key);
+    }
+}
+
+// Function to run Dijkstra's algorithm from src, writing shortest distances into dist[]
+void dijkstraDist(struct Graph* graph, int src, int* dist, int* comparisonCount) {
+    int V = graph->V;  // Number of vertices
+
+    // Create a min-heap and initialize it; the nodes sit side by side in one arena
+    struct MinHeap* minHeap = createMinHeap(V);
+    struct Arena nodes;
+    arenaInit(&nodes, V * sizeof(struct MinHeapNode));
+    traceHeapOp(TRACE_RESET, V, 0);
+
+    // Initialize distances
+    for (int v = 0; v < V; ++v) {
+        dist[v] = INF;
+        minHeap->array[v] = arenaMinHeapNode(&nodes, v, dist[v]);
+        minHeap->pos[v] = v;
+        traceHeapOp(TRACE_PUSH, v, INF);
+    }
+
+    // Set distance of the source vertex
+    dist[src] = 0;
+    decreaseKey(minHeap, src, dist[src], comparisonCount);
+    traceHeapOp(TRACE_DECREASE, src, 0);
+
+    minHeap->size = V;
+
+    // Loop until the min-heap is empty
+    while (minHeap->size > 0) {
+        // Extract the vertex with the minimum distance
+        struct MinHeapNode* minHeapNode = extractMin(minHeap, comparisonCount);
+        int u = minHeapNode->v;
+        traceHeapOp(TRACE_POP, u, minHeapNode->dist);
+
+        // Traverse all adjacent vertices of the extracted vertex
+        struct Edge* pCrawl = graph->array[u].head;
+        while (pCrawl != NULL) {
+            int v = pCrawl->dest;
+
+            // Relax the edge
+            (*comparisonCount)++;
+            if (isInMinHeap(minHeap, v) && dist[u] != INF && addDistInt(dist[u], pCrawl->weight, INF) < dist[v]) {
+                dist[v] = addDistInt(dist[u], pCrawl->weight, INF);
+                decreaseKey(minHeap, v, dist[v], comparisonCount);
+                traceHeapOp(TRACE_DECREASE, v, dist[v]);
+            }
+            pCrawl = pCrawl->next;
+        }
+    }
+
+    arenaFree(&nodes);
+    freeMinHeap(minHeap);
+}
+
+// Function to implement Dijkstra's algorithm with comparison counting
+void dijkstra(struct Graph* graph, int src, int* comparisonCount) {
+    int* dist = (int*) malloc(graph->V * sizeof(int));  // dist[i] will hold the shortest distance from src to i
+
+    dijkstraDist(graph, src, dist, comparisonCount);
+
+    free(dist);
+}
+
+// Function to run Dijkstra's algorithm on a CSR graph, writing shortest distances into dist[]
+void dijkstraCSR(struct CSRGraph* csr, int src, int* dist, int* comparisonCount) {
+    int V = csr->V;
+    struct MinHeap* minHeap = createMinHeap(V);
+
+    // One node per vertex, allocated together instead of one malloc each
+    struct MinHeapNode* nodes = (struct MinHeapNode*) malloc(V * sizeof(struct MinHeapNode));
+    traceHeapOp(TRACE_RESET, V, 0);
+
+    // Initialize distances
+    for (int v = 0; v < V; ++v) {
+        dist[v] = INF;
+        nodes[v].v = v;
+        nodes[v].dist = INF;
+        minHeap->array[v] = &nodes[v];
+        minHeap->pos[v] = v;
+        traceHeapOp(TRACE_PUSH, v, INF);
+    }
+
+    // Set distance of the source vertex
+    dist[src] = 0;
+    decreaseKey(minHeap, src, dist[src], comparisonCount);
+    traceHeapOp(TRACE_DECREASE, src, 0);
+
+    minHeap->size = V;
+
+    // Loop until the min-heap is empty
+    while (minHeap->size > 0) {
+        struct MinHeapNode* minHeapNode = extractMin(minHeap, comparisonCount);
+        int u = minHeapNode->v;
+        traceHeapOp(TRACE_POP, u, minHeapNode->dist);
+
+        // Traverse the row of u
+        for (long i = csr->offsets[u]; i < csr->offsets[u + 1]; ++i) {
+            int v = csr->targets[i];
+
+            // Relax the edge
+            (*comparisonCount)++;
+            if (isInMinHeap(minHeap, v) && dist[u] != INF && addDistInt(dist[u], csr->weights[i], INF) < dist[v]) {
+                dist[v] = addDistInt(dist[u], csr->weights[i], INF);
+                decreaseKey(minHeap, v, dist[v], comparisonCount);
+                traceHeapOp(TRACE_DECREASE, v, dist[v]);
+            }
+        }
+    }
+
+    free(nodes);
+    freeMinHeap(minHeap);
+}
+
+// Function to run Dijkstra's algorithm on a CSR graph with the 4-ary struct DaryHeap.
+// Vertices enter the heap when first reached instead of all at once.
+void dijkstraCSRDary(struct CSRGraph* csr, int src, int* dist, int* comparisonCount) {
+    int V = csr->V;
+    struct DaryHeap* heap = createDaryHeap(V);
+
+    for (int v = 0; v < V; ++v) {
+        dist[v] = INF;
+    }
+    dist[src] = 0;
+    daryPush(heap, src, 0, comparisonCount);
+    traceHeapOp(TRACE_RESET, V, 0);
+    traceHeapOp(TRACE_PUSH, src, 0);
+
+    while (heap->size > 0) {
+        int key;
+        int u = daryPopMin(heap, &key, comparisonCount);
+        traceHeapOp(TRACE_POP, u, key);
+
+        // Traverse the row of u
+        for (long i = csr->offsets[u]; i < csr->offsets[u + 1]; ++i) {
+            int v = csr->targets[i];
+
+            // Relax the edge; with positive weights a settled vertex never improves
+            (*comparisonCount)++;
+            if (addDistInt(dist[u], csr->weights[i], INF) < dist[v]) {
+                dist[v] = addDistInt(dist[u], csr->weights[i], INF);
+                if (daryContains(heap, v)) {
+                    daryDecreaseKey(heap, v, dist[v], comparisonCount);
+                    traceHeapOp(TRACE_DECREASE, v, dist[v]);
+                } else {
+                    daryPush(heap, v, dist[v], comparisonCount);
+                    traceHeapOp(TRACE_PUSH, v, dist[v]);
+                }
+            }
+        }
+    }
+
+    freeDaryHeap(heap);
+}
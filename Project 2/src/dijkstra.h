@@ -0,0 +1,23 @@
+#ifndef DIJKSTRA_H
+#define DIJKSTRA_H
+
+#include "graph.h"
+#include "csr.h"
+#include "trace.h"
+
+// Function to run Dijkstra's algorithm from src, writing shortest distances into dist[]
+void dijkstraDist(struct Graph* graph, int src, int* dist, int* comparisonCount);
+
+// Function to implement Dijkstra's algorithm with comparison counting
+void dijkstra(struct Graph* graph, int src, int* comparisonCount);
+
+// Function to run Dijkstra's algorithm on a CSR graph, writing shortest distances into dist[]
+void dijkstraCSR(struct CSRGraph* csr, int src, int* dist, int* comparisonCount);
+
+// Function to run Dijkstra's algorithm on a CSR graph using the 4-ary struct DaryHeap
+void dijkstraCSRDary(struct CSRGraph* csr, int src, int* dist, int* comparisonCount);
+
+// Function to make the engines above record their heap operations into trace (NULL stops)
+void setDijkstraTrace(struct Trace* trace);
+
+#endif
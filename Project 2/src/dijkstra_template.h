@@ -0,0 +1,299 @@
+// Dijkstra "template": every inclusion generates one specialized single-source shortest path
+// function, so that graph layout, priority queue, distance type and instrumentation are chosen
+// at compile time and mixed freely. No include guard on purpose; the parameters below are
+// #undef'd at the end so the next instantiation starts clean. See dijkstra_variants.c.
+//
+//   DIJKSTRA_NAME     name of the generated function (required):
+//                     void DIJKSTRA_NAME(GRAPH* graph, int src, DIJKSTRA_DIST* dist, long* comparisonCount)
+//   DIJKSTRA_GRAPH    DIJKSTRA_GRAPH_CSR (struct CSRGraph), DIJKSTRA_GRAPH_CSR16 (struct CSRGraph16,
+//                     16-bit weights), DIJKSTRA_GRAPH_LIST (struct Graph) or
+//                     DIJKSTRA_GRAPH_UNDIRECTED (struct UndirectedGraph, both directions)
+//   DIJKSTRA_QUEUE    DIJKSTRA_QUEUE_INDEXED: d-ary heap of vertices with decrease-key; a vertex
+//                     enters when first reached, like dijkstraCSRDary()
+//                     DIJKSTRA_QUEUE_LAZY: d-ary heap of (key, vertex) entries without
+//                     decrease-key; an improved vertex is pushed again and stale entries are
+//                     skipped when popped
+//   DIJKSTRA_ARITY    children per heap node (default 4)
+//   DIJKSTRA_DISTANCE DIJKSTRA_DIST_INT: int distances, INF from graph.h (default)
+//                     DIJKSTRA_DIST_U32 / DIJKSTRA_DIST_U64: uint32_t / uint64_t distances,
+//                     DIST_INF_U32 / DIST_INF_U64 for unreachable vertices
+//                     Tentative distances saturate at the infinity of the type (distance.h)
+//   DIJKSTRA_COUNT    1 counts key comparisons into *comparisonCount the way dijkstraCSRDary()
+//                     does (the counted 4-ary indexed CSR instance matches it exactly); 0 never
+//                     touches comparisonCount, and the counting compiles away
+
+#ifndef DIJKSTRA_TEMPLATE_COMMON
+#define DIJKSTRA_TEMPLATE_COMMON
+
+#include <stdlib.h>
+
+#include "graph.h"
+#include "csr.h"
+#include "undirected.h"
+#include "distance.h"
+
+#define DIJKSTRA_GRAPH_CSR 1
+#define DIJKSTRA_GRAPH_LIST 2
+#define DIJKSTRA_GRAPH_CSR16 3
+#define DIJKSTRA_GRAPH_UNDIRECTED 4
+#define DIJKSTRA_QUEUE_INDEXED 1
+#define DIJKSTRA_QUEUE_LAZY 2
+#define DIJKSTRA_DIST_INT 1
+#define DIJKSTRA_DIST_U32 2
+#define DIJKSTRA_DIST_U64 3
+
+#define DIJKSTRA_PASTE(a, b) a##b
+#define DIJKSTRA_JOIN(a, b) DIJKSTRA_PASTE(a, b)
+#define DIJKSTRA_LOCAL(name) DIJKSTRA_JOIN(DIJKSTRA_NAME, name)
+
+#endif
+
+#ifndef DIJKSTRA_NAME
+#error "Define DIJKSTRA_NAME before including dijkstra_template.h"
+#endif
+#ifndef DIJKSTRA_GRAPH
+#define DIJKSTRA_GRAPH DIJKSTRA_GRAPH_CSR
+#endif
+#ifndef DIJKSTRA_QUEUE
+#define DIJKSTRA_QUEUE DIJKSTRA_QUEUE_INDEXED
+#endif
+#ifndef DIJKSTRA_ARITY
+#define DIJKSTRA_ARITY 4
+#endif
+#ifndef DIJKSTRA_DISTANCE
+#define DIJKSTRA_DISTANCE DIJKSTRA_DIST_INT
+#endif
+#ifndef DIJKSTRA_COUNT
+#define DIJKSTRA_COUNT 1
+#endif
+
+#if DIJKSTRA_COUNT
+#define DIJKSTRA_COUNT_ONE() ((*comparisonCount)++)
+#define DIJKSTRA_COUNTER_PARAM , long* comparisonCount
+#define DIJKSTRA_COUNTER_ARG , comparisonCount
+#else
+#define DIJKSTRA_COUNT_ONE() ((void) 0)
+#define DIJKSTRA_COUNTER_PARAM
+#define DIJKSTRA_COUNTER_ARG
+#endif
+
+#if DIJKSTRA_DISTANCE == DIJKSTRA_DIST_U32
+#define DIJKSTRA_DIST uint32_t
+#define DIJKSTRA_INF DIST_INF_U32
+#define DIJKSTRA_ADD(d, w) addDistU32(d, w)
+#elif DIJKSTRA_DISTANCE == DIJKSTRA_DIST_U64
+#define DIJKSTRA_DIST uint64_t
+#define DIJKSTRA_INF DIST_INF_U64
+#define DIJKSTRA_ADD(d, w) addDistU64(d, w)
+#else
+#define DIJKSTRA_DIST int
+#define DIJKSTRA_INF INF
+#define DIJKSTRA_ADD(d, w) addDistInt(d, w, INF)
+#endif
+
+#if DIJKSTRA_GRAPH == DIJKSTRA_GRAPH_CSR || DIJKSTRA_GRAPH == DIJKSTRA_GRAPH_CSR16
+#if DIJKSTRA_GRAPH == DIJKSTRA_GRAPH_CSR
+#define DIJKSTRA_GRAPH_TYPE struct CSRGraph
+#else
+#define DIJKSTRA_GRAPH_TYPE struct CSRGraph16
+#endif
+#define DIJKSTRA_FOR_EDGES(graph, u, v, w)                                            \
+    for (long e_ = (graph)->offsets[u], end_ = (graph)->offsets[(u) + 1]; e_ < end_; ++e_) { \
+        int v = (graph)->targets[e_];                                                 \
+        DIJKSTRA_DIST w = (DIJKSTRA_DIST) (graph)->weights[e_];
+#elif DIJKSTRA_GRAPH == DIJKSTRA_GRAPH_UNDIRECTED
+#define DIJKSTRA_GRAPH_TYPE struct UndirectedGraph
+// The row of u (u is the lower end), then its reverse row (u is the higher end)
+#define DIJKSTRA_FOR_EDGES(graph, u, v, w)                                            \
+    for (int pass_ = 0; pass_ < 2; ++pass_)                                           \
+        for (long k_ = pass_ ? (graph)->reverseOffsets[u] : (graph)->offsets[u],      \
+                  end_ = pass_ ? (graph)->reverseOffsets[(u) + 1] : (graph)->offsets[(u) + 1]; \
+             k_ < end_; ++k_) {                                                       \
+            long e_ = pass_ ? (graph)->reverseEdges[k_] : k_;                         \
+            int v = (graph)->ends[e_] ^ (u);                                          \
+            DIJKSTRA_DIST w = (DIJKSTRA_DIST) (graph)->weights[e_];
+#else
+#define DIJKSTRA_GRAPH_TYPE struct Graph
+#define DIJKSTRA_FOR_EDGES(graph, u, v, w)                                            \
+    for (struct Edge* e_ = (graph)->array[u].head; e_ != NULL; e_ = e_->next) {       \
+        int v = e_->dest;                                                             \
+        DIJKSTRA_DIST w = (DIJKSTRA_DIST) e_->weight;
+#endif
+#define DIJKSTRA_END_EDGES }
+
+// The heap: keys[] and ids[] side by side, pos[] only for the indexed queue
+struct DIJKSTRA_LOCAL(Heap) {
+    int size;
+    int capacity;
+    DIJKSTRA_DIST* keys;
+    int* ids;
+    int* pos;  // pos[v] = slot of v, -1 if not in the heap (indexed queue)
+};
+
+// Function to move (v, key) up from slot i, shifting parents down into the hole
+static inline void DIJKSTRA_LOCAL(SiftUp)(struct DIJKSTRA_LOCAL(Heap)* heap, int i, int v, DIJKSTRA_DIST key
+                                          DIJKSTRA_COUNTER_PARAM) {
+    DIJKSTRA_DIST* keys = heap->keys;
+    int* ids = heap->ids;
+
+    while (i > 0) {
+        int parent = (i - 1) / DIJKSTRA_ARITY;
+        DIJKSTRA_COUNT_ONE();
+        if (keys[parent] <= key) {
+            break;
+        }
+        keys[i] = keys[parent];
+        ids[i] = ids[parent];
+#if DIJKSTRA_QUEUE == DIJKSTRA_QUEUE_INDEXED
+        heap->pos[ids[i]] = i;
+#endif
+        i = parent;
+    }
+    keys[i] = key;
+    ids[i] = v;
+#if DIJKSTRA_QUEUE == DIJKSTRA_QUEUE_INDEXED
+    heap->pos[v] = i;
+#endif
+}
+
+// Function to move (v, key) down from slot i, shifting the smallest child up into the hole
+static inline void DIJKSTRA_LOCAL(SiftDown)(struct DIJKSTRA_LOCAL(Heap)* heap, int i, int v, DIJKSTRA_DIST key
+                                            DIJKSTRA_COUNTER_PARAM) {
+    DIJKSTRA_DIST* keys = heap->keys;
+    int* ids = heap->ids;
+    int size = heap->size;
+
+    for (;;) {
+        int first = DIJKSTRA_ARITY * i + 1;
+        if (first >= size) {
+            break;
+        }
+        int best = first;
+        int last = first + DIJKSTRA_ARITY < size ? first + DIJKSTRA_ARITY : size;
+        for (int c = first + 1; c < last; ++c) {
+            DIJKSTRA_COUNT_ONE();
+            if (keys[c] < keys[best]) {
+                best = c;
+            }
+        }
+        DIJKSTRA_COUNT_ONE();
+        if (keys[best] >= key) {
+            break;
+        }
+        keys[i] = keys[best];
+        ids[i] = ids[best];
+#if DIJKSTRA_QUEUE == DIJKSTRA_QUEUE_INDEXED
+        heap->pos[ids[i]] = i;
+#endif
+        i = best;
+    }
+    keys[i] = key;
+    ids[i] = v;
+#if DIJKSTRA_QUEUE == DIJKSTRA_QUEUE_INDEXED
+    heap->pos[v] = i;
+#endif
+}
+
+// Function to push (v, key); the lazy queue grows as needed
+static inline void DIJKSTRA_LOCAL(Push)(struct DIJKSTRA_LOCAL(Heap)* heap, int v, DIJKSTRA_DIST key
+                                        DIJKSTRA_COUNTER_PARAM) {
+#if DIJKSTRA_QUEUE == DIJKSTRA_QUEUE_LAZY
+    if (heap->size == heap->capacity) {
+        heap->capacity *= 2;
+        heap->keys = (DIJKSTRA_DIST*) realloc(heap->keys, heap->capacity * sizeof(DIJKSTRA_DIST));
+        heap->ids = (int*) realloc(heap->ids, heap->capacity * sizeof(int));
+    }
+#endif
+    DIJKSTRA_LOCAL(SiftUp)(heap, heap->size++, v, key DIJKSTRA_COUNTER_ARG);
+}
+
+// Function to remove the smallest entry, its key goes to *key
+static inline int DIJKSTRA_LOCAL(PopMin)(struct DIJKSTRA_LOCAL(Heap)* heap, DIJKSTRA_DIST* key
+                                         DIJKSTRA_COUNTER_PARAM) {
+    int v = heap->ids[0];
+    *key = heap->keys[0];
+#if DIJKSTRA_QUEUE == DIJKSTRA_QUEUE_INDEXED
+    heap->pos[v] = -1;
+#endif
+    heap->size--;
+    if (heap->size > 0) {
+        int last = heap->size;
+        DIJKSTRA_LOCAL(SiftDown)(heap, 0, heap->ids[last], heap->keys[last] DIJKSTRA_COUNTER_ARG);
+    }
+    return v;
+}
+
+void DIJKSTRA_NAME(DIJKSTRA_GRAPH_TYPE* graph, int src, DIJKSTRA_DIST* dist, long* comparisonCount) {
+    int V = graph->V;
+    struct DIJKSTRA_LOCAL(Heap) heap;
+    heap.size = 0;
+#if DIJKSTRA_QUEUE == DIJKSTRA_QUEUE_INDEXED
+    heap.capacity = V;
+    heap.pos = (int*) malloc(V * sizeof(int));
+    for (int v = 0; v < V; ++v) {
+        heap.pos[v] = -1;
+    }
+#else
+    heap.capacity = V > 16 ? V : 16;
+    heap.pos = NULL;
+#endif
+    heap.keys = (DIJKSTRA_DIST*) malloc(heap.capacity * sizeof(DIJKSTRA_DIST));
+    heap.ids = (int*) malloc(heap.capacity * sizeof(int));
+#if !DIJKSTRA_COUNT
+    (void) comparisonCount;
+#endif
+
+    for (int v = 0; v < V; ++v) {
+        dist[v] = DIJKSTRA_INF;
+    }
+    dist[src] = 0;
+    DIJKSTRA_LOCAL(Push)(&heap, src, 0 DIJKSTRA_COUNTER_ARG);
+
+    while (heap.size > 0) {
+        DIJKSTRA_DIST key;
+        int u = DIJKSTRA_LOCAL(PopMin)(&heap, &key DIJKSTRA_COUNTER_ARG);
+#if DIJKSTRA_QUEUE == DIJKSTRA_QUEUE_LAZY
+        // An entry left behind by an improvement that was pushed again
+        DIJKSTRA_COUNT_ONE();
+        if (key > dist[u]) {
+            continue;
+        }
+#endif
+
+        DIJKSTRA_FOR_EDGES(graph, u, v, w)
+            // Relax the edge; with positive weights a settled vertex never improves
+            DIJKSTRA_COUNT_ONE();
+            DIJKSTRA_DIST candidate = DIJKSTRA_ADD(dist[u], w);
+            if (candidate < dist[v]) {
+                dist[v] = candidate;
+#if DIJKSTRA_QUEUE == DIJKSTRA_QUEUE_INDEXED
+                if (heap.pos[v] >= 0) {
+                    DIJKSTRA_LOCAL(SiftUp)(&heap, heap.pos[v], v, dist[v] DIJKSTRA_COUNTER_ARG);
+                    continue;
+                }
+#endif
+                DIJKSTRA_LOCAL(Push)(&heap, v, dist[v] DIJKSTRA_COUNTER_ARG);
+            }
+        DIJKSTRA_END_EDGES
+    }
+
+    free(heap.keys);
+    free(heap.ids);
+    free(heap.pos);
+}
+
+#undef DIJKSTRA_NAME
+#undef DIJKSTRA_GRAPH
+#undef DIJKSTRA_QUEUE
+#undef DIJKSTRA_ARITY
+#undef DIJKSTRA_DISTANCE
+#undef DIJKSTRA_DIST
+#undef DIJKSTRA_INF
+#undef DIJKSTRA_ADD
+#undef DIJKSTRA_COUNT
+#undef DIJKSTRA_COUNT_ONE
+#undef DIJKSTRA_COUNTER_PARAM
+#undef DIJKSTRA_COUNTER_ARG
+#undef DIJKSTRA_GRAPH_TYPE
+#undef DIJKSTRA_FOR_EDGES
+#undef DIJKSTRA_END_EDGES
@@ -0,0 +1,66 @@
+#include "dijkstra_variants.h"
+
+// Each block instantiates dijkstra_template.h once; the parameters are reset after every include
+
+#define DIJKSTRA_NAME dijkstraCSRQuadCounted
+#include "dijkstra_template.h"
+
+#define DIJKSTRA_NAME dijkstraCSRQuadFast
+#define DIJKSTRA_COUNT 0
+#include "dijkstra_template.h"
+
+#define DIJKSTRA_NAME dijkstraCSRBinaryCounted
+#define DIJKSTRA_ARITY 2
+#include "dijkstra_template.h"
+
+#define DIJKSTRA_NAME dijkstraCSRBinaryFast
+#define DIJKSTRA_ARITY 2
+#define DIJKSTRA_COUNT 0
+#include "dijkstra_template.h"
+
+#define DIJKSTRA_NAME dijkstraCSRLazyCounted
+#define DIJKSTRA_QUEUE DIJKSTRA_QUEUE_LAZY
+#include "dijkstra_template.h"
+
+#define DIJKSTRA_NAME dijkstraCSRLazyFast
+#define DIJKSTRA_QUEUE DIJKSTRA_QUEUE_LAZY
+#define DIJKSTRA_COUNT 0
+#include "dijkstra_template.h"
+
+#define DIJKSTRA_NAME dijkstraListQuadCounted
+#define DIJKSTRA_GRAPH DIJKSTRA_GRAPH_LIST
+#include "dijkstra_template.h"
+
+#define DIJKSTRA_NAME dijkstraListQuadFast
+#define DIJKSTRA_GRAPH DIJKSTRA_GRAPH_LIST
+#define DIJKSTRA_COUNT 0
+#include "dijkstra_template.h"
+
+#define DIJKSTRA_NAME dijkstraUndirectedCounted
+#define DIJKSTRA_GRAPH DIJKSTRA_GRAPH_UNDIRECTED
+#include "dijkstra_template.h"
+
+#define DIJKSTRA_NAME dijkstraUndirectedFast
+#define DIJKSTRA_GRAPH DIJKSTRA_GRAPH_UNDIRECTED
+#define DIJKSTRA_COUNT 0
+#include "dijkstra_template.h"
+
+#define DIJKSTRA_NAME dijkstraCSR16Dist32Counted
+#define DIJKSTRA_GRAPH DIJKSTRA_GRAPH_CSR16
+#define DIJKSTRA_DISTANCE DIJKSTRA_DIST_U32
+#include "dijkstra_template.h"
+
+#define DIJKSTRA_NAME dijkstraCSR16Dist32Fast
+#define DIJKSTRA_GRAPH DIJKSTRA_GRAPH_CSR16
+#define DIJKSTRA_DISTANCE DIJKSTRA_DIST_U32
+#define DIJKSTRA_COUNT 0
+#include "dijkstra_template.h"
+
+#define DIJKSTRA_NAME dijkstraCSRDist64Counted
+#define DIJKSTRA_DISTANCE DIJKSTRA_DIST_U64
+#include "dijkstra_template.h"
+
+#define DIJKSTRA_NAME dijkstraCSRDist64Fast
+#define DIJKSTRA_DISTANCE DIJKSTRA_DIST_U64
+#define DIJKSTRA_COUNT 0
+#include "dijkstra_template.h"
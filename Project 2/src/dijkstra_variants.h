@@ -0,0 +1,38 @@
+#ifndef DIJKSTRA_VARIANTS_H
+#define DIJKSTRA_VARIANTS_H
+
+#include <stdint.h>
+
+#include "graph.h"
+#include "csr.h"
+#include "undirected.h"
+
+// Specializations of dijkstra_template.h. Every function writes the distances from src into
+// dist[] (INF if unreachable). The Counted versions count key comparisons into
+// *comparisonCount; the Fast versions are compiled without any counting and leave it alone.
+//   CSRQuad    CSR graph, indexed 4-ary heap: the same search as dijkstraCSRDary()
+//   CSRBinary  CSR graph, indexed binary heap
+//   CSRLazy    CSR graph, 4-ary heap without decrease-key, stale entries skipped
+//   ListQuad   adjacency list struct Graph, indexed 4-ary heap
+//   Undirected struct UndirectedGraph, every edge once and followed both ways, indexed 4-ary heap
+// The width variants run CSRQuad with other distance and weight types; their unreachable
+// vertices get DIST_INF_U32 / DIST_INF_U64 (distance.h):
+//   CSR16Dist32  16-bit weights (narrowCSRWeights), uint32_t distances: the narrowest layout
+//   CSRDist64    uint64_t distances, for paths longer than INF or UINT32_MAX
+
+void dijkstraCSRQuadCounted(struct CSRGraph* csr, int src, int* dist, long* comparisonCount);
+void dijkstraCSRQuadFast(struct CSRGraph* csr, int src, int* dist, long* comparisonCount);
+void dijkstraCSRBinaryCounted(struct CSRGraph* csr, int src, int* dist, long* comparisonCount);
+void dijkstraCSRBinaryFast(struct CSRGraph* csr, int src, int* dist, long* comparisonCount);
+void dijkstraCSRLazyCounted(struct CSRGraph* csr, int src, int* dist, long* comparisonCount);
+void dijkstraCSRLazyFast(struct CSRGraph* csr, int src, int* dist, long* comparisonCount);
+void dijkstraListQuadCounted(struct Graph* graph, int src, int* dist, long* comparisonCount);
+void dijkstraListQuadFast(struct Graph* graph, int src, int* dist, long* comparisonCount);
+void dijkstraUndirectedCounted(struct UndirectedGraph* graph, int src, int* dist, long* comparisonCount);
+void dijkstraUndirectedFast(struct UndirectedGraph* graph, int src, int* dist, long* comparisonCount);
+void dijkstraCSR16Dist32Counted(struct CSRGraph16* csr, int src, uint32_t* dist, long* comparisonCount);
+void dijkstraCSR16Dist32Fast(struct CSRGraph16* csr, int src, uint32_t* dist, long* comparisonCount);
+void dijkstraCSRDist64Counted(struct CSRGraph* csr, int src, uint64_t* dist, long* comparisonCount);
+void dijkstraCSRDist64Fast(struct CSRGraph* csr, int src, uint64_t* dist, long* comparisonCount);
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef DISTANCE_H
+#define DISTANCE_H
+
+// Saturating distance arithmetic. A tentative distance d + w never wraps around: it stops at
+// the infinity of its type, so a path too long for the type reads as unreachable instead of
+// as a short (or negative) distance. Weights are never negative.
+
+#include <stdint.h>
+
+#define DIST_INF_U32 UINT32_MAX
+#define DIST_INF_U64 UINT64_MAX
+
+// Function to add weight w to distance d <= inf, stopping at inf; inf is the caller's INF
+static inline int addDistInt(int d, int w, int inf) {
+    return d >= inf - w ? inf : d + w;
+}
+
+// Function to add weight w to distance d, stopping at DIST_INF_U32
+static inline uint32_t addDistU32(uint32_t d, uint32_t w) {
+    uint32_t sum = d + w;
+    return sum < d ? DIST_INF_U32 : sum;
+}
+
+// Function to add weight w to distance d, stopping at DIST_INF_U64
+static inline uint64_t addDistU64(uint64_t d, uint64_t w) {
+    uint64_t sum = d + w;
+    return sum < d ? DIST_INF_U64 : sum;
+}
+
+#endif
@@ -0,0 +1,244 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dynamic.h"
+#include "distance.h"
+
+// Flags in state[]
+#define QUEUED 1    // In the heap right now
+#define SEEN 2      // Examined by the invalidation pass of this update
+#define AFFECTED 4  // Lost its shortest path and is being recomputed
+
+// Function to set a flag on v, remembering v so that the flags can be cleared afterwards
+static void mark(struct DynamicSSSP* sssp, int v, int flag) {
+    if (sssp->state[v] == 0) {
+        sssp->touched[sssp->touchedCount++] = v;
+    }
+    sssp->state[v] |= flag;
+}
+
+// Function to clear the flags of this update and return how many vertices it visited
+static int finishUpdate(struct DynamicSSSP* sssp) {
+    int visited = sssp->touchedCount;
+    for (int i = 0; i < sssp->touchedCount; ++i) {
+        sssp->state[sssp->touched[i]] = 0;
+    }
+    sssp->touchedCount = 0;
+    return visited;
+}
+
+// Function to insert v with the given key, or lower its key if it is already queued
+static void pushVertex(struct DynamicSSSP* sssp, int v, int key, int* comparisonCount) {
+    if (sssp->state[v] & QUEUED) {
+        decreaseKey(sssp->minHeap, v, key, comparisonCount);
+        return;
+    }
+    mark(sssp, v, QUEUED);
+    sssp->nodes[v].v = v;
+    sssp->nodes[v].dist = key;
+    insertMinHeap(sssp->minHeap, &sssp->nodes[v], comparisonCount);
+}
+
+// Function to pop the vertex with the smallest key
+static int popVertex(struct DynamicSSSP* sssp, int* comparisonCount) {
+    int u = extractMin(sssp->minHeap, comparisonCount)->v;
+    sssp->state[u] &= ~QUEUED;
+    return u;
+}
+
+// Function to run Dijkstra from the queued vertices. With onlyAffected set, edges into
+// vertices that kept their distance are skipped, since an increase cannot shorten them.
+static void propagate(struct DynamicSSSP* sssp, int onlyAffected, int* comparisonCount) {
+    int* dist = sssp->dist;
+
+    while (sssp->minHeap->size > 0) {
+        int u = popVertex(sssp, comparisonCount);
+
+        struct Edge* pCrawl = sssp->graph->array[u].head;
+        while (pCrawl != NULL) {
+            int v = pCrawl->dest;
+
+            // Relax the edge
+            (*comparisonCount)++;
+            if ((!onlyAffected || (sssp->state[v] & AFFECTED)) && addDistInt(dist[u], pCrawl->weight, INF) < dist[v]) {
+                dist[v] = addDistInt(dist[u], pCrawl->weight, INF);
+                sssp->pred[v] = u;
+                pushVertex(sssp, v, dist[v], comparisonCount);
+            }
+            pCrawl = pCrawl->next;
+        }
+    }
+}
+
+// Function to repair the distances after the edge u->v became shorter or appeared
+static int repairDecrease(struct DynamicSSSP* sssp, int u, int v, int weight, int* comparisonCount) {
+    (*comparisonCount)++;
+    if (sssp->dist[u] != INF && addDistInt(sssp->dist[u], weight, INF) < sssp->dist[v]) {
+        sssp->dist[v] = addDistInt(sssp->dist[u], weight, INF);
+        sssp->pred[v] = u;
+        pushVertex(sssp, v, sssp->dist[v], comparisonCount);
+        propagate(sssp, 0, comparisonCount);
+    }
+    return finishUpdate(sssp);
+}
+
+// Function to repair the distances after v's tree edge became longer or disappeared
+static int repairIncrease(struct DynamicSSSP* sssp, int v, int* comparisonCount) {
+    int* dist = sssp->dist;
+    int* pred = sssp->pred;
+    int affected = 0;
+
+    // Phase 1: walk the tight edges below v in order of the old distances. A vertex keeps
+    // its distance if a tight in-edge comes from a vertex that kept its own; that vertex is
+    // closer to src, so its fate is already decided when the check runs.
+    mark(sssp, v, SEEN);
+    pushVertex(sssp, v, dist[v], comparisonCount);
+
+    while (sssp->minHeap->size > 0) {
+        int y = popVertex(sssp, comparisonCount);
+        int kept = y == sssp->src;
+
+        struct Edge* pCrawl = sssp->reverse->array[y].head;
+        while (pCrawl != NULL && !kept) {
+            int z = pCrawl->dest;
+            (*comparisonCount)++;
+            if (!(sssp->state[z] & AFFECTED) && dist[z] != INF && addDistInt(dist[z], pCrawl->weight, INF) == dist[y]) {
+                pred[y] = z;
+                kept = 1;
+            }
+            pCrawl = pCrawl->next;
+        }
+        if (kept) {
+            continue;
+        }
+
+        mark(sssp, y, AFFECTED);
+        affected++;
+
+        pCrawl = sssp->graph->array[y].head;
+        while (pCrawl != NULL) {
+            int c = pCrawl->dest;
+            (*comparisonCount)++;
+            if (!(sssp->state[c] & SEEN) && dist[c] != INF && addDistInt(dist[y], pCrawl->weight, INF) == dist[c]) {
+                mark(sssp, c, SEEN);
+                pushVertex(sssp, c, dist[c], comparisonCount);
+            }
+            pCrawl = pCrawl->next;
+        }
+    }
+
+    // Phase 2: give every affected vertex its best distance through an unaffected
+    // in-neighbour, then let Dijkstra settle the affected region among itself
+    for (int i = 0; i < sssp->touchedCount && affected > 0; ++i) {
+        int y = sssp->touched[i];
+        if (!(sssp->state[y] & AFFECTED)) {
+            continue;
+        }
+
+        dist[y] = INF;
+        pred[y] = -1;
+        struct Edge* pCrawl = sssp->reverse->array[y].head;
+        while (pCrawl != NULL) {
+            int z = pCrawl->dest;
+            (*comparisonCount)++;
+            if (!(sssp->state[z] & AFFECTED) && dist[z] != INF && addDistInt(dist[z], pCrawl->weight, INF) < dist[y]) {
+                dist[y] = addDistInt(dist[z], pCrawl->weight, INF);
+                pred[y] = z;
+            }
+            pCrawl = pCrawl->next;
+        }
+        if (dist[y] != INF) {
+            pushVertex(sssp, y, dist[y], comparisonCount);
+        }
+    }
+    propagate(sssp, 1, comparisonCount);
+
+    return finishUpdate(sssp);
+}
+
+// Function to compute the shortest paths from src and start tracking graph
+struct DynamicSSSP* createDynamicSSSP(struct Graph* graph, int src, int* comparisonCount) {
+    int V = graph->V;
+    struct DynamicSSSP* sssp = (struct DynamicSSSP*) malloc(sizeof(struct DynamicSSSP));
+    sssp->graph = graph;
+    sssp->reverse = reverseGraph(graph);
+    sssp->src = src;
+    sssp->dist = (int*) malloc(V * sizeof(int));
+    sssp->pred = (int*) malloc(V * sizeof(int));
+    sssp->state = (int*) calloc(V, sizeof(int));
+    sssp->touched = (int*) malloc(V * sizeof(int));
+    sssp->touchedCount = 0;
+    sssp->nodes = (struct MinHeapNode*) malloc(V * sizeof(struct MinHeapNode));
+    sssp->minHeap = createMinHeap(V);
+
+    for (int v = 0; v < V; ++v) {
+        sssp->dist[v] = INF;
+        sssp->pred[v] = -1;
+    }
+
+    // The initial solve is a repair from a graph where nothing is reachable yet
+    sssp->dist[src] = 0;
+    pushVertex(sssp, src, 0, comparisonCount);
+    propagate(sssp, 0, comparisonCount);
+    finishUpdate(sssp);
+
+    return sssp;
+}
+
+// Function to add the edge u->v and repair the distances it shortens
+int dynamicInsertEdge(struct DynamicSSSP* sssp, int u, int v, int weight, int* comparisonCount) {
+    addEdge(sssp->graph, u, v, weight);
+    addEdge(sssp->reverse, v, u, weight);
+    return repairDecrease(sssp, u, v, weight, comparisonCount);
+}
+
+// Function to change the weight of an edge u->v and repair the distances
+int dynamicUpdateWeight(struct DynamicSSSP* sssp, int u, int v, int weight, int* comparisonCount) {
+    struct Edge* edge = findEdge(sssp->graph, u, v, -1);
+    if (edge == NULL) {
+        return -1;
+    }
+
+    // Parallel edges with the same weight are interchangeable, so any reverse twin will do
+    int oldWeight = edge->weight;
+    edge->weight = weight;
+    findEdge(sssp->reverse, v, u, oldWeight)->weight = weight;
+
+    if (weight < oldWeight) {
+        return repairDecrease(sssp, u, v, weight, comparisonCount);
+    }
+
+    // Only a tree edge can lengthen a shortest path
+    (*comparisonCount)++;
+    if (weight > oldWeight && sssp->pred[v] == u && addDistInt(sssp->dist[u], oldWeight, INF) == sssp->dist[v]) {
+        return repairIncrease(sssp, v, comparisonCount);
+    }
+    return 0;
+}
+
+// Function to delete an edge u->v and repair the distances
+int dynamicDeleteEdge(struct DynamicSSSP* sssp, int u, int v, int* comparisonCount) {
+    int weight = removeEdge(sssp->graph, u, v, -1);
+    if (weight < 0) {
+        return -1;
+    }
+    removeEdge(sssp->reverse, v, u, weight);
+
+    (*comparisonCount)++;
+    if (sssp->pred[v] == u && addDistInt(sssp->dist[u], weight, INF) == sssp->dist[v]) {
+        return repairIncrease(sssp, v, comparisonCount);
+    }
+    return 0;
+}
+
+// Function to free the tracking state (the graph itself belongs to the caller)
+void freeDynamicSSSP(struct DynamicSSSP* sssp) {
+    freeGraph(sssp->reverse);
+    free(sssp->dist);
+    free(sssp->pred);
+    free(sssp->state);
+    free(sssp->touched);
+    free(sssp->nodes);
+    freeMinHeap(sssp->minHeap);
+    free(sssp);
+}
@@ -0,0 +1,43 @@
+#ifndef DYNAMIC_H
+#define DYNAMIC_H
+
+#include "graph.h"
+#include "minheap.h"
+
+// Single-source shortest paths kept up to date while the graph changes.
+// Insertions and weight decreases are repaired by a Dijkstra search seeded with the
+// improved endpoint; deletions and weight increases first find the vertices that lost
+// their shortest path (Ramalingam-Reps) and then recompute only those.
+// Edge weights must be positive.
+struct DynamicSSSP {
+    struct Graph *graph;    // Out-edges, owned by the caller and changed in place by the updates
+    struct Graph *reverse;  // In-edges, kept in sync with graph
+    int src;
+    int *dist;              // dist[v] = shortest distance from src, INF if unreachable
+    int *pred;              // pred[v] = parent of v in the shortest path tree, -1 for src and unreachable
+    int *state;             // Per-update flags, cleared through touched[] after every update
+    int *touched;           // Vertices whose state is set
+    int touchedCount;
+    struct MinHeapNode *nodes;  // nodes[v] is the heap node of vertex v
+    struct MinHeap *minHeap;
+};
+
+// Function to compute the shortest paths from src and start tracking graph
+struct DynamicSSSP* createDynamicSSSP(struct Graph* graph, int src, int* comparisonCount);
+
+// Function to add the edge u->v and repair the distances it shortens.
+// Returns the number of vertices the repair visited.
+int dynamicInsertEdge(struct DynamicSSSP* sssp, int u, int v, int weight, int* comparisonCount);
+
+// Function to change the weight of an edge u->v and repair the distances.
+// Returns the number of vertices the repair visited, or -1 if there is no such edge.
+int dynamicUpdateWeight(struct DynamicSSSP* sssp, int u, int v, int weight, int* comparisonCount);
+
+// Function to delete an edge u->v and repair the distances.
+// Returns the number of vertices the repair visited, or -1 if there is no such edge.
+int dynamicDeleteEdge(struct DynamicSSSP* sssp, int u, int v, int* comparisonCount);
+
+// Function to free the tracking state (the graph itself belongs to the caller)
+void freeDynamicSSSP(struct DynamicSSSP* sssp);
+
+#endif
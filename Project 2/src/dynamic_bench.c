@@ -0,0 +1,219 @@
+// Build: gcc -O2 -o dynamic_bench dynamic_bench.c graph.c arena.c minheap.c dheap.c trace.c dijkstra.c dynamic.c csr.c -lpthread
+// Usage: ./dynamic_bench [V] [E] [updates] [checks]
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "graph.h"
+#include "csr.h"
+#include "dijkstra.h"
+#include "dynamic.h"
+
+#define NUM_OPS 5
+#define BATCH 1000  // Edges added per step of the partB sweep
+
+enum Operation { OP_INSERT, OP_DECREASE, OP_INCREASE, OP_DELETE, OP_BATCH };
+
+static const char* opNames[NUM_OPS] = {
+    "insert", "decrease", "increase", "delete", "insert x1000"
+};
+
+// Function to read a monotonic clock in microseconds
+static double nowMicros(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static int compareDoubles(const void* a, const void* b) {
+    double x = *(const double*) a;
+    double y = *(const double*) b;
+    return (x > y) - (x < y);
+}
+
+// Function to read the p-th percentile from a sorted array
+static double percentile(double* sorted, int n, double p) {
+    int idx = (int) (p / 100.0 * (n - 1) + 0.5);
+    return sorted[idx];
+}
+
+// Function to fill pool with every edge of the graph, so that updates can pick one uniformly
+static void collectEdges(struct Graph* graph, struct EdgeList* pool) {
+    initEdgeList(pool, 1024);
+    for (int u = 0; u < graph->V; ++u) {
+        for (struct Edge* e = graph->array[u].head; e != NULL; e = e->next) {
+            pushEdge(pool, u, e->dest, e->weight);
+        }
+    }
+}
+
+// Function to pick a random existing edge, uniformly over all edges, and return its index in
+// the pool. Parallel edges share a source and target, so the graph's first one stands for all.
+static long randomEdge(struct Graph* graph, struct EdgeList* pool, int* u, struct Edge** edge) {
+    long i = ((long) rand() * ((long) RAND_MAX + 1) + rand()) % pool->count;
+    *u = pool->edges[i].src;
+    *edge = findEdge(graph, *u, pool->edges[i].dest, -1);
+    return i;
+}
+
+// Function to tell whether an update of the given kind needs an existing edge
+static int needsEdge(int op) {
+    return op == OP_DECREASE || op == OP_INCREASE || op == OP_DELETE;
+}
+
+// Function to apply one random update of the given kind, returning the vertices it visited.
+// The pool follows the inserts and deletes; the caller makes sure it is not empty when needed.
+static int applyUpdate(struct DynamicSSSP* sssp, struct EdgeList* pool, int op, int* comparisonCount) {
+    struct Graph* graph = sssp->graph;
+    int V = graph->V;
+    int u;
+    struct Edge* edge;
+
+    switch (op) {
+    case OP_INSERT: {
+        u = rand() % V;
+        int v = rand() % V;
+        v = v == u ? (v + 1) % V : v;
+        int weight = (rand() % 10) + 1;
+        pushEdge(pool, u, v, weight);
+        return dynamicInsertEdge(sssp, u, v, weight, comparisonCount);
+    }
+    case OP_DECREASE: {
+        randomEdge(graph, pool, &u, &edge);
+        int weight = edge->weight > 1 ? (rand() % (edge->weight - 1)) + 1 : 1;
+        return dynamicUpdateWeight(sssp, u, edge->dest, weight, comparisonCount);
+    }
+    case OP_INCREASE: {
+        randomEdge(graph, pool, &u, &edge);
+        return dynamicUpdateWeight(sssp, u, edge->dest, edge->weight + (rand() % 10) + 1, comparisonCount);
+    }
+    case OP_DELETE: {
+        long i = randomEdge(graph, pool, &u, &edge);
+        pool->edges[i] = pool->edges[--pool->count];
+        return dynamicDeleteEdge(sssp, u, edge->dest, comparisonCount);
+    }
+    default: {
+        int visited = 0;
+        for (int i = 0; i < BATCH; ++i) {
+            visited += applyUpdate(sssp, pool, OP_INSERT, comparisonCount);
+        }
+        return visited;
+    }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int V = argc > 1 ? atoi(argv[1]) : 100000;
+    int E = argc > 2 ? atoi(argv[2]) : 5 * V;
+    int updates = argc > 3 ? atoi(argv[3]) : 2000;
+    int checks = argc > 4 ? atoi(argv[4]) : 20;
+    int batches = updates / 100 > 1 ? updates / 100 : 1;
+
+    // Fixed seed so that runs are repeatable
+    srand(1);
+
+    struct Graph* graph = createGraph(V);
+    generateRandomGraph(graph, E);
+    struct EdgeList pool;
+    collectEdges(graph, &pool);
+
+    int comparisonCount = 0;
+    double start = nowMicros();
+    struct DynamicSSSP* sssp = createDynamicSSSP(graph, 0, &comparisonCount);
+    printf("Initial solve: %.1f ms\n", (nowMicros() - start) / 1e3);
+
+    FILE* file = fopen("dynamic_results.csv", "w");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening file for writing.\n");
+        return 1;
+    }
+    fprintf(file, "Update,Operation,Visited,Comparisons,Latency (us)\n");
+
+    int counts[NUM_OPS] = {updates / 4, updates / 4, updates / 4, updates - 3 * (updates / 4), batches};
+    double* latency[NUM_OPS];
+    double visited[NUM_OPS] = {0};
+    int done[NUM_OPS] = {0};
+    for (int op = 0; op < NUM_OPS; ++op) {
+        latency[op] = (double*) malloc((counts[op] > 0 ? counts[op] : 1) * sizeof(double));
+    }
+
+    int total = updates + batches;
+    int checkEvery = checks > 0 && total / checks > 0 ? total / checks : total + 1;
+    int* expected = (int*) malloc(V * sizeof(int));
+    double fullLatency = 0;
+    int fullRuns = 0;
+    int mismatches = 0;
+
+    for (int i = 0; i < total; ++i) {
+        // Interleave the kinds so that every kind sees a graph shaped by all the others. Kinds
+        // that need an edge wait while there is none, and the run ends if only they are left.
+        int op = rand() % NUM_OPS;
+        int tried = 0;
+        while (tried < NUM_OPS && (done[op] == counts[op] || (pool.count == 0 && needsEdge(op)))) {
+            op = (op + 1) % NUM_OPS;
+            tried++;
+        }
+        if (tried == NUM_OPS) {
+            fprintf(stderr, "No edges left to update after %d updates, stopping.\n", i);
+            break;
+        }
+
+        comparisonCount = 0;
+        start = nowMicros();
+        int seen = applyUpdate(sssp, &pool, op, &comparisonCount);
+        double elapsed = nowMicros() - start;
+
+        latency[op][done[op]++] = elapsed;
+        visited[op] += seen;
+        fprintf(file, "%d,%s,%d,%d,%f\n", i, opNames[op], seen, comparisonCount, elapsed);
+
+        // Compare against a recomputation from scratch now and then
+        if ((i + 1) % checkEvery == 0) {
+            int baselineCount = 0;
+            start = nowMicros();
+            dijkstraDist(graph, sssp->src, expected, &baselineCount);
+            fullLatency += nowMicros() - start;
+            fullRuns++;
+
+            for (int v = 0; v < V; ++v) {
+                if (sssp->dist[v] != expected[v]) {
+                    fprintf(stderr, "Mismatch after update %d at vertex %d: %d, expected %d\n",
+                            i, v, sssp->dist[v], expected[v]);
+                    mismatches++;
+                    break;
+                }
+            }
+        }
+    }
+    fclose(file);
+
+    double full = fullRuns > 0 ? fullLatency / fullRuns : 0;
+    printf("Full recomputation: %.1f us on average over %d runs\n", full, fullRuns);
+    printf("%-14s %8s %10s %10s %10s %12s %10s\n", "update", "count", "mean (us)", "p50 (us)",
+           "p99 (us)", "avg visited", "speedup");
+    for (int op = 0; op < NUM_OPS; ++op) {
+        if (done[op] == 0) {
+            continue;
+        }
+        double sum = 0;
+        for (int i = 0; i < done[op]; ++i) {
+            sum += latency[op][i];
+        }
+        qsort(latency[op], done[op], sizeof(double), compareDoubles);
+        double mean = sum / done[op];
+        printf("%-14s %8d %10.1f %10.1f %10.1f %12.1f %9.1fx\n", opNames[op], done[op], mean,
+               percentile(latency[op], done[op], 50), percentile(latency[op], done[op], 99),
+               visited[op] / done[op], mean > 0 ? full / mean : 0);
+    }
+    printf("Results have been saved to dynamic_results.csv (%d mismatches)\n", mismatches);
+
+    for (int op = 0; op < NUM_OPS; ++op) {
+        free(latency[op]);
+    }
+    free(expected);
+    freeEdgeList(&pool);
+    freeDynamicSSSP(sssp);
+    freeGraph(graph);
+
+    return mismatches != 0;
+}
@@ -0,0 +1,187 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "engine.h"
+#include "dijkstra.h"
+#include "dijkstra_variants.h"
+#include "../../Project 1/src/sort.h"
+
+// Function to get the scratch of hybrid_merge_sort_r: the left run of the largest merge
+static int mergeScratch(int n) {
+    return n / 2 + 1;
+}
+
+// Function to get the sqrt(n) buffer of the low-memory merge sort
+static int sqrtScratch(int n) {
+    int size = 1;
+    while ((long) size * size < n) {
+        size++;
+    }
+    return size;
+}
+
+static long runHybrid(struct SortInput* input) {
+    long comparisons = 0;
+    hybrid_merge_sort_r(input->arr, 0, input->n - 1, input->threshold, input->scratch, &comparisons);
+    return comparisons;
+}
+
+// The Project 1 entry point, which allocates the two runs of every merge and counts into the
+// global key_comparisons
+static long runHybridGlobal(struct SortInput* input) {
+    key_comparisons = 0;
+    hybrid_merge_sort(input->arr, 0, input->n - 1, input->threshold);
+    return key_comparisons;
+}
+
+static long runHeap(struct SortInput* input) {
+    long comparisons = 0;
+    heap_sort_r(input->arr, input->n, &comparisons);
+    return comparisons;
+}
+
+static long runLowMemory(struct SortInput* input) {
+    long comparisons = 0;
+    hybrid_merge_sort_low_memory_r(input->arr, 0, input->n - 1, input->threshold, input->scratch,
+                                   input->scratchSize, &comparisons);
+    return comparisons;
+}
+
+static long runDijkstra(const struct SSSPInput* input, int* dist) {
+    int comparisonCount = 0;
+    dijkstraDist(input->graph, input->src, dist, &comparisonCount);
+    return comparisonCount;
+}
+
+static long runDijkstraCSR(const struct SSSPInput* input, int* dist) {
+    int comparisonCount = 0;
+    dijkstraCSR(input->csr, input->src, dist, &comparisonCount);
+    return comparisonCount;
+}
+
+static long runDijkstraDary(const struct SSSPInput* input, int* dist) {
+    int comparisonCount = 0;
+    dijkstraCSRDary(input->csr, input->src, dist, &comparisonCount);
+    return comparisonCount;
+}
+
+// Wrappers for the dijkstra_template.h specializations, which count into a long
+#define TEMPLATE_ENGINE(wrapper, function, graphField)                   \
+    static long wrapper(const struct SSSPInput* input, int* dist) {      \
+        long comparisons = 0;                                            \
+        function(input->graphField, input->src, dist, &comparisons);     \
+        return comparisons;                                              \
+    }
+
+TEMPLATE_ENGINE(runCSRQuadCounted, dijkstraCSRQuadCounted, csr)
+TEMPLATE_ENGINE(runCSRQuadFast, dijkstraCSRQuadFast, csr)
+TEMPLATE_ENGINE(runCSRBinaryCounted, dijkstraCSRBinaryCounted, csr)
+TEMPLATE_ENGINE(runCSRBinaryFast, dijkstraCSRBinaryFast, csr)
+TEMPLATE_ENGINE(runCSRLazyCounted, dijkstraCSRLazyCounted, csr)
+TEMPLATE_ENGINE(runCSRLazyFast, dijkstraCSRLazyFast, csr)
+TEMPLATE_ENGINE(runListQuadCounted, dijkstraListQuadCounted, graph)
+TEMPLATE_ENGINE(runListQuadFast, dijkstraListQuadFast, graph)
+
+// Wrappers for the unsigned distance specializations: the distances go to input->wideDist,
+// allocated before timing and narrowed after it. A graph whose weights do not fit the layout
+// (csr16 == NULL) fails the point with every distance unreachable.
+#define WIDTH_ENGINE(wrapper, function, graphField, type)                           \
+    static long wrapper(const struct SSSPInput* input, int* dist) {                 \
+        type* wide = (type*) input->wideDist;                                       \
+        if (input->graphField == NULL) {                                            \
+            memset(wide, 0xff, input->graph->V * sizeof(type));                     \
+            return -1;                                                              \
+        }                                                                           \
+        long comparisons = 0;                                                       \
+        function(input->graphField, input->src, wide, &comparisons);                \
+        return comparisons;                                                         \
+    }
+
+WIDTH_ENGINE(runCSR16Dist32Counted, dijkstraCSR16Dist32Counted, csr16, uint32_t)
+WIDTH_ENGINE(runCSR16Dist32Fast, dijkstraCSR16Dist32Fast, csr16, uint32_t)
+WIDTH_ENGINE(runCSRDist64Counted, dijkstraCSRDist64Counted, csr, uint64_t)
+WIDTH_ENGINE(runCSRDist64Fast, dijkstraCSRDist64Fast, csr, uint64_t)
+
+const struct Engine engines[] = {
+    {"hybrid", ENGINE_SORT, 1, 0, 0, "hybrid merge/insertion sort", mergeScratch, runHybrid, NULL},
+    {"hybrid-global", ENGINE_SORT, 1, 0, 0, "hybrid_merge_sort: temporaries per merge, global counter", NULL, runHybridGlobal, NULL},
+    {"heap", ENGINE_SORT, 0, 0, 0, "in-place 4-ary heap sort", NULL, runHeap, NULL},
+    {"lowmem", ENGINE_SORT, 1, 0, 0, "stable merge sort with a sqrt(n) buffer", sqrtScratch, runLowMemory, NULL},
+    {"dijkstra", ENGINE_SSSP, 0, 0, 0, "adjacency list with the binary min heap", NULL, NULL, runDijkstra},
+    {"dijkstra-csr", ENGINE_SSSP, 0, 1, 0, "CSR graph with the binary min heap", NULL, NULL, runDijkstraCSR},
+    {"dijkstra-4ary", ENGINE_SSSP, 0, 1, 0, "CSR graph with the 4-ary heap", NULL, NULL, runDijkstraDary},
+    {"tmpl-csr-4ary", ENGINE_SSSP, 0, 1, 0, "template: CSR, indexed 4-ary heap", NULL, NULL, runCSRQuadCounted},
+    {"tmpl-csr-4ary-fast", ENGINE_SSSP, 0, 1, 0, "template: CSR, indexed 4-ary heap, no counting", NULL, NULL, runCSRQuadFast},
+    {"tmpl-csr-2ary", ENGINE_SSSP, 0, 1, 0, "template: CSR, indexed binary heap", NULL, NULL, runCSRBinaryCounted},
+    {"tmpl-csr-2ary-fast", ENGINE_SSSP, 0, 1, 0, "template: CSR, indexed binary heap, no counting", NULL, NULL, runCSRBinaryFast},
+    {"tmpl-csr-lazy", ENGINE_SSSP, 0, 1, 0, "template: CSR, 4-ary heap without decrease-key", NULL, NULL, runCSRLazyCounted},
+    {"tmpl-csr-lazy-fast", ENGINE_SSSP, 0, 1, 0, "template: CSR, 4-ary heap without decrease-key, no counting", NULL, NULL, runCSRLazyFast},
+    {"tmpl-list-4ary", ENGINE_SSSP, 0, 0, 0, "template: adjacency list, indexed 4-ary heap", NULL, NULL, runListQuadCounted},
+    {"tmpl-list-4ary-fast", ENGINE_SSSP, 0, 0, 0, "template: adjacency list, indexed 4-ary heap, no counting", NULL, NULL, runListQuadFast},
+    {"tmpl-csr16-u32", ENGINE_SSSP, 0, 2, 4, "template: CSR, 16-bit weights, 32-bit distances", NULL, NULL, runCSR16Dist32Counted},
+    {"tmpl-csr16-u32-fast", ENGINE_SSSP, 0, 2, 4, "template: CSR, 16-bit weights, 32-bit distances, no counting", NULL, NULL, runCSR16Dist32Fast},
+    {"tmpl-csr-u64", ENGINE_SSSP, 0, 1, 8, "template: CSR, 64-bit distances", NULL, NULL, runCSRDist64Counted},
+    {"tmpl-csr-u64-fast", ENGINE_SSSP, 0, 1, 8, "template: CSR, 64-bit distances, no counting", NULL, NULL, runCSRDist64Fast},
+};
+const int numEngines = sizeof(engines) / sizeof(engines[0]);
+
+const struct Engine* findEngine(const char* name) {
+    for (int i = 0; i < numEngines; ++i) {
+        if (strcmp(engines[i].name, name) == 0) {
+            return &engines[i];
+        }
+    }
+    return NULL;
+}
+
+void narrowDistances(const struct Engine* engine, const struct SSSPInput* input, int* dist) {
+    if (engine->distSize == sizeof(uint32_t)) {
+        const uint32_t* wide = (const uint32_t*) input->wideDist;
+        for (int v = 0; v < input->graph->V; ++v) {
+            dist[v] = wide[v] < (uint32_t) INF ? (int) wide[v] : INF;
+        }
+    } else if (engine->distSize == sizeof(uint64_t)) {
+        const uint64_t* wide = (const uint64_t*) input->wideDist;
+        for (int v = 0; v < input->graph->V; ++v) {
+            dist[v] = wide[v] < (uint64_t) INF ? (int) wide[v] : INF;
+        }
+    }
+}
+
+const char* sortWorkloads[] = {"random", "sorted", "reversed", "few"};
+const int numSortWorkloads = sizeof(sortWorkloads) / sizeof(sortWorkloads[0]);
+
+int isSortWorkload(const char* name) {
+    for (int w = 0; w < numSortWorkloads; ++w) {
+        if (strcmp(sortWorkloads[w], name) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void generateSortInput(const char* workload, int* arr, int n, int maxValue, uint64_t seed) {
+    srand((unsigned) seed);
+    if (strcmp(workload, "sorted") == 0) {
+        for (int i = 0; i < n; i++) arr[i] = i;
+    } else if (strcmp(workload, "reversed") == 0) {
+        for (int i = 0; i < n; i++) arr[i] = n - i;
+    } else if (strcmp(workload, "few") == 0) {
+        for (int i = 0; i < n; i++) arr[i] = rand() % 16;
+    } else {
+        generate_random_array(arr, n, maxValue);
+    }
+}
+
+struct CSRGraph* graphToCSR(struct Graph* graph) {
+    struct EdgeList list;
+    initEdgeList(&list, 1024);
+    for (int u = 0; u < graph->V; ++u) {
+        for (struct Edge* e = graph->array[u].head; e != NULL; e = e->next) {
+            pushEdge(&list, u, e->dest, e->weight);
+        }
+    }
+    struct CSRGraph* csr = buildCSRGraph(graph->V, &list, 1, 1);
+    freeEdgeList(&list);
+    return csr;
+}
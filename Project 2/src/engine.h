@@ -0,0 +1,77 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+// Registry of the engines the sweep runner can benchmark. An engine is one entry in the
+// table in engine.c: a name, what it needs, and the function that does the timed work.
+// Everything around that call (generating the input, checking the output) is shared by the
+// engines of a family, so a new engine is its run function plus one registration line.
+
+#include <stdint.h>
+
+#include "graph.h"
+#include "csr.h"
+
+enum EngineFamily {
+    ENGINE_SORT,  // Sorts an int array, size = number of elements
+    ENGINE_SSSP   // Single source shortest paths, size = number of edges
+};
+
+// Input of a sorting engine. scratch holds scratchSize(n) ints, set up before timing starts.
+struct SortInput {
+    int* arr;
+    int n;
+    int threshold;
+    int* scratch;
+    int scratchSize;
+};
+
+// Input of a shortest path engine: the adjacency list graph, its CSR form if needsCSR, the
+// CSR form with 16-bit weights if needsCSR is 2 (NULL if the weights do not fit), and V
+// distances of distSize bytes each if the engine has one
+struct SSSPInput {
+    struct Graph* graph;
+    struct CSRGraph* csr;
+    int src;
+    struct CSRGraph16* csr16;
+    void* wideDist;
+};
+
+struct Engine {
+    const char* name;
+    enum EngineFamily family;
+    int usesThreshold;  // Takes the insertion sort threshold
+    int needsCSR;       // SSSP engines: set up input->csr (1), and input->csr16 (2) before timing
+    int distSize;       // SSSP engines: bytes per distance of input->wideDist, which sssp fills
+                        // instead of dist until narrowDistances(); 0 if it writes dist itself
+    const char* description;
+    // Function to get the scratch ints a sort of n elements needs, NULL for none
+    int (*scratchSize)(int n);
+    // Function to do the timed work, returns the number of key comparisons
+    long (*sort)(struct SortInput* input);
+    long (*sssp)(const struct SSSPInput* input, int* dist);
+};
+
+extern const struct Engine engines[];
+extern const int numEngines;
+
+// Function to look an engine up by name, returns NULL if there is none
+const struct Engine* findEngine(const char* name);
+
+// Function to copy input->wideDist to dist after an engine with a distSize has run, INF for
+// anything at or beyond it; nothing to do for the others
+void narrowDistances(const struct Engine* engine, const struct SSSPInput* input, int* dist);
+
+// Sorting workloads: random, sorted, reversed, few (16 distinct values)
+extern const char* sortWorkloads[];
+extern const int numSortWorkloads;
+
+// Function to check whether name is a sorting workload
+int isSortWorkload(const char* name);
+
+// Function to fill arr with n values of a sorting workload, from srand(seed)
+void generateSortInput(const char* workload, int* arr, int n, int maxValue, uint64_t seed);
+
+// Function to copy an adjacency list graph into CSR form
+struct CSRGraph* graphToCSR(struct Graph* graph);
+
+#endif
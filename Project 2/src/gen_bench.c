@@ -0,0 +1,70 @@
+// Build: gcc -O2 -o gen_bench gen_bench.c csr.c generator.c -lpthread -lm
+// Usage: ./gen_bench [V] [E] [threads] [directed] [seed]
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "csr.h"
+#include "generator.h"
+
+// Function to read a monotonic clock in seconds
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int compareInts(const void* a, const void* b) {
+    return *(const int*) a - *(const int*) b;
+}
+
+// Function to check that the graph has no self-loops or parallel edges
+static long countBadEdges(struct CSRGraph* csr) {
+    long bad = 0;
+    for (int u = 0; u < csr->V; ++u) {
+        int* row = csr->targets + csr->offsets[u];
+        long degree = csr->offsets[u + 1] - csr->offsets[u];
+        qsort(row, degree, sizeof(int), compareInts);
+        for (long i = 0; i < degree; ++i) {
+            if (row[i] == u || (i > 0 && row[i] == row[i - 1])) {
+                bad++;
+            }
+        }
+    }
+    return bad;
+}
+
+int main(int argc, char* argv[]) {
+    int V = argc > 1 ? atoi(argv[1]) : 1000000;
+    long E = argc > 2 ? atol(argv[2]) : 10L * V;
+    int threads = argc > 3 ? atoi(argv[3]) : defaultThreadCount();
+    int directed = argc > 4 ? atoi(argv[4]) : 1;
+    uint64_t seed = argc > 5 ? strtoull(argv[5], NULL, 10) : 1;
+
+    struct EdgeList* lists = (struct EdgeList*) malloc(threads * sizeof(struct EdgeList));
+
+    double start = nowSeconds();
+    if (generateGnm(V, E, directed, 10, seed, threads, lists) != 0) {
+        return 1;
+    }
+    double generated = nowSeconds();
+    struct CSRGraph* csr = buildCSRGraph(V, lists, threads, threads);
+    double built = nowSeconds();
+
+    printf("V=%d E=%ld threads=%d %s seed=%llu\n", V, E, threads,
+           directed ? "directed" : "undirected", (unsigned long long) seed);
+    printf("generate: %.3f s (%.1f M edges/s)\n", generated - start, E / (generated - start) / 1e6);
+    printf("CSR build: %.3f s (%.1f M edges/s)\n", built - generated, E / (built - generated) / 1e6);
+
+    long bad = countBadEdges(csr);
+    printf("edges=%ld self-loops/duplicates=%ld\n", csr->E, bad);
+
+    for (int t = 0; t < threads; ++t) {
+        freeEdgeList(&lists[t]);
+    }
+    free(lists);
+    int ok = csr->E == E && bad == 0;
+    freeCSRGraph(csr);
+
+    return !ok;
+}
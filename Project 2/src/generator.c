@@ -0,0 +1,236 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <pthread.h>
+
+#include "generator.h"
+#include "rng.h"
+
+// The work of one generator thread
+struct GnmJob {
+    int V;
+    int directed;
+    int maxWeight;
+    int mirror;            // Also store dest->src for every undirected edge
+    uint64_t seed;
+    uint64_t stream;
+    int firstSource;       // This thread samples the pairs whose source is in [firstSource, lastSource)
+    int lastSource;
+    double p;
+    struct EdgeList *list;
+    long base;             // Global index of the first edge in list, used when trimming
+    uint64_t *dropBits;    // Bit i set means global edge i is dropped
+};
+
+// Function to return the number of candidate destinations of source u
+static long rowLength(int V, int directed, int u) {
+    return directed ? V - 1 : V - 1 - u;
+}
+
+// Function to run fn on every job in its own thread and wait for all of them
+static void runJobs(struct GnmJob* jobs, int threads, void* (*fn)(void*)) {
+    pthread_t* tids = (pthread_t*) malloc(threads * sizeof(pthread_t));
+    for (int t = 0; t < threads; ++t) {
+        pthread_create(&tids[t], NULL, fn, &jobs[t]);
+    }
+    for (int t = 0; t < threads; ++t) {
+        pthread_join(tids[t], NULL);
+    }
+    free(tids);
+}
+
+// Function to sample G(n,p) over one slice of the pairs. Instead of flipping a coin
+// per pair, draw the geometric gap to the next chosen pair (Batagelj-Brandes).
+static void* sampleSlice(void* arg) {
+    struct GnmJob* job = (struct GnmJob*) arg;
+    struct EdgeList* list = job->list;
+    struct Rng rng;
+
+    rngSeed(&rng, job->seed, job->stream);
+    list->count = 0;
+    if (job->p <= 0.0) {
+        return NULL;
+    }
+
+    double logq = job->p < 1.0 ? log1p(-job->p) : 0.0;
+    int u = job->firstSource;
+    long r = -1;  // Position inside the row of u
+
+    while (u < job->lastSource) {
+        if (job->p < 1.0) {
+            double skip = floor(log1p(-rngDouble(&rng)) / logq);
+            if (skip > 4e18) {
+                break;
+            }
+            r += 1 + (long) skip;
+        } else {
+            r += 1;
+        }
+
+        while (u < job->lastSource && r >= rowLength(job->V, job->directed, u)) {
+            r -= rowLength(job->V, job->directed, u);
+            u++;
+        }
+        if (u >= job->lastSource) {
+            break;
+        }
+
+        // Map the row position to a destination, skipping the self-loop
+        int v = job->directed ? (int) (r < u ? r : r + 1) : (int) (u + 1 + r);
+        pushEdge(list, u, v, 1 + (int) rngBounded(&rng, job->maxWeight));
+    }
+    return NULL;
+}
+
+// Function to drop the marked edges from one list, then mirror it if asked
+static void* trimSlice(void* arg) {
+    struct GnmJob* job = (struct GnmJob*) arg;
+    struct EdgeList* list = job->list;
+    long kept = 0;
+
+    for (long e = 0; e < list->count; ++e) {
+        long global = job->base + e;
+        if (!(job->dropBits[global >> 6] >> (global & 63) & 1)) {
+            list->edges[kept++] = list->edges[e];
+        }
+    }
+    list->count = kept;
+
+    if (job->mirror) {
+        if (list->capacity < 2 * kept) {
+            list->capacity = 2 * kept;
+            list->edges = (struct EdgeRecord*) realloc(list->edges, list->capacity * sizeof(struct EdgeRecord));
+        }
+        for (long e = 0; e < kept; ++e) {
+            list->edges[kept + e].src = list->edges[e].dest;
+            list->edges[kept + e].dest = list->edges[e].src;
+            list->edges[kept + e].weight = list->edges[e].weight;
+        }
+        list->count = 2 * kept;
+    }
+    return NULL;
+}
+
+static int generateGnmLists(int V, long E, int directed, int maxWeight, uint64_t seed,
+                            int threads, struct EdgeList* lists, int mirror) {
+    double pairs = directed ? (double) V * (V - 1) : (double) V * (V - 1) / 2;
+    if (E > pairs) {
+        printf("E exceeds the maximum number of possible edges for the graph.\n");
+        return -1;
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    // Split the sources so that every thread gets about the same number of pairs
+    struct GnmJob* jobs = (struct GnmJob*) calloc(threads, sizeof(struct GnmJob));
+    int t = 0;
+    double seen = 0;
+    for (int u = 0; u < V && t < threads; ++u) {
+        while (t < threads && seen >= pairs * t / threads) {
+            jobs[t++].firstSource = u;
+        }
+        seen += rowLength(V, directed, u);
+    }
+    while (t < threads) {
+        jobs[t++].firstSource = V;
+    }
+
+    // Oversample by a few standard deviations so one attempt almost always suffices
+    double p = E == 0 ? 0.0 : fmin(1.0, (E + 4.0 * sqrt((double) E) + 16.0) / pairs);
+    for (t = 0; t < threads; ++t) {
+        struct GnmJob* job = &jobs[t];
+        job->V = V;
+        job->directed = directed;
+        job->maxWeight = maxWeight;
+        job->mirror = mirror;
+        job->seed = seed;
+        job->lastSource = t + 1 < threads ? jobs[t + 1].firstSource : V;
+        job->list = &lists[t];
+
+        double slicePairs = 0;
+        for (int u = job->firstSource; u < job->lastSource; ++u) {
+            slicePairs += rowLength(V, directed, u);
+        }
+        initEdgeList(&lists[t], (long) (p * slicePairs * 1.01) + 16);
+    }
+
+    long total = 0;
+    for (int attempt = 0; ; ++attempt) {
+        for (t = 0; t < threads; ++t) {
+            jobs[t].p = p;
+            jobs[t].stream = ((uint64_t) attempt << 32) | (uint64_t) t;
+        }
+        runJobs(jobs, threads, sampleSlice);
+
+        total = 0;
+        for (t = 0; t < threads; ++t) {
+            jobs[t].base = total;
+            total += lists[t].count;
+        }
+        if (total >= E) {
+            break;
+        }
+        p = fmin(1.0, p * 1.1);
+    }
+
+    // Conditioned on at least E edges, dropping a uniform subset of the surplus
+    // leaves a uniform G(n,m) sample
+    long words = (total + 63) / 64 + 1;
+    uint64_t* dropBits = (uint64_t*) calloc(words, sizeof(uint64_t));
+    struct Rng rng;
+    rngSeed(&rng, seed, UINT64_MAX);
+
+    long surplus = total - E;
+    int keepMode = surplus > total / 2;  // Cheaper to pick the edges to keep
+    long toPick = keepMode ? E : surplus;
+    if (keepMode) {
+        for (long w = 0; w < words; ++w) {
+            dropBits[w] = UINT64_MAX;
+        }
+    }
+    while (toPick > 0) {
+        long i = (long) rngBounded(&rng, total);
+        int isSet = dropBits[i >> 6] >> (i & 63) & 1;
+        if (isSet == keepMode) {
+            dropBits[i >> 6] ^= 1ULL << (i & 63);
+            toPick--;
+        }
+    }
+
+    for (t = 0; t < threads; ++t) {
+        jobs[t].dropBits = dropBits;
+    }
+    runJobs(jobs, threads, trimSlice);
+
+    free(dropBits);
+    free(jobs);
+    return 0;
+}
+
+// Function to generate a uniform random graph with exactly E distinct edges and no self-loops
+int generateGnm(int V, long E, int directed, int maxWeight, uint64_t seed,
+                int threads, struct EdgeList* lists) {
+    return generateGnmLists(V, E, directed, maxWeight, seed, threads, lists, 0);
+}
+
+// Function to generate a G(n,m) graph straight into CSR form
+struct CSRGraph* generateGnmCSR(int V, long E, int directed, int maxWeight, uint64_t seed, int threads) {
+    if (threads < 1) {
+        threads = 1;
+    }
+    struct EdgeList* lists = (struct EdgeList*) malloc(threads * sizeof(struct EdgeList));
+
+    // An undirected CSR needs both directions of every edge
+    if (generateGnmLists(V, E, directed, maxWeight, seed, threads, lists, !directed) != 0) {
+        free(lists);
+        return NULL;
+    }
+    struct CSRGraph* csr = buildCSRGraph(V, lists, threads, threads);
+
+    for (int t = 0; t < threads; ++t) {
+        freeEdgeList(&lists[t]);
+    }
+    free(lists);
+    return csr;
+}
@@ -0,0 +1,22 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <stdint.h>
+
+#include "csr.h"
+
+// Function to generate a uniform random graph with exactly E distinct edges and no
+// self-loops (Erdos-Renyi G(n,m)) with weights in [1, maxWeight].
+// Each of the `threads` workers skip-samples a G(n,p) over its own slice of the
+// vertex pairs, with p chosen so that at least E edges come out; a bitset then drops
+// the surplus uniformly. Undirected graphs store each pair once with src < dest.
+// The edges are left in lists[0 .. threads), one list per worker, and are the same
+// for the same (V, E, directed, maxWeight, seed, threads).
+// Returns 0 on success, -1 if E is larger than the number of possible edges.
+int generateGnm(int V, long E, int directed, int maxWeight, uint64_t seed,
+                int threads, struct EdgeList* lists);
+
+// Function to generate a G(n,m) graph straight into CSR form
+struct CSRGraph* generateGnmCSR(int V, long E, int directed, int maxWeight, uint64_t seed, int threads);
+
+#endif
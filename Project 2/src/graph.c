@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "graph.h"
+#include "csr.h"
+
+// Function to create a graph with V vertices
+struct Graph* createGraph(int V) {
+    struct Graph* graph = (struct Graph*) malloc(sizeof(struct Graph));
+    graph->V = V;
+    graph->array = (struct AdjList*) malloc(V * sizeof(struct AdjList));
+    for (int i = 0; i < V; ++i) {
+        graph->array[i].head = NULL;
+    }
+    arenaInit(&graph->edges, 64 * 1024);
+    return graph;
+}
+
+// Function to add an edge to the graph
+void addEdge(struct Graph* graph, int src, int dest, int weight) {
+    struct Edge* newEdge = (struct Edge*) arenaAlloc(&graph->edges, sizeof(struct Edge));
+    newEdge->dest = dest;
+    newEdge->weight = weight;
+    newEdge->next = graph->array[src].head;
+    graph->array[src].head = newEdge;
+}
+
+// Function to find an edge src->dest, with the given weight unless weight is negative
+struct Edge* findEdge(struct Graph* graph, int src, int dest, int weight) {
+    struct Edge* pCrawl = graph->array[src].head;
+    while (pCrawl != NULL) {
+        if (pCrawl->dest == dest && (weight < 0 || pCrawl->weight == weight)) {
+            return pCrawl;
+        }
+        pCrawl = pCrawl->next;
+    }
+    return NULL;
+}
+
+// Function to unlink an edge src->dest and return its weight, or -1 if there is none
+int removeEdge(struct Graph* graph, int src, int dest, int weight) {
+    struct Edge** link = &graph->array[src].head;
+    while (*link != NULL) {
+        struct Edge* edge = *link;
+        if (edge->dest == dest && (weight < 0 || edge->weight == weight)) {
+            *link = edge->next;
+            return edge->weight;
+        }
+        link = &edge->next;
+    }
+    return -1;
+}
+
+// Function to build the reverse graph (every edge u->v becomes v->u)
+struct Graph* reverseGraph(struct Graph* graph) {
+    struct Graph* reverse = createGraph(graph->V);
+
+    for (int u = 0; u < graph->V; ++u) {
+        struct Edge* pCrawl = graph->array[u].head;
+        while (pCrawl != NULL) {
+            addEdge(reverse, pCrawl->dest, u, pCrawl->weight);
+            pCrawl = pCrawl->next;
+        }
+    }
+    return reverse;
+}
+
+// Function to free the graph and all of its edges
+void freeGraph(struct Graph* graph) {
+    arenaFree(&graph->edges);
+    free(graph->array);
+    free(graph);
+}
+
+// Function to generate a random graph with E edges
+void generateRandomGraph(struct Graph* graph, int E) {
+    int V = graph->V;
+
+    for (int i = 0; i < E; ++i) {
+        int u = rand() % V;
+        int v = rand() % V;
+        int weight = (rand() % 10) + 1;
+
+        if (u != v) {
+            addEdge(graph, u, v, weight);
+        }
+    }
+}
+
+// Function to convert a CSR graph into the adjacency list struct Graph used by dijkstra()
+struct Graph* csrToGraph(struct CSRGraph* csr) {
+    struct Graph* graph = createGraph(csr->V);
+
+    for (int u = 0; u < csr->V; ++u) {
+        // addEdge() prepends, so walk the row backwards to keep the CSR order
+        for (long i = csr->offsets[u + 1] - 1; i >= csr->offsets[u]; --i) {
+            addEdge(graph, u, csr->targets[i], csr->weights[i]);
+        }
+    }
+    return graph;
+}
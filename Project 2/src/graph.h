@@ -0,0 +1,53 @@
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include "arena.h"
+
+struct CSRGraph;
+
+#define INF 9999999  // Define a large value to represent infinity
+
+// A structure to represent an edge in the adjacency list
+struct Edge {
+    int dest;
+    int weight;
+    struct Edge *next;
+};
+
+// A structure to represent a graph using an adjacency list
+struct AdjList {
+    struct Edge *head;
+};
+
+struct Graph {
+    int V;  // Number of vertices
+    struct AdjList *array;
+    struct Arena edges;  // Backing store for every Edge, released in one go by freeGraph()
+};
+
+// Function to create a graph with V vertices
+struct Graph* createGraph(int V);
+
+// Function to add an edge to the graph
+void addEdge(struct Graph* graph, int src, int dest, int weight);
+
+// Function to find an edge src->dest, with the given weight unless weight is negative
+struct Edge* findEdge(struct Graph* graph, int src, int dest, int weight);
+
+// Function to unlink an edge src->dest (with the given weight unless negative) and return
+// its weight, or -1 if there is none. The edge's memory stays in the arena until freeGraph().
+int removeEdge(struct Graph* graph, int src, int dest, int weight);
+
+// Function to build the reverse graph (every edge u->v becomes v->u)
+struct Graph* reverseGraph(struct Graph* graph);
+
+// Function to free the graph and all of its edges
+void freeGraph(struct Graph* graph);
+
+// Function to generate a random graph with E edges, seed rand() once with srand() beforehand
+void generateRandomGraph(struct Graph* graph, int E);
+
+// Function to convert a CSR graph into an adjacency list graph
+struct Graph* csrToGraph(struct CSRGraph* csr);
+
+#endif
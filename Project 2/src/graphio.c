@@ -0,0 +1,477 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "graphio.h"
+
+// The offsets section is mapped directly onto the long offsets of struct CSRGraph
+_Static_assert(sizeof(long) == sizeof(int64_t), "graph files need a 64-bit long");
+// Edge streams are mapped directly onto arrays of struct EdgeRecord
+_Static_assert(sizeof(struct EdgeRecord) == 3 * sizeof(int32_t), "edge records must be packed");
+
+// Function to round a file position up to the section alignment
+static uint64_t alignUp(uint64_t pos) {
+    return (pos + GRAPH_FILE_ALIGN - 1) / GRAPH_FILE_ALIGN * GRAPH_FILE_ALIGN;
+}
+
+// Function to write zero bytes from pos up to target
+static int writePadding(FILE* file, uint64_t pos, uint64_t target) {
+    static const char zeros[GRAPH_FILE_ALIGN] = {0};
+    return fwrite(zeros, 1, target - pos, file) == target - pos;
+}
+
+// Function to write a CSR graph in the binary format, returns 0 on success
+int writeGraphFile(const char* filename, struct CSRGraph* csr) {
+    struct GraphFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GRAPH_FILE_MAGIC, 4);
+    header.version = GRAPH_FILE_VERSION;
+    header.headerSize = sizeof(header);
+    header.V = csr->V;
+    header.E = csr->E;
+    header.offsetsPos = alignUp(sizeof(header));
+    header.targetsPos = alignUp(header.offsetsPos + (header.V + 1) * sizeof(int64_t));
+    header.weightsPos = alignUp(header.targetsPos + header.E * sizeof(int32_t));
+
+    FILE* file = fopen(filename, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening %s for writing.\n", filename);
+        return -1;
+    }
+
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1
+          && writePadding(file, sizeof(header), header.offsetsPos)
+          && fwrite(csr->offsets, sizeof(int64_t), csr->V + 1, file) == (size_t) csr->V + 1
+          && writePadding(file, header.offsetsPos + (header.V + 1) * sizeof(int64_t), header.targetsPos)
+          && fwrite(csr->targets, sizeof(int32_t), csr->E, file) == (size_t) csr->E
+          && writePadding(file, header.targetsPos + header.E * sizeof(int32_t), header.weightsPos)
+          && fwrite(csr->weights, sizeof(int32_t), csr->E, file) == (size_t) csr->E;
+
+    if (fclose(file) != 0 || !ok) {
+        fprintf(stderr, "Error writing %s.\n", filename);
+        return -1;
+    }
+    return 0;
+}
+
+// Function to check that a section of count items of size bytes lies inside the file
+static int sectionFits(uint64_t pos, uint64_t count, uint64_t size, uint64_t length) {
+    return pos % GRAPH_FILE_ALIGN == 0 && pos <= length && count <= (length - pos) / size;
+}
+
+// Function to mmap a binary graph file without copying it, returns NULL on failure
+struct MappedGraph* mapGraphFile(const char* filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error opening %s for reading.\n", filename);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uint64_t) st.st_size < sizeof(struct GraphFileHeader)) {
+        fprintf(stderr, "%s is too small to be a graph file.\n", filename);
+        close(fd);
+        return NULL;
+    }
+
+    // A private writable mapping: pages are shared with the page cache until a caller writes
+    size_t length = (size_t) st.st_size;
+    void* base = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Error mapping %s.\n", filename);
+        return NULL;
+    }
+
+    struct GraphFileHeader* header = (struct GraphFileHeader*) base;
+    const char* problem = NULL;
+    if (memcmp(header->magic, GRAPH_FILE_MAGIC, 4) != 0) {
+        problem = "is not a graph file";
+    } else if (header->version != GRAPH_FILE_VERSION || header->headerSize < sizeof(struct GraphFileHeader)) {
+        problem = "has an unsupported version";
+    } else if (header->V >= INT_MAX
+               || !sectionFits(header->offsetsPos, header->V + 1, sizeof(int64_t), length)
+               || !sectionFits(header->targetsPos, header->E, sizeof(int32_t), length)
+               || !sectionFits(header->weightsPos, header->E, sizeof(int32_t), length)) {
+        problem = "has sections outside the file";
+    }
+
+    struct MappedGraph* mapped = NULL;
+    if (problem == NULL) {
+        mapped = (struct MappedGraph*) malloc(sizeof(struct MappedGraph));
+        mapped->base = base;
+        mapped->length = length;
+        mapped->csr.V = (int) header->V;
+        mapped->csr.E = (long) header->E;
+        mapped->csr.offsets = (long*) ((char*) base + header->offsetsPos);
+        mapped->csr.targets = (int*) ((char*) base + header->targetsPos);
+        mapped->csr.weights = (int*) ((char*) base + header->weightsPos);
+
+        if (mapped->csr.offsets[0] != 0 || mapped->csr.offsets[mapped->csr.V] != mapped->csr.E) {
+            problem = "has offsets that do not match its edge count";
+            free(mapped);
+            mapped = NULL;
+        }
+    }
+
+    if (problem != NULL) {
+        fprintf(stderr, "%s %s.\n", filename, problem);
+        munmap(base, length);
+    }
+    return mapped;
+}
+
+// Function to unmap a graph returned by mapGraphFile()
+void unmapGraphFile(struct MappedGraph* mapped) {
+    munmap(mapped->base, mapped->length);
+    free(mapped);
+}
+
+// Function to check that offsets are non-decreasing, targets are in range and weights lie in
+// 0 .. GRAPH_MAX_WEIGHT, returns 0 if valid
+int validateCSRGraph(struct CSRGraph* csr) {
+    if (csr->offsets[0] != 0 || csr->offsets[csr->V] != csr->E) {
+        return -1;
+    }
+    for (int v = 0; v < csr->V; ++v) {
+        if (csr->offsets[v + 1] < csr->offsets[v]) {
+            return -1;
+        }
+    }
+    for (long e = 0; e < csr->E; ++e) {
+        if (csr->targets[e] < 0 || csr->targets[e] >= csr->V || csr->weights[e] < 0 ||
+            csr->weights[e] > GRAPH_MAX_WEIGHT) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Function to write the edges of several lists as one edge stream file
+int writeEdgeStream(const char* filename, struct EdgeList* lists, int numLists) {
+    FILE* file = fopen(filename, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening %s for writing.\n", filename);
+        return -1;
+    }
+
+    int ok = 1;
+    for (int i = 0; i < numLists && ok; ++i) {
+        ok = fwrite(lists[i].edges, sizeof(struct EdgeRecord), lists[i].count, file) == (size_t) lists[i].count;
+    }
+
+    if (fclose(file) != 0 || !ok) {
+        fprintf(stderr, "Error writing %s.\n", filename);
+        return -1;
+    }
+    return 0;
+}
+
+// One thread's slice of a mapped edge stream, and what a scan of it found
+struct StreamSlice {
+    struct EdgeList *list;
+    long maxId;
+    long bad;  // Edges with a negative id or a weight outside 0 .. GRAPH_MAX_WEIGHT
+};
+
+static void* scanSlice(void* arg) {
+    struct StreamSlice* slice = (struct StreamSlice*) arg;
+    long maxId = -1, bad = 0;
+    for (long i = 0; i < slice->list->count; ++i) {
+        const struct EdgeRecord* edge = &slice->list->edges[i];
+        bad += edge->src < 0 || edge->dest < 0 || edge->weight < 0 || edge->weight > GRAPH_MAX_WEIGHT;
+        maxId = edge->src > maxId ? edge->src : maxId;
+        maxId = edge->dest > maxId ? edge->dest : maxId;
+    }
+    slice->maxId = maxId;
+    slice->bad = bad;
+    return NULL;
+}
+
+// Function to build a CSR graph straight from an edge stream file
+struct CSRGraph* readEdgeStreamGraph(const char* filename, int flags, int threads) {
+    int fd = open(filename, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        fprintf(stderr, "Error opening %s for reading.\n", filename);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return NULL;
+    }
+    if (st.st_size % sizeof(struct EdgeRecord) != 0) {
+        fprintf(stderr, "%s is not a whole number of edges.\n", filename);
+        close(fd);
+        return NULL;
+    }
+
+    size_t length = (size_t) st.st_size;
+    long E = (long) (length / sizeof(struct EdgeRecord));
+    struct EdgeRecord* edges = NULL;
+    if (length > 0) {
+        void* base = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base == MAP_FAILED) {
+            fprintf(stderr, "Error mapping %s.\n", filename);
+            close(fd);
+            return NULL;
+        }
+        edges = (struct EdgeRecord*) base;
+        madvise(base, length, MADV_SEQUENTIAL);
+    }
+    close(fd);
+
+    // Zero-copy views: slice t is edges [E t / threads, E (t+1) / threads)
+    threads = threads > 0 ? threads : 1;
+    struct EdgeList* lists = (struct EdgeList*) malloc(threads * sizeof(struct EdgeList));
+    struct StreamSlice* slices = (struct StreamSlice*) malloc(threads * sizeof(struct StreamSlice));
+    pthread_t* workers = (pthread_t*) malloc(threads * sizeof(pthread_t));
+    for (int t = 0; t < threads; ++t) {
+        long first = E * t / threads, last = E * (t + 1) / threads;
+        lists[t].count = last - first;
+        lists[t].capacity = last - first;
+        lists[t].edges = edges + first;
+        slices[t].list = &lists[t];
+        pthread_create(&workers[t], NULL, scanSlice, &slices[t]);
+    }
+
+    long maxId = -1, bad = 0;
+    for (int t = 0; t < threads; ++t) {
+        pthread_join(workers[t], NULL);
+        maxId = slices[t].maxId > maxId ? slices[t].maxId : maxId;
+        bad += slices[t].bad;
+    }
+
+    struct CSRGraph* csr = NULL;
+    if (bad > 0) {
+        fprintf(stderr, "%s has %ld edges with a negative id or a weight out of range.\n", filename, bad);
+    } else if (maxId >= INT_MAX) {
+        fprintf(stderr, "%s has vertex ids out of range.\n", filename);
+    } else {
+        csr = buildCSRGraph((int) (maxId + 1), lists, threads, threads);
+        if (flags != 0) {
+            normalizeCSRGraph(csr, flags, threads);
+        }
+    }
+
+    if (length > 0) {
+        munmap(edges, length);
+    }
+    free(workers);
+    free(slices);
+    free(lists);
+    return csr;
+}
+
+// A text file mapped for parsing
+struct TextFile {
+    const char *data;
+    const char *end;
+    size_t length;
+};
+
+static int openTextFile(const char* filename, struct TextFile* text) {
+    int fd = open(filename, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        fprintf(stderr, "Error opening %s for reading.\n", filename);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+
+    text->length = (size_t) st.st_size;
+    text->data = "";
+    if (text->length > 0) {
+        void* base = mmap(NULL, text->length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base == MAP_FAILED) {
+            fprintf(stderr, "Error mapping %s.\n", filename);
+            close(fd);
+            return -1;
+        }
+        text->data = (const char*) base;
+    }
+    text->end = text->data + text->length;
+    close(fd);
+    return 0;
+}
+
+static void closeTextFile(struct TextFile* text) {
+    if (text->length > 0) {
+        munmap((void*) text->data, text->length);
+    }
+}
+
+// Function to parse the next integer on the current line, returns 0 if there is none. A number
+// that does not fit a long sets *overflow and reads as LONG_MAX.
+static int parseLong(const char** p, const char* end, long* out, int* overflow) {
+    const char* s = *p;
+    while (s < end && (*s == ' ' || *s == '\t' || *s == '\r')) {
+        s++;
+    }
+
+    int negative = 0;
+    if (s < end && *s == '-') {
+        negative = 1;
+        s++;
+    }
+    if (s >= end || *s < '0' || *s > '9') {
+        return 0;
+    }
+
+    long value = 0;
+    while (s < end && *s >= '0' && *s <= '9') {
+        int digit = *s - '0';
+        if (value > (LONG_MAX - digit) / 10) {
+            *overflow = 1;
+            value = LONG_MAX;
+        } else {
+            value = value * 10 + digit;
+        }
+        s++;
+    }
+    *out = negative ? -value : value;
+    *p = s;
+    return 1;
+}
+
+static const char* nextLine(const char* p, const char* end) {
+    const char* newline = memchr(p, '\n', end - p);
+    return newline ? newline + 1 : end;
+}
+
+// Function to read a DIMACS shortest path file
+struct CSRGraph* readDimacsGraph(const char* filename, int threads) {
+    struct TextFile text;
+    if (openTextFile(filename, &text) != 0) {
+        return NULL;
+    }
+
+    struct EdgeList list = {0, 0, NULL};
+    long V = -1;
+    long lineNumber = 0;
+    const char* error = NULL;
+
+    for (const char* p = text.data; p < text.end && error == NULL; p = nextLine(p, text.end)) {
+        lineNumber++;
+        if (*p == 'p') {
+            const char* s = p + 1;
+            while (s < text.end && (*s == ' ' || *s == '\t')) {
+                s++;
+            }
+            if (text.end - s < 2 || s[0] != 's' || s[1] != 'p') {
+                error = "expected 'p sp <n> <m>'";
+                continue;
+            }
+            s += 2;
+
+            // m only sizes the list up front, capped by what the file could hold (a line is
+            // at least "a 1 2 3\n"); the list grows if it was too small
+            long m;
+            int overflow = 0;
+            if (V >= 0) {
+                error = "second problem line";
+            } else if (!parseLong(&s, text.end, &V, &overflow) || !parseLong(&s, text.end, &m, &overflow)) {
+                error = "bad problem line";
+            } else if (overflow || V < 0 || V >= INT_MAX || m < 0) {
+                error = "number out of range";
+            } else if (initEdgeList(&list, m < text.length / 8 + 16 ? m : text.length / 8 + 16) != 0) {
+                error = "out of memory";
+            }
+        } else if (*p == 'a') {
+            const char* s = p + 1;
+            long u, v, w;
+            int overflow = 0;
+            if (V < 0) {
+                error = "arc before the problem line";
+            } else if (!parseLong(&s, text.end, &u, &overflow) || !parseLong(&s, text.end, &v, &overflow)
+                       || !parseLong(&s, text.end, &w, &overflow)) {
+                error = "expected 'a <u> <v> <w>'";
+            } else if (overflow) {
+                error = "number out of range";
+            } else if (u < 1 || u > V || v < 1 || v > V || w < 0 || w > GRAPH_MAX_WEIGHT) {
+                error = "arc out of range";
+            } else if (pushEdge(&list, (int) u - 1, (int) v - 1, (int) w) != 0) {
+                error = "out of memory";
+            }
+        }
+        // 'c' comment lines and blank lines are skipped
+    }
+    closeTextFile(&text);
+
+    if (error == NULL && V < 0) {
+        error = "no problem line";
+        lineNumber = 0;
+    }
+    if (error != NULL) {
+        fprintf(stderr, "%s:%ld: %s.\n", filename, lineNumber, error);
+        freeEdgeList(&list);
+        return NULL;
+    }
+
+    struct CSRGraph* csr = buildCSRGraph((int) V, &list, 1, threads);
+    freeEdgeList(&list);
+    return csr;
+}
+
+// Function to read an edge list text file
+struct CSRGraph* readEdgeListGraph(const char* filename, int threads) {
+    struct TextFile text;
+    if (openTextFile(filename, &text) != 0) {
+        return NULL;
+    }
+
+    struct EdgeList list;
+    if (initEdgeList(&list, text.length / 8 + 16) != 0) {
+        fprintf(stderr, "Out of memory reading %s.\n", filename);
+        closeTextFile(&text);
+        return NULL;
+    }
+    long maxId = -1;
+    long lineNumber = 0;
+    const char* error = NULL;
+
+    for (const char* p = text.data; p < text.end && error == NULL; p = nextLine(p, text.end)) {
+        lineNumber++;
+        const char* s = p;
+        long u, v, w = 1;
+        int overflow = 0;
+        if (!parseLong(&s, text.end, &u, &overflow)) {
+            // Blank or comment line ('#' or '%')
+            continue;
+        }
+        if (!parseLong(&s, text.end, &v, &overflow)) {
+            error = "expected '<u> <v> [w]'";
+            continue;
+        }
+        parseLong(&s, text.end, &w, &overflow);
+
+        if (overflow) {
+            error = "number out of range";
+        } else if (u < 0 || v < 0 || u >= INT_MAX || v >= INT_MAX || w < 0 || w > GRAPH_MAX_WEIGHT) {
+            error = "edge out of range";
+        } else if (pushEdge(&list, (int) u, (int) v, (int) w) != 0) {
+            error = "out of memory";
+        } else {
+            maxId = u > maxId ? u : maxId;
+            maxId = v > maxId ? v : maxId;
+        }
+    }
+    closeTextFile(&text);
+
+    if (error != NULL) {
+        fprintf(stderr, "%s:%ld: %s.\n", filename, lineNumber, error);
+        freeEdgeList(&list);
+        return NULL;
+    }
+
+    struct CSRGraph* csr = buildCSRGraph((int) (maxId + 1), &list, 1, threads);
+    freeEdgeList(&list);
+    return csr;
+}
@@ -0,0 +1,74 @@
+#ifndef GRAPHIO_H
+#define GRAPHIO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "csr.h"
+#include "graph.h"
+
+#define GRAPH_FILE_MAGIC "SCGR"
+#define GRAPH_FILE_VERSION 1
+#define GRAPH_FILE_ALIGN 64  // Every section starts on a cache line (and page-friendly) boundary
+#define GRAPH_MAX_WEIGHT (INF - 1)  // Heaviest edge the readers accept: one edge must stay below INF
+
+// The on-disk CSR layout, all fields little-endian:
+//   header (64 bytes) | offsets: (V + 1) x int64 | targets: E x int32 | weights: E x int32
+// Each section starts at a multiple of GRAPH_FILE_ALIGN, given by its *Pos field.
+struct GraphFileHeader {
+    char magic[4];        // "SCGR"
+    uint32_t version;     // GRAPH_FILE_VERSION
+    uint32_t headerSize;  // sizeof(struct GraphFileHeader), lets later versions grow it
+    uint32_t flags;       // Reserved, 0
+    uint64_t V;
+    uint64_t E;
+    uint64_t offsetsPos;
+    uint64_t targetsPos;
+    uint64_t weightsPos;
+    uint64_t reserved;
+};
+
+// A graph file mapped into memory. csr's arrays point straight into the mapping.
+struct MappedGraph {
+    struct CSRGraph csr;
+    void *base;
+    size_t length;
+};
+
+// Function to write a CSR graph in the binary format, returns 0 on success
+int writeGraphFile(const char* filename, struct CSRGraph* csr);
+
+// Function to mmap a binary graph file without copying it, returns NULL on failure.
+// Only the header and section bounds are checked; see validateCSRGraph() for the rest.
+struct MappedGraph* mapGraphFile(const char* filename);
+
+// Function to unmap a graph returned by mapGraphFile()
+void unmapGraphFile(struct MappedGraph* mapped);
+
+// Function to check that offsets are non-decreasing, targets are in range and weights lie in
+// 0 .. GRAPH_MAX_WEIGHT, returns 0 if valid
+int validateCSRGraph(struct CSRGraph* csr);
+
+// An edge stream file is a bare array of struct EdgeRecord: (src, dest, weight) as little-endian
+// int32 triples in any order, no header. Ids are 0-based and V is the largest id plus one;
+// weights lie in 0 .. GRAPH_MAX_WEIGHT.
+
+// Function to write the edges of several lists as one edge stream file, returns 0 on success
+int writeEdgeStream(const char* filename, struct EdgeList* lists, int numLists);
+
+// Function to build a CSR graph straight from an edge stream file: the mapping is cut into one
+// slice per thread and handed to buildCSRGraph() without copying, then the rows are normalized
+// with flags (CSR_SORT_ROWS, ...; 0 keeps file order). Returns NULL on a bad file.
+struct CSRGraph* readEdgeStreamGraph(const char* filename, int flags, int threads);
+
+// The text readers reject weights above GRAPH_MAX_WEIGHT. Paths may still add up past INF:
+// search imported graphs with 64-bit distances (dijkstraCSRDist64*) to get them exactly.
+
+// Function to read a DIMACS shortest path file (.gr: "p sp n m" and "a u v w" lines, 1-based ids)
+struct CSRGraph* readDimacsGraph(const char* filename, int threads);
+
+// Function to read an edge list text file ("u v [w]" per line, 0-based ids, '#' or '%' comments,
+// missing weights default to 1)
+struct CSRGraph* readEdgeListGraph(const char* filename, int threads);
+
+#endif
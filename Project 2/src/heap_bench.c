@@ -0,0 +1,116 @@
+// Build: gcc -O2 -o heap_bench heap_bench.c minheap.c dheap.c trace.c dijkstra.c csr.c generator.c graph.c arena.c -lpthread -lm
+// Usage: ./heap_bench [V] [E] [sources] [repetitions]
+// Records the heap operations of real Dijkstra runs, then replays them on struct MinHeap
+// (binary, array of node pointers) and struct DaryHeap (4-ary, parallel key/id arrays).
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "csr.h"
+#include "dijkstra.h"
+#include "generator.h"
+#include "trace.h"
+
+// Function to read a monotonic clock in seconds
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    int V = argc > 1 ? atoi(argv[1]) : 1000000;
+    long E = argc > 2 ? atol(argv[2]) : 4L * V;
+    int sources = argc > 3 ? atoi(argv[3]) : 3;
+    int repetitions = argc > 4 ? atoi(argv[4]) : 3;
+
+    struct CSRGraph* csr = generateGnmCSR(V, E, 1, 10, 1, defaultThreadCount());
+    if (csr == NULL) {
+        return 1;
+    }
+
+    // Capture the operation sequences, timing both engines end to end on the way
+    struct Trace trace;
+    initTrace(&trace);
+    int* dist = (int*) malloc(V * sizeof(int));
+    int* check = (int*) malloc(V * sizeof(int));
+    double binaryDijkstra = 0, daryDijkstra = 0;
+    int mismatches = 0;
+
+    for (int s = 0; s < sources; ++s) {
+        int src = (int) ((long) s * V / sources);
+        int comparisonCount = 0;
+        setDijkstraTrace(&trace);
+        dijkstraCSRDary(csr, src, check, &comparisonCount);
+        setDijkstraTrace(NULL);
+
+        double start = nowSeconds();
+        dijkstraCSR(csr, src, dist, &comparisonCount);
+        binaryDijkstra += nowSeconds() - start;
+
+        start = nowSeconds();
+        dijkstraCSRDary(csr, src, check, &comparisonCount);
+        daryDijkstra += nowSeconds() - start;
+
+        for (int v = 0; v < V; ++v) {
+            if (dist[v] != check[v]) {
+                fprintf(stderr, "Mismatch from source %d at vertex %d\n", src, v);
+                mismatches++;
+                break;
+            }
+        }
+    }
+
+    long counts[4] = {0, 0, 0, 0};
+    for (long i = 0; i < trace.count; ++i) {
+        counts[trace.ops[i].type]++;
+    }
+    printf("Captured %ld operations from %d runs: %ld push, %ld decrease-key, %ld extract-min\n",
+           trace.count, sources, counts[TRACE_PUSH], counts[TRACE_DECREASE], counts[TRACE_POP]);
+
+    FILE* file = fopen("heap_results.csv", "w");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening file for writing.\n");
+        return 1;
+    }
+    fprintf(file, "Heap,Operations,Seconds,ns/op,Comparisons,Dijkstra Seconds\n");
+    printf("%-8s %12s %10s %14s %16s\n", "heap", "seconds", "ns/op", "comparisons", "dijkstra (s)");
+
+    unsigned long checksum[2];
+    long badPops = 0;
+    for (int heap = 0; heap < 2; ++heap) {
+        const struct PQBackend* backend = findPQBackend(heap == 0 ? "binary" : "4ary");
+        double best = 0;
+        int comparisonCount = 0;
+
+        // Best of several replays, to keep page faults of the first pass out of the result
+        for (int r = 0; r < repetitions; ++r) {
+            comparisonCount = 0;
+            double start = nowSeconds();
+            checksum[heap] = replayTrace(&trace, backend, &comparisonCount, &badPops);
+            double elapsed = nowSeconds() - start;
+            if (r == 0 || elapsed < best) {
+                best = elapsed;
+            }
+        }
+
+        double dijkstraSeconds = (heap == 0 ? binaryDijkstra : daryDijkstra) / sources;
+        printf("%-8s %12.3f %10.1f %14d %16.3f\n", backend->name, best, best * 1e9 / trace.count,
+               comparisonCount, dijkstraSeconds);
+        fprintf(file, "%s,%ld,%f,%f,%d,%f\n", backend->name, trace.count, best, best * 1e9 / trace.count,
+                comparisonCount, dijkstraSeconds);
+    }
+    fclose(file);
+
+    if (checksum[0] != checksum[1] || badPops != 0) {
+        fprintf(stderr, "The two heaps popped different key sequences\n");
+        mismatches++;
+    }
+    printf("Results have been saved to heap_results.csv (%d mismatches)\n", mismatches);
+
+    freeTrace(&trace);
+    free(dist);
+    free(check);
+    freeCSRGraph(csr);
+    return mismatches != 0;
+}
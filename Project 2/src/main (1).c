@@ -1,16 +1,20 @@
+// Build: gcc -O2 -o main "main (1).c" csr.c generator.c -lpthread -lm
 #include <stdio.h>
 #include <limits.h>
 #include <stdlib.h>
-#include <time.h>
+#include <stdint.h>
 
-#define INF 99999  // Define infinity as a large value
+#include "generator.h"
+#include "distance.h"
+
+#define INF INT_MAX  // Infinity; longer paths saturate to it (distance.h)
 
 // Global variable to keep track of key comparisons
 int key_comparisons = 0;
 
 // Function to find the vertex with the minimum distance that is not yet processed
 int minDistance(int dist[], int visited[], int V) {
-    int min = INF, min_index;
+    int min = INF, min_index = -1;  // Some vertex is always unvisited when this is called
 
     for (int v = 0; v < V; v++) {
         key_comparisons++;  // Count this comparison
@@ -50,8 +54,8 @@ void dijkstra(int **graph, int V, int src) {
             key_comparisons++;
             // Update dist[v] only if it's not visited, there is an edge from u to v,
             // and the total weight of the path from src to v through u is smaller than the current value of dist[v]
-            if (!visited[v] && graph[u][v] && dist[u] != INF && dist[u] + graph[u][v] < dist[v]) {
-                dist[v] = dist[u] + graph[u][v];
+            if (!visited[v] && graph[u][v] && dist[u] != INF && addDistInt(dist[u], graph[u][v], INF) < dist[v]) {
+                dist[v] = addDistInt(dist[u], graph[u][v], INF);
             }
         }
     }
@@ -66,25 +70,20 @@ void generateRandomGraph(int **graph, int V, int E) {
         }
     }
 
-    int edges_added = 0;
-    srand(time(0));  // Seed for random number generation
-
-    // Keep adding edges until we have exactly E edges
-    while (edges_added < E) {
-        int u = rand() % V;  // Random vertex u
-        int v = rand() % V;  // Random vertex v
-
-        // Ensure that we don't add an edge between the same vertex and that the edge doesn't already exist
-        if (u != v && graph[u][v] == 0) {
-            int weight = (rand() % 10) + 1;  // Generate a random weight between 1 and 10
-            graph[u][v] = weight;
-            graph[v][u] = weight;  // For undirected graphs, mirror the edge
-
-            edges_added++;
-        }
+    // Sample E distinct undirected pairs directly rather than rejection-sampling
+    // on the matrix, which slows down badly as E approaches V(V-1)/2
+    struct EdgeList pairs;
+    if (generateGnm(V, E, 0, 10, (uint64_t) E, 1, &pairs) != 0) {
+        return;
     }
 
-
+    for (long i = 0; i < pairs.count; i++) {
+        int u = pairs.edges[i].src;
+        int v = pairs.edges[i].dest;
+        graph[u][v] = pairs.edges[i].weight;
+        graph[v][u] = pairs.edges[i].weight;  // For undirected graphs, mirror the edge
+    }
+    freeEdgeList(&pairs);
 }
 
 // Function to write results to CSV
@@ -0,0 +1,201 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "memprofile.h"
+
+// The wrappers need glibc's own entry points, and must stay out of the way of sanitizers
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define MEMPROFILE_WRAPPERS 0
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || __has_feature(memory_sanitizer)
+#define MEMPROFILE_WRAPPERS 0
+#endif
+#endif
+#if !defined(MEMPROFILE_WRAPPERS) && defined(__GLIBC__)
+#define MEMPROFILE_WRAPPERS 1
+#endif
+#ifndef MEMPROFILE_WRAPPERS
+#define MEMPROFILE_WRAPPERS 0
+#endif
+
+// Counters, updated with relaxed atomics: the workload generators allocate from threads
+static long allocations, frees, bytes, largest, sizeClasses[ALLOC_SIZE_CLASSES];
+static long live;      // Usable bytes of the blocks live now
+static long peak;      // Most live bytes since the reset
+static long baseline;  // Live bytes at the reset
+
+#if MEMPROFILE_WRAPPERS
+
+#include <malloc.h>
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* block, size_t size);
+extern void* __libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void* block);
+
+static int sizeClass(size_t size) {
+    int c = 0;
+    while (c < ALLOC_SIZE_CLASSES - 1 && ((size_t) 1 << c) < size) {
+        c++;
+    }
+    return c;
+}
+
+static void raiseTo(long* value, long candidate) {
+    long current = __atomic_load_n(value, __ATOMIC_RELAXED);
+    while (candidate > current &&
+           !__atomic_compare_exchange_n(value, &current, candidate, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+// Function to count a block handed out for a request of size bytes
+static void countAllocation(void* block, size_t size) {
+    if (block == NULL) {
+        return;
+    }
+    __atomic_fetch_add(&allocations, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&bytes, (long) size, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&sizeClasses[sizeClass(size)], 1, __ATOMIC_RELAXED);
+    raiseTo(&largest, (long) size);
+    raiseTo(&peak, __atomic_add_fetch(&live, (long) malloc_usable_size(block), __ATOMIC_RELAXED));
+}
+
+// Function to count a block given back, usable bytes long
+static void countRelease(long usable) {
+    __atomic_fetch_add(&frees, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_sub(&live, usable, __ATOMIC_RELAXED);
+}
+
+void* malloc(size_t size) {
+    void* block = __libc_malloc(size);
+    countAllocation(block, size);
+    return block;
+}
+
+void* calloc(size_t count, size_t size) {
+    void* block = __libc_calloc(count, size);
+    countAllocation(block, count * size);
+    return block;
+}
+
+void* realloc(void* old, size_t size) {
+    long oldUsable = old != NULL ? (long) malloc_usable_size(old) : 0;
+    void* block = __libc_realloc(old, size);
+    // On failure the old block stays; realloc(p, 0) frees it
+    if (old != NULL && (block != NULL || size == 0)) {
+        countRelease(oldUsable);
+    }
+    countAllocation(block, size);
+    return block;
+}
+
+void free(void* block) {
+    if (block != NULL) {
+        countRelease((long) malloc_usable_size(block));
+    }
+    __libc_free(block);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    void* block = __libc_memalign(alignment, size);
+    countAllocation(block, size);
+    return block;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** result, size_t alignment, size_t size) {
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    void* block = memalign(alignment, size);
+    if (block == NULL) {
+        return ENOMEM;
+    }
+    *result = block;
+    return 0;
+}
+
+void* valloc(size_t size) {
+    return memalign((size_t) sysconf(_SC_PAGESIZE), size);
+}
+
+void* pvalloc(size_t size) {
+    size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    return memalign(page, (size + page - 1) / page * page);
+}
+
+#endif
+
+int allocStatsEnabled(void) {
+    return MEMPROFILE_WRAPPERS;
+}
+
+void resetAllocStats(void) {
+    __atomic_store_n(&allocations, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&frees, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&bytes, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&largest, 0, __ATOMIC_RELAXED);
+    for (int c = 0; c < ALLOC_SIZE_CLASSES; ++c) {
+        __atomic_store_n(&sizeClasses[c], 0, __ATOMIC_RELAXED);
+    }
+    long now = __atomic_load_n(&live, __ATOMIC_RELAXED);
+    __atomic_store_n(&baseline, now, __ATOMIC_RELAXED);
+    __atomic_store_n(&peak, now, __ATOMIC_RELAXED);
+}
+
+void readAllocStats(struct AllocStats* stats) {
+    stats->allocations = __atomic_load_n(&allocations, __ATOMIC_RELAXED);
+    stats->frees = __atomic_load_n(&frees, __ATOMIC_RELAXED);
+    stats->bytes = __atomic_load_n(&bytes, __ATOMIC_RELAXED);
+    stats->largest = __atomic_load_n(&largest, __ATOMIC_RELAXED);
+    stats->peakBytes = __atomic_load_n(&peak, __ATOMIC_RELAXED) - __atomic_load_n(&baseline, __ATOMIC_RELAXED);
+    for (int c = 0; c < ALLOC_SIZE_CLASSES; ++c) {
+        stats->sizeClasses[c] = __atomic_load_n(&sizeClasses[c], __ATOMIC_RELAXED);
+    }
+}
+
+void formatSizeClasses(const struct AllocStats* stats, char* text, size_t length) {
+    size_t used = 0;
+    text[0] = '\0';
+    for (int c = 0; c < ALLOC_SIZE_CLASSES && used < length; ++c) {
+        if (stats->sizeClasses[c] > 0) {
+            int n = snprintf(text + used, length - used, "%s%d:%ld", used > 0 ? " " : "", c, stats->sizeClasses[c]);
+            used += n > 0 ? (size_t) n : 0;
+        }
+    }
+}
+
+int resetPeakRSS(void) {
+    int fd = open("/proc/self/clear_refs", O_WRONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    int ok = write(fd, "5", 1) == 1;
+    close(fd);
+    return ok ? 0 : -1;
+}
+
+long readPeakRSS(void) {
+    // fopen would allocate, which is fine: the caller reads the allocation counters first
+    FILE* status = fopen("/proc/self/status", "r");
+    if (status == NULL) {
+        return -1;
+    }
+    char line[256];
+    long kb = -1;
+    while (fgets(line, sizeof(line), status) != NULL) {
+        if (sscanf(line, "VmHWM: %ld kB", &kb) == 1) {
+            break;
+        }
+    }
+    fclose(status);
+    return kb;
+}
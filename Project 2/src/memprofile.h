@@ -0,0 +1,45 @@
+#ifndef MEMPROFILE_H
+#define MEMPROFILE_H
+
+// Memory profiling for the benchmark drivers: allocation statistics and the peak resident set.
+//
+// memprofile.c replaces malloc, calloc, realloc, free and the aligned allocators of the program
+// it is linked into with counting wrappers around glibc's allocator, so every allocation is
+// seen, also those made inside libraries. Link it into benchmark programs only. Without glibc,
+// and in sanitizer builds (whose runtimes bring their own allocator), the wrappers are left out
+// and allocStatsEnabled() returns 0.
+
+#include <stddef.h>
+
+#define ALLOC_SIZE_CLASSES 40  // Size class c counts requests of 2^(c-1) < size <= 2^c bytes
+
+struct AllocStats {
+    long allocations;  // Calls that returned memory; a realloc counts as one
+    long frees;        // Blocks given back, by free or by a realloc that moved them
+    long bytes;        // Bytes requested by those calls
+    long peakBytes;    // Most bytes live at once, above those live at the reset
+    long largest;      // Largest single request
+    long sizeClasses[ALLOC_SIZE_CLASSES];
+};
+
+// Function to tell whether the allocation wrappers are in this program
+int allocStatsEnabled(void);
+
+// Function to start a new measurement: zero the counters, peak from the bytes live now
+void resetAllocStats(void);
+
+// Function to read the counters since the last reset
+void readAllocStats(struct AllocStats* stats);
+
+// Function to write the nonzero size classes as "class:count" pairs, e.g. "5:1000 17:2"
+void formatSizeClasses(const struct AllocStats* stats, char* text, size_t length);
+
+// Function to reset the peak resident set size of this process (Linux 4.0 and later),
+// returns 0 on success
+int resetPeakRSS(void);
+
+// Function to read the peak resident set size in kB since the last reset (or since the
+// start), -1 if it cannot be read
+long readPeakRSS(void);
+
+#endif
@@ -0,0 +1,136 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "minheap.h"
+
+// Function to create a new min-heap node
+struct MinHeapNode* newMinHeapNode(int v, int dist) {
+    struct MinHeapNode* minHeapNode = (struct MinHeapNode*) malloc(sizeof(struct MinHeapNode));
+    minHeapNode->v = v;
+    minHeapNode->dist = dist;
+    return minHeapNode;
+}
+
+// Function to create a new min-heap node inside an arena, freed together with the arena
+struct MinHeapNode* arenaMinHeapNode(struct Arena* arena, int v, int dist) {
+    struct MinHeapNode* minHeapNode = (struct MinHeapNode*) arenaAlloc(arena, sizeof(struct MinHeapNode));
+    minHeapNode->v = v;
+    minHeapNode->dist = dist;
+    return minHeapNode;
+}
+
+// Function to create a min-heap
+struct MinHeap* createMinHeap(int capacity) {
+    struct MinHeap* minHeap = (struct MinHeap*) malloc(sizeof(struct MinHeap));
+    minHeap->pos = (int *) malloc(capacity * sizeof(int));
+    minHeap->size = 0;
+    minHeap->capacity = capacity;
+    minHeap->array = (struct MinHeapNode**) malloc(capacity * sizeof(struct MinHeapNode*));
+    return minHeap;
+}
+
+// Function to free the heap arrays (the nodes themselves belong to the caller)
+void freeMinHeap(struct MinHeap* minHeap) {
+    free(minHeap->pos);
+    free(minHeap->array);
+    free(minHeap);
+}
+
+// Function to swap two nodes of the heap
+void swapMinHeapNode(struct MinHeapNode** a, struct MinHeapNode** b) {
+    struct MinHeapNode* temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+// Heapify at index i
+void minHeapify(struct MinHeap* minHeap, int idx, int* comparisonCount) {
+    int smallest, left, right;
+    smallest = idx;
+    left = 2 * idx + 1;
+    right = 2 * idx + 2;
+
+    (*comparisonCount)++;
+    if (left < minHeap->size && minHeap->array[left]->dist < minHeap->array[smallest]->dist) {
+        smallest = left;
+    }
+
+    (*comparisonCount)++;
+    if (right < minHeap->size && minHeap->array[right]->dist < minHeap->array[smallest]->dist) {
+        smallest = right;
+    }
+
+    if (smallest != idx) {
+        struct MinHeapNode* smallestNode = minHeap->array[smallest];
+        struct MinHeapNode* idxNode = minHeap->array[idx];
+
+        // Swap positions
+        minHeap->pos[smallestNode->v] = idx;
+        minHeap->pos[idxNode->v] = smallest;
+
+        // Swap nodes
+        swapMinHeapNode(&minHeap->array[smallest], &minHeap->array[idx]);
+
+        // Recursively heapify the affected sub-tree
+        minHeapify(minHeap, smallest, comparisonCount);
+    }
+}
+
+// Extract the node with the minimum distance
+struct MinHeapNode* extractMin(struct MinHeap* minHeap, int* comparisonCount) {
+    if (minHeap->size == 0) {
+        return NULL;
+    }
+
+    // Store the root node
+    struct MinHeapNode* root = minHeap->array[0];
+
+    // Replace root with the last node
+    struct MinHeapNode* lastNode = minHeap->array[minHeap->size - 1];
+    minHeap->array[0] = lastNode;
+
+    // Update positions
+    minHeap->pos[root->v] = minHeap->size - 1;
+    minHeap->pos[lastNode->v] = 0;
+
+    // Reduce heap size and heapify the root
+    minHeap->size--;
+    minHeapify(minHeap, 0, comparisonCount);
+
+    return root;
+}
+
+// Function to decrease distance value of a vertex
+void decreaseKey(struct MinHeap* minHeap, int v, int dist, int* comparisonCount) {
+    int i = minHeap->pos[v];
+    minHeap->array[i]->dist = dist;
+
+    // Move up while min-heap property is violated
+    while (i && minHeap->array[i]->dist < minHeap->array[(i - 1) / 2]->dist) {
+        (*comparisonCount)++;
+        // Swap node with its parent
+        minHeap->pos[minHeap->array[i]->v] = (i - 1) / 2;
+        minHeap->pos[minHeap->array[(i - 1) / 2]->v] = i;
+        swapMinHeapNode(&minHeap->array[i], &minHeap->array[(i - 1) / 2]);
+
+        i = (i - 1) / 2;
+    }
+}
+
+// Function to insert a node at the bottom of the heap and sift it up
+void insertMinHeap(struct MinHeap* minHeap, struct MinHeapNode* node, int* comparisonCount) {
+    minHeap->array[minHeap->size] = node;
+    minHeap->pos[node->v] = minHeap->size;
+    minHeap->size++;
+
+    // Sifting up is the same walk as a decrease-key to the node's own distance
+    decreaseKey(minHeap, node->v, node->dist, comparisonCount);
+}
+
+// Function to check if a given vertex is in min-heap or not
+int isInMinHeap(struct MinHeap* minHeap, int v) {
+    if (minHeap->pos[v] < minHeap->size) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+#ifndef MINHEAP_H
+#define MINHEAP_H
+
+#include "arena.h"
+
+// A structure to represent a min-heap node
+struct MinHeapNode {
+    int v;
+    int dist;
+};
+
+// A structure to represent a min-heap
+struct MinHeap {
+    int size;
+    int capacity;
+    int *pos;  // To track positions of nodes in the heap
+    struct MinHeapNode **array;
+};
+
+// Function to create a new min-heap node
+struct MinHeapNode* newMinHeapNode(int v, int dist);
+
+// Function to create a new min-heap node inside an arena, freed together with the arena
+struct MinHeapNode* arenaMinHeapNode(struct Arena* arena, int v, int dist);
+
+// Function to create a min-heap
+struct MinHeap* createMinHeap(int capacity);
+
+// Function to free the heap arrays (the nodes themselves belong to the caller)
+void freeMinHeap(struct MinHeap* minHeap);
+
+// Function to swap two nodes of the heap
+void swapMinHeapNode(struct MinHeapNode** a, struct MinHeapNode** b);
+
+// Heapify at index i
+void minHeapify(struct MinHeap* minHeap, int idx, int* comparisonCount);
+
+// Extract the node with the minimum distance
+struct MinHeapNode* extractMin(struct MinHeap* minHeap, int* comparisonCount);
+
+// Function to decrease distance value of a vertex
+void decreaseKey(struct MinHeap* minHeap, int v, int dist, int* comparisonCount);
+
+// Function to insert a node at the bottom of the heap and sift it up
+void insertMinHeap(struct MinHeap* minHeap, struct MinHeapNode* node, int* comparisonCount);
+
+// Function to check if a given vertex is in min-heap or not
+int isInMinHeap(struct MinHeap* minHeap, int v);
+
+#endif
@@ -0,0 +1,289 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "p2p.h"
+#include "minheap.h"
+#include "dijkstra.h"
+#include "distance.h"
+
+// Vertex states during a point-to-point search
+#define UNREACHED 0
+#define IN_HEAP 1
+#define SETTLED 2
+
+// The state of one search direction
+struct SearchSpace {
+    int *dist;
+    int *state;
+    struct MinHeapNode *nodes;  // nodes[v] is the heap node of vertex v, so pushes never malloc
+    struct MinHeap *minHeap;
+};
+
+// Function to create a search space with every vertex unreached
+static struct SearchSpace* createSearchSpace(int V) {
+    struct SearchSpace* s = (struct SearchSpace*) malloc(sizeof(struct SearchSpace));
+    s->dist = (int*) malloc(V * sizeof(int));
+    s->state = (int*) malloc(V * sizeof(int));
+    s->nodes = (struct MinHeapNode*) malloc(V * sizeof(struct MinHeapNode));
+    s->minHeap = createMinHeap(V);
+
+    for (int v = 0; v < V; ++v) {
+        s->dist[v] = INF;
+        s->state[v] = UNREACHED;
+    }
+    return s;
+}
+
+static void freeSearchSpace(struct SearchSpace* s) {
+    free(s->dist);
+    free(s->state);
+    free(s->nodes);
+    freeMinHeap(s->minHeap);
+    free(s);
+}
+
+// Function to insert v with the given key, or lower its key if it is already queued
+static void pushVertex(struct SearchSpace* s, int v, int key, int* comparisonCount) {
+    if (s->state[v] == IN_HEAP) {
+        decreaseKey(s->minHeap, v, key, comparisonCount);
+        return;
+    }
+    s->nodes[v].v = v;
+    s->nodes[v].dist = key;
+    s->state[v] = IN_HEAP;
+    insertMinHeap(s->minHeap, &s->nodes[v], comparisonCount);
+}
+
+// Function to pop the vertex with the smallest key and mark it settled
+static int popVertex(struct SearchSpace* s, int* settled, int* comparisonCount) {
+    int u = extractMin(s->minHeap, comparisonCount)->v;
+    s->state[u] = SETTLED;
+    (*settled)++;
+    return u;
+}
+
+// Unidirectional Dijkstra from src that stops as soon as target is settled
+int dijkstraTo(struct Graph* graph, int src, int target, int* settled, int* comparisonCount) {
+    struct SearchSpace* s = createSearchSpace(graph->V);
+
+    s->dist[src] = 0;
+    pushVertex(s, src, 0, comparisonCount);
+
+    while (s->minHeap->size > 0) {
+        int u = popVertex(s, settled, comparisonCount);
+        if (u == target) {
+            break;
+        }
+
+        struct Edge* pCrawl = graph->array[u].head;
+        while (pCrawl != NULL) {
+            int v = pCrawl->dest;
+
+            // Relax the edge
+            (*comparisonCount)++;
+            if (s->state[v] != SETTLED && addDistInt(s->dist[u], pCrawl->weight, INF) < s->dist[v]) {
+                s->dist[v] = addDistInt(s->dist[u], pCrawl->weight, INF);
+                pushVertex(s, v, s->dist[v], comparisonCount);
+            }
+            pCrawl = pCrawl->next;
+        }
+    }
+
+    int result = s->dist[target];
+    freeSearchSpace(s);
+    return result;
+}
+
+// Bidirectional Dijkstra: forward search on graph, backward search on its reverse
+int bidirectionalDijkstra(struct Graph* graph, struct Graph* reverse, int src, int target,
+                          int* settled, int* comparisonCount) {
+    if (src == target) {
+        (*settled)++;
+        return 0;
+    }
+
+    struct SearchSpace* forward = createSearchSpace(graph->V);
+    struct SearchSpace* backward = createSearchSpace(graph->V);
+    int best = INF;  // Length of the shortest s-t path seen so far
+
+    forward->dist[src] = 0;
+    pushVertex(forward, src, 0, comparisonCount);
+    backward->dist[target] = 0;
+    pushVertex(backward, target, 0, comparisonCount);
+
+    while (forward->minHeap->size > 0 && backward->minHeap->size > 0) {
+        int topForward = forward->minHeap->array[0]->dist;
+        int topBackward = backward->minHeap->array[0]->dist;
+
+        // No unsettled vertex can lie on a path shorter than best any more
+        (*comparisonCount)++;
+        if (topForward + topBackward >= best) {
+            break;
+        }
+
+        // Expand the side whose frontier is closer
+        struct SearchSpace* side = forward;
+        struct SearchSpace* other = backward;
+        struct Graph* sideGraph = graph;
+        if (topBackward < topForward) {
+            side = backward;
+            other = forward;
+            sideGraph = reverse;
+        }
+
+        int u = popVertex(side, settled, comparisonCount);
+
+        struct Edge* pCrawl = sideGraph->array[u].head;
+        while (pCrawl != NULL) {
+            int v = pCrawl->dest;
+            int candidate = addDistInt(side->dist[u], pCrawl->weight, INF);
+
+            // Relax the edge
+            (*comparisonCount)++;
+            if (side->state[v] != SETTLED && candidate < side->dist[v]) {
+                side->dist[v] = candidate;
+                pushVertex(side, v, candidate, comparisonCount);
+            }
+
+            // Check whether the two searches meet through this edge
+            if (other->dist[v] != INF && addDistInt(candidate, other->dist[v], INF) < best) {
+                best = addDistInt(candidate, other->dist[v], INF);
+            }
+            pCrawl = pCrawl->next;
+        }
+    }
+
+    freeSearchSpace(forward);
+    freeSearchSpace(backward);
+    return best;
+}
+
+// A* search from src to target ordered by dist + h(v)
+int aStar(struct Graph* graph, int src, int target, Heuristic h, void* ctx,
+          int* settled, int* comparisonCount) {
+    int V = graph->V;
+    struct SearchSpace* s = createSearchSpace(V);
+
+    // Cache of h(v), -1 until first computed
+    int* hval = (int*) malloc(V * sizeof(int));
+    for (int v = 0; v < V; ++v) {
+        hval[v] = -1;
+    }
+
+    hval[src] = h(src, target, ctx);
+    s->dist[src] = 0;
+    pushVertex(s, src, hval[src], comparisonCount);
+
+    while (s->minHeap->size > 0) {
+        int u = popVertex(s, settled, comparisonCount);
+        if (u == target) {
+            break;
+        }
+
+        struct Edge* pCrawl = graph->array[u].head;
+        while (pCrawl != NULL) {
+            int v = pCrawl->dest;
+
+            // Relax the edge. A settled vertex is reopened if a shorter path turns up,
+            // so an admissible but inconsistent heuristic still gives exact answers.
+            (*comparisonCount)++;
+            if (addDistInt(s->dist[u], pCrawl->weight, INF) < s->dist[v]) {
+                s->dist[v] = addDistInt(s->dist[u], pCrawl->weight, INF);
+                if (hval[v] < 0) {
+                    hval[v] = h(v, target, ctx);
+                }
+                if (s->state[v] == SETTLED) {
+                    s->state[v] = UNREACHED;
+                }
+                pushVertex(s, v, s->dist[v] + hval[v], comparisonCount);
+            }
+            pCrawl = pCrawl->next;
+        }
+    }
+
+    int result = s->dist[target];
+    free(hval);
+    freeSearchSpace(s);
+    return result;
+}
+
+// Heuristic that always returns 0, which turns aStar() into plain Dijkstra
+int zeroHeuristic(int v, int target, void* ctx) {
+    (void) v;
+    (void) target;
+    (void) ctx;
+    return 0;
+}
+
+// Function to pick k landmarks by farthest selection and precompute their distances
+struct Landmarks* createLandmarks(struct Graph* graph, struct Graph* reverse, int k, int* comparisonCount) {
+    int V = graph->V;
+    struct Landmarks* landmarks = (struct Landmarks*) malloc(sizeof(struct Landmarks));
+    landmarks->k = k;
+    landmarks->V = V;
+    landmarks->landmark = (int*) malloc(k * sizeof(int));
+    landmarks->fromL = (int**) malloc(k * sizeof(int*));
+    landmarks->toL = (int**) malloc(k * sizeof(int*));
+
+    // minDist[v] is the distance from the closest landmark chosen so far
+    int* minDist = (int*) malloc(V * sizeof(int));
+    dijkstraDist(graph, 0, minDist, comparisonCount);
+
+    for (int i = 0; i < k; ++i) {
+        // The next landmark is the reachable vertex farthest from all current ones
+        int next = 0;
+        for (int v = 0; v < V; ++v) {
+            if (minDist[v] != INF && minDist[v] > minDist[next]) {
+                next = v;
+            }
+        }
+        landmarks->landmark[i] = next;
+
+        landmarks->fromL[i] = (int*) malloc(V * sizeof(int));
+        landmarks->toL[i] = (int*) malloc(V * sizeof(int));
+        dijkstraDist(graph, next, landmarks->fromL[i], comparisonCount);
+        dijkstraDist(reverse, next, landmarks->toL[i], comparisonCount);
+
+        for (int v = 0; v < V; ++v) {
+            if (i == 0 || landmarks->fromL[i][v] < minDist[v]) {
+                minDist[v] = landmarks->fromL[i][v];
+            }
+        }
+    }
+
+    free(minDist);
+    return landmarks;
+}
+
+// ALT heuristic, ctx must point to a struct Landmarks
+int altHeuristic(int v, int target, void* ctx) {
+    struct Landmarks* landmarks = (struct Landmarks*) ctx;
+    int best = 0;
+
+    for (int i = 0; i < landmarks->k; ++i) {
+        int* fromL = landmarks->fromL[i];
+        int* toL = landmarks->toL[i];
+
+        // dist(L,t) <= dist(L,v) + dist(v,t)
+        if (fromL[v] != INF && fromL[target] != INF && fromL[target] - fromL[v] > best) {
+            best = fromL[target] - fromL[v];
+        }
+        // dist(v,L) <= dist(v,t) + dist(t,L)
+        if (toL[v] != INF && toL[target] != INF && toL[v] - toL[target] > best) {
+            best = toL[v] - toL[target];
+        }
+    }
+    return best;
+}
+
+// Function to free the landmark tables
+void freeLandmarks(struct Landmarks* landmarks) {
+    for (int i = 0; i < landmarks->k; ++i) {
+        free(landmarks->fromL[i]);
+        free(landmarks->toL[i]);
+    }
+    free(landmarks->landmark);
+    free(landmarks->fromL);
+    free(landmarks->toL);
+    free(landmarks);
+}
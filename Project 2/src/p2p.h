@@ -0,0 +1,42 @@
+#ifndef P2P_H
+#define P2P_H
+
+#include "graph.h"
+
+// A heuristic returns a lower bound on the distance from v to target.
+// It must be admissible (never overestimate) for aStar() to return shortest distances.
+typedef int (*Heuristic)(int v, int target, void* ctx);
+
+// ALT landmarks: distances from and to k landmark vertices, used for triangle-inequality bounds
+struct Landmarks {
+    int k;          // Number of landmarks
+    int V;          // Number of vertices in the graph
+    int *landmark;  // landmark[i] is the vertex id of landmark i
+    int **fromL;    // fromL[i][v] = dist(landmark[i], v)
+    int **toL;      // toL[i][v] = dist(v, landmark[i])
+};
+
+// Unidirectional Dijkstra from src that stops as soon as target is settled
+int dijkstraTo(struct Graph* graph, int src, int target, int* settled, int* comparisonCount);
+
+// Bidirectional Dijkstra: forward search on graph, backward search on its reverse
+int bidirectionalDijkstra(struct Graph* graph, struct Graph* reverse, int src, int target,
+                          int* settled, int* comparisonCount);
+
+// A* search from src to target ordered by dist + h(v)
+int aStar(struct Graph* graph, int src, int target, Heuristic h, void* ctx,
+          int* settled, int* comparisonCount);
+
+// Heuristic that always returns 0, which turns aStar() into plain Dijkstra
+int zeroHeuristic(int v, int target, void* ctx);
+
+// Function to pick k landmarks by farthest selection and precompute their distances
+struct Landmarks* createLandmarks(struct Graph* graph, struct Graph* reverse, int k, int* comparisonCount);
+
+// ALT heuristic, ctx must point to a struct Landmarks
+int altHeuristic(int v, int target, void* ctx);
+
+// Function to free the landmark tables
+void freeLandmarks(struct Landmarks* landmarks);
+
+#endif
@@ -0,0 +1,121 @@
+// Build: gcc -O2 -o p2p_bench p2p_bench.c graph.c arena.c minheap.c dheap.c trace.c dijkstra.c p2p.c
+// Usage: ./p2p_bench [V] [E] [queries] [landmarks]
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "graph.h"
+#include "dijkstra.h"
+#include "p2p.h"
+
+#define NUM_ENGINES 5
+
+static const char* engineNames[NUM_ENGINES] = {
+    "dijkstra", "dijkstraTo", "bidirectional", "astar_zero", "astar_alt"
+};
+
+// Function to read a monotonic clock in microseconds
+static double nowMicros(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// Function to run one engine for an s-t query and return the distance found
+static int runQuery(int engine, struct Graph* graph, struct Graph* reverse, struct Landmarks* landmarks,
+                    int src, int target, int* settled, int* comparisonCount) {
+    switch (engine) {
+    case 0: {
+        // The baseline: full single-source Dijkstra always settles every vertex
+        int* dist = (int*) malloc(graph->V * sizeof(int));
+        dijkstraDist(graph, src, dist, comparisonCount);
+        int result = dist[target];
+        *settled = graph->V;
+        free(dist);
+        return result;
+    }
+    case 1:
+        return dijkstraTo(graph, src, target, settled, comparisonCount);
+    case 2:
+        return bidirectionalDijkstra(graph, reverse, src, target, settled, comparisonCount);
+    case 3:
+        return aStar(graph, src, target, zeroHeuristic, NULL, settled, comparisonCount);
+    default:
+        return aStar(graph, src, target, altHeuristic, landmarks, settled, comparisonCount);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int V = argc > 1 ? atoi(argv[1]) : 100000;
+    int E = argc > 2 ? atoi(argv[2]) : 5 * V;
+    int queries = argc > 3 ? atoi(argv[3]) : 100;
+    int k = argc > 4 ? atoi(argv[4]) : 8;
+
+    // Fixed seed so that runs are repeatable
+    srand(1);
+
+    struct Graph* graph = createGraph(V);
+    generateRandomGraph(graph, E);
+    struct Graph* reverse = reverseGraph(graph);
+
+    int comparisonCount = 0;
+    double start = nowMicros();
+    struct Landmarks* landmarks = createLandmarks(graph, reverse, k, &comparisonCount);
+    printf("ALT preprocessing: %d landmarks in %.1f ms\n", k, (nowMicros() - start) / 1e3);
+
+    FILE* file = fopen("p2p_results.csv", "w");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening file for writing.\n");
+        return 1;
+    }
+    fprintf(file, "Query,Source,Target,Engine,Distance,Settled,Comparisons,Latency (us)\n");
+
+    double totalSettled[NUM_ENGINES] = {0};
+    double totalLatency[NUM_ENGINES] = {0};
+    int mismatches = 0;
+
+    for (int q = 0; q < queries; ++q) {
+        int src = rand() % V;
+        int target = rand() % V;
+        int expected = INF;
+
+        for (int engine = 0; engine < NUM_ENGINES; ++engine) {
+            int settled = 0;
+            comparisonCount = 0;
+
+            start = nowMicros();
+            int dist = runQuery(engine, graph, reverse, landmarks, src, target, &settled, &comparisonCount);
+            double latency = nowMicros() - start;
+
+            if (engine == 0) {
+                expected = dist;
+            } else if (dist != expected) {
+                fprintf(stderr, "Mismatch on query %d (%d -> %d): %s gave %d, expected %d\n",
+                        q, src, target, engineNames[engine], dist, expected);
+                mismatches++;
+            }
+
+            totalSettled[engine] += settled;
+            totalLatency[engine] += latency;
+            fprintf(file, "%d,%d,%d,%s,%d,%d,%d,%f\n",
+                    q, src, target, engineNames[engine], dist, settled, comparisonCount, latency);
+        }
+    }
+
+    fclose(file);
+
+    printf("V=%d E=%d queries=%d\n", V, E, queries);
+    printf("%-14s %14s %14s %10s\n", "engine", "avg settled", "avg latency", "speedup");
+    for (int engine = 0; engine < NUM_ENGINES; ++engine) {
+        printf("%-14s %14.1f %11.1f us %9.2fx\n", engineNames[engine],
+               totalSettled[engine] / queries, totalLatency[engine] / queries,
+               totalLatency[0] / totalLatency[engine]);
+    }
+    printf("Results have been saved to p2p_results.csv (%d mismatches)\n", mismatches);
+
+    freeLandmarks(landmarks);
+    freeGraph(reverse);
+    freeGraph(graph);
+
+    return mismatches != 0;
+}
@@ -1,21 +1,18 @@
+// Build: gcc -O2 -o part_b_fixed_V part_b_fixed_V.c csr.c undirected.c generator.c results.c -lpthread -lm
+// RESULTS_FORMAT=csv|jsonl|columnar selects the results format (csv by default)
 #include <stdio.h>
 #include <stdlib.h>
 #include <limits.h>
+#include <stdint.h>
+
+#include "generator.h"
+#include "undirected.h"
+#include "results.h"
+#include "distance.h"
 
-#define MAX_V 1000
 #define MAX_E 1000000
 #define STEP 1000
 
-typedef struct {
-    int vertex;
-    int weight;
-} Edge;
-
-typedef struct {
-    Edge* edges;
-    int edge_count;
-} AdjacencyList;
-
 typedef struct {
     int vertex;
     int distance;
@@ -26,21 +23,10 @@ typedef struct {
     int size;
 } MinHeap;
 
-AdjacencyList graph[MAX_V];
+// Every edge stored once and followed both ways (undirected.h)
+struct UndirectedGraph* graph = NULL;
 int comparisons;
 
-void init_graph(int V) {
-    for (int i = 0; i < V; i++) {
-        graph[i].edges = malloc(sizeof(Edge) * (MAX_E / V));  // Allocating space for edges
-        graph[i].edge_count = 0;
-    }
-}
-
-void add_edge(int u, int v, int weight) {
-    graph[u].edges[graph[u].edge_count++] = (Edge){v, weight};
-    graph[v].edges[graph[v].edge_count++] = (Edge){u, weight};  // For undirected graph
-}
-
 MinHeap* create_min_heap(int capacity) {
     MinHeap* minHeap = malloc(sizeof(MinHeap));
     minHeap->nodes = malloc(sizeof(HeapNode) * capacity);
@@ -75,20 +61,29 @@ void dijkstra(int V, int start) {
     }
     distances[start] = 0;
 
-    MinHeap* minHeap = create_min_heap(V);
+    // Every successful relaxation inserts a new entry, so the heap can hold up to one per
+    // direction of every edge
+    MinHeap* minHeap = create_min_heap(1 + 2 * graph->E);
     min_heap_insert(minHeap, start, 0);
 
     while (!is_empty(minHeap)) {
         HeapNode minNode = extract_min(minHeap);
-
-        for (int i = 0; i < graph[minNode.vertex].edge_count; i++) {
-            comparisons++;
-            Edge edge = graph[minNode.vertex].edges[i];
-            int distance = minNode.distance + edge.weight;
-
-            if (distance < distances[edge.vertex]) {
-                distances[edge.vertex] = distance;
-                min_heap_insert(minHeap, edge.vertex, distance);
+        int u = minNode.vertex;
+
+        // The edges where u is the lower end, then those where it is the higher end
+        for (int pass = 0; pass < 2; pass++) {
+            long begin = pass ? graph->reverseOffsets[u] : graph->offsets[u];
+            long end = pass ? graph->reverseOffsets[u + 1] : graph->offsets[u + 1];
+            for (long i = begin; i < end; i++) {
+                comparisons++;
+                long e = pass ? graph->reverseEdges[i] : i;
+                int v = graph->ends[e] ^ u;
+                int distance = addDistInt(minNode.distance, graph->weights[e], INT_MAX);  // No overflow past INT_MAX
+
+                if (distance < distances[v]) {
+                    distances[v] = distance;
+                    min_heap_insert(minHeap, v, distance);
+                }
             }
         }
     }
@@ -98,65 +93,62 @@ void dijkstra(int V, int start) {
     free(minHeap);
 }
 
-void write_results_to_csv(const char* filename, int V, int E, int comparisons) {
-    FILE* file = fopen(filename, "a");
-    if (file != NULL) {
-        fprintf(file, "%d,%d,%d\n", E, V, comparisons);
-        fclose(file);
-    }
+// Function to get the bytes of the adjacency lists this program used to keep: a {vertex, weight}
+// entry in the lists of both ends of every edge, in buffers of MAX_E / V entries allocated per
+// vertex up front, and a {pointer, count} header per vertex
+long mirrored_list_bytes(int V) {
+    return (long) V * (16 + (MAX_E / V) * 2 * sizeof(int));
 }
 
-void generate_graph(int V, int E) {
-    init_graph(V);
-    int edges_added = 0;
-    int max_possible_edges = V * (V - 1) / 2;
+// The bytes per edge are over the edges the graph really has
+void write_results(struct ResultsSink* results, int V, int E, int comparisons) {
+    addResultInt(results, E);
+    addResultInt(results, V);
+    addResultInt(results, comparisons);
+    addResultDouble(results, graph->E > 0 ? (double) undirectedGraphBytes(graph) / graph->E : 0);
+    addResultDouble(results, graph->E > 0 ? (double) mirrored_list_bytes(V) / graph->E : 0);
+    endResultsRow(results);
+}
 
-    if (E > max_possible_edges) {
-        printf("E exceeds the maximum number of possible edges for the graph.\n");
-        return;
+void generate_graph(int V, int E) {
+    if (graph != NULL) {
+        freeUndirectedGraph(graph);
     }
 
-    while (edges_added < E) {
-        int u = rand() % V;
-        int v = rand() % V;
-        int weight = (rand() % 10) + 1;
-
-        // Avoid self-loops and duplicate edges
-        if (u != v) {
-            int duplicate = 0;
-            for (int i = 0; i < graph[u].edge_count; i++) {
-                if (graph[u].edges[i].vertex == v) {
-                    duplicate = 1;
-                    break;
-                }
-            }
-            if (!duplicate) {
-                add_edge(u, v, weight);
-                edges_added++;
-            }
-        }
+    // Sample E distinct undirected pairs up front; with more than fit, the graph has no edges
+    struct EdgeList pairs;
+    if (generateGnm(V, E, 0, 10, (uint64_t) E, 1, &pairs) != 0) {
+        initEdgeList(&pairs, 1);
     }
+    graph = buildUndirectedGraph(V, &pairs);
+    freeEdgeList(&pairs);
 }
 
 int main() {
     int V = 1000;  // Fixed number of vertices
 
-    // Create CSV file and write headers
-    FILE* file = fopen("dijkstra_results.csv", "w");
-    fprintf(file, "E,V,comparisons\n");
-    fclose(file);
+    // Create the results file; the sink writes the header
+    enum ResultsFormat format = defaultResultsFormat();
+    char filename[64];
+    snprintf(filename, sizeof(filename), "dijkstra_results.%s", resultsFormatExtension(format));
+    struct ResultsColumn columns[] = {{"E", RESULTS_INT}, {"V", RESULTS_INT}, {"comparisons", RESULTS_INT},
+                                      {"bytes_per_edge", RESULTS_DOUBLE}, {"old_bytes_per_edge", RESULTS_DOUBLE}};
+    struct ResultsSink* results = openResultsSink(filename, format, columns, 5, 0);
+    if (results == NULL) {
+        return 1;
+    }
 
-    for (int E = 1000; E <= MAX_E; E += STEP) {
+    // A simple undirected graph has at most V(V-1)/2 edges, so the sweep stops there
+    long maxEdges = (long) V * (V - 1) / 2;
+    for (int E = 1000; E <= MAX_E && E <= maxEdges; E += STEP) {
         comparisons = 0;
         generate_graph(V, E);
         dijkstra(V, 0);  // Start from vertex 0
-        write_results_to_csv("dijkstra_results.csv", V, E, comparisons);
+        write_results(results, V, E, comparisons);
     }
 
     // Free graph memory
-    for (int i = 0; i < V; i++) {
-        free(graph[i].edges);
-    }
+    freeUndirectedGraph(graph);
 
-    return 0;
+    return closeResultsSink(results) != 0;
 }
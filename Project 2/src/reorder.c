@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "reorder.h"
+#include "rng.h"
+
+static const char* orderNames[] = {"random", "bfs", "rcm", "degree"};
+
+// Function to parse an order name, returns -1 if unknown
+int parseVertexOrder(const char* name) {
+    for (int i = 0; i < 4; ++i) {
+        if (strcmp(name, orderNames[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const char* vertexOrderName(enum VertexOrder order) {
+    return orderNames[order];
+}
+
+static int compareLongs(const void* a, const void* b) {
+    long x = *(const long*) a;
+    long y = *(const long*) b;
+    return (x > y) - (x < y);
+}
+
+// Function to list the vertices by out-degree with a counting sort, ties in id order
+static void sortByDegree(struct CSRGraph* csr, int descending, int* order) {
+    int V = csr->V;
+    long maxDegree = 0;
+    for (int u = 0; u < V; ++u) {
+        long degree = csr->offsets[u + 1] - csr->offsets[u];
+        if (degree > maxDegree) {
+            maxDegree = degree;
+        }
+    }
+
+    long* start = (long*) calloc(maxDegree + 2, sizeof(long));
+    for (int u = 0; u < V; ++u) {
+        long degree = csr->offsets[u + 1] - csr->offsets[u];
+        start[(descending ? maxDegree - degree : degree) + 1]++;
+    }
+    for (long d = 0; d <= maxDegree; ++d) {
+        start[d + 1] += start[d];
+    }
+    for (int u = 0; u < V; ++u) {
+        long degree = csr->offsets[u + 1] - csr->offsets[u];
+        order[start[descending ? maxDegree - degree : degree]++] = u;
+    }
+    free(start);
+}
+
+// Function to fill order[] breadth first. Each component starts from the first unvisited
+// vertex of starts[]; with byDegree set, the new neighbours of a vertex are queued by
+// increasing degree (Cuthill-McKee).
+static void breadthFirstOrder(struct CSRGraph* csr, const int* starts, int byDegree, int* order) {
+    int V = csr->V;
+    char* visited = (char*) calloc(V, sizeof(char));
+    long* keys = byDegree ? (long*) malloc(V * sizeof(long)) : NULL;
+    int head = 0, tail = 0;
+
+    for (int i = 0; i < V; ++i) {
+        if (visited[starts[i]]) {
+            continue;
+        }
+        visited[starts[i]] = 1;
+        order[tail++] = starts[i];
+
+        // The queue is order[] itself
+        while (head < tail) {
+            int u = order[head++];
+            int found = 0;
+
+            for (long e = csr->offsets[u]; e < csr->offsets[u + 1]; ++e) {
+                int v = csr->targets[e];
+                if (visited[v]) {
+                    continue;
+                }
+                visited[v] = 1;
+                if (byDegree) {
+                    // Sort key: degree in the high bits, id in the low bits
+                    keys[found++] = ((csr->offsets[v + 1] - csr->offsets[v]) << 32) | v;
+                } else {
+                    order[tail++] = v;
+                }
+            }
+
+            if (byDegree) {
+                qsort(keys, found, sizeof(long), compareLongs);
+                for (int k = 0; k < found; ++k) {
+                    order[tail++] = (int) (keys[k] & 0xffffffffL);
+                }
+            }
+        }
+    }
+
+    free(keys);
+    free(visited);
+}
+
+// Function to compute a relabeling of csr; seed is only used by ORDER_RANDOM
+struct Relabeling* computeRelabeling(struct CSRGraph* csr, enum VertexOrder order, uint64_t seed) {
+    int V = csr->V;
+    struct Relabeling* relabeling = (struct Relabeling*) malloc(sizeof(struct Relabeling));
+    relabeling->V = V;
+    relabeling->newId = (int*) malloc(V * sizeof(int));
+    relabeling->oldId = (int*) malloc(V * sizeof(int));
+    int* oldId = relabeling->oldId;
+
+    if (order == ORDER_RANDOM) {
+        // Fisher-Yates shuffle
+        struct Rng rng;
+        rngSeed(&rng, seed, 0);
+        for (int i = 0; i < V; ++i) {
+            oldId[i] = i;
+        }
+        for (int i = V - 1; i > 0; --i) {
+            int j = (int) rngBounded(&rng, (uint64_t) i + 1);
+            int temp = oldId[i];
+            oldId[i] = oldId[j];
+            oldId[j] = temp;
+        }
+    } else if (order == ORDER_DEGREE) {
+        sortByDegree(csr, 1, oldId);
+    } else {
+        int* starts = (int*) malloc(V * sizeof(int));
+        if (order == ORDER_RCM) {
+            // Low-degree vertices approximate the peripheral starts Cuthill-McKee wants
+            sortByDegree(csr, 0, starts);
+        } else {
+            for (int i = 0; i < V; ++i) {
+                starts[i] = i;
+            }
+        }
+        breadthFirstOrder(csr, starts, order == ORDER_RCM, oldId);
+        free(starts);
+
+        if (order == ORDER_RCM) {
+            for (int i = 0, j = V - 1; i < j; ++i, --j) {
+                int temp = oldId[i];
+                oldId[i] = oldId[j];
+                oldId[j] = temp;
+            }
+        }
+    }
+
+    for (int i = 0; i < V; ++i) {
+        relabeling->newId[oldId[i]] = i;
+    }
+    return relabeling;
+}
+
+// Function to build the relabeled graph: row newId[u] holds the edges of u, in the same order
+struct CSRGraph* relabelCSRGraph(struct CSRGraph* csr, struct Relabeling* relabeling) {
+    int V = csr->V;
+    struct CSRGraph* result = (struct CSRGraph*) malloc(sizeof(struct CSRGraph));
+    result->V = V;
+    result->E = csr->E;
+    result->offsets = (long*) malloc((V + 1) * sizeof(long));
+    result->targets = (int*) malloc(csr->E * sizeof(int));
+    result->weights = (int*) malloc(csr->E * sizeof(int));
+
+    result->offsets[0] = 0;
+    for (int i = 0; i < V; ++i) {
+        int u = relabeling->oldId[i];
+        long begin = csr->offsets[u];
+        long degree = csr->offsets[u + 1] - begin;
+        long out = result->offsets[i];
+
+        for (long e = 0; e < degree; ++e) {
+            result->targets[out + e] = relabeling->newId[csr->targets[begin + e]];
+        }
+        memcpy(result->weights + out, csr->weights + begin, degree * sizeof(int));
+        result->offsets[i + 1] = out + degree;
+    }
+    return result;
+}
+
+// Function to translate per-vertex values from new ids back to original ids
+void restoreOriginalOrder(struct Relabeling* relabeling, const int* byNewId, int* byOldId) {
+    for (int v = 0; v < relabeling->V; ++v) {
+        byOldId[v] = byNewId[relabeling->newId[v]];
+    }
+}
+
+// Function to free a relabeling
+void freeRelabeling(struct Relabeling* relabeling) {
+    free(relabeling->newId);
+    free(relabeling->oldId);
+    free(relabeling);
+}
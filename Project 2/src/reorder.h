@@ -0,0 +1,39 @@
+#ifndef REORDER_H
+#define REORDER_H
+
+#include <stdint.h>
+
+#include "csr.h"
+
+// Vertex orders for relabeling a graph
+enum VertexOrder {
+    ORDER_RANDOM,  // Random permutation: the locality of generateRandomGraph() ids
+    ORDER_BFS,     // Breadth-first order, components in order of their smallest id
+    ORDER_RCM,     // Reverse Cuthill-McKee: BFS from low-degree vertices, neighbours by degree, reversed
+    ORDER_DEGREE   // Highest out-degree first
+};
+
+// A permutation of the vertex ids together with its inverse
+struct Relabeling {
+    int V;
+    int *newId;  // newId[old] = id of the vertex after relabeling
+    int *oldId;  // oldId[new] = id of the vertex before relabeling
+};
+
+// Function to parse an order name, returns -1 if unknown
+int parseVertexOrder(const char* name);
+const char* vertexOrderName(enum VertexOrder order);
+
+// Function to compute a relabeling of csr; seed is only used by ORDER_RANDOM
+struct Relabeling* computeRelabeling(struct CSRGraph* csr, enum VertexOrder order, uint64_t seed);
+
+// Function to build the relabeled graph: row newId[u] holds the edges of u, in the same order
+struct CSRGraph* relabelCSRGraph(struct CSRGraph* csr, struct Relabeling* relabeling);
+
+// Function to translate per-vertex values from new ids back to original ids
+void restoreOriginalOrder(struct Relabeling* relabeling, const int* byNewId, int* byOldId);
+
+// Function to free a relabeling
+void freeRelabeling(struct Relabeling* relabeling);
+
+#endif
@@ -0,0 +1,218 @@
+// Build: gcc -O2 -o reorder_bench reorder_bench.c graph.c arena.c minheap.c dheap.c trace.c dijkstra.c csr.c generator.c workload.c reorder.c -lpthread -lm
+// Usage: ./reorder_bench [workload] [V] [E] [sources]
+// Vertex ids are shuffled first, then every order relabels the shuffled graph.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "graph.h"
+#include "csr.h"
+#include "dijkstra.h"
+#include "generator.h"
+#include "workload.h"
+#include "reorder.h"
+#include "rng.h"
+
+#define NUM_ORDERS 4
+
+// Function to read a monotonic clock in milliseconds
+static double nowMillis(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+// Function to open a last-level cache miss counter for this thread, -1 if not permitted
+static int openCacheMissCounter(void) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void startCounter(int fd) {
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+// Function to stop the counter and return its value, -1 without a counter
+static long long stopCounter(int fd) {
+    long long count = -1;
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+            count = -1;
+        }
+    }
+    return count;
+}
+
+// Function to generate the benchmark graph as CSR
+static struct CSRGraph* generateCSR(enum WorkloadType workload, int V, long E, int threads) {
+    if (workload == WORKLOAD_UNIFORM) {
+        return generateGnmCSR(V, E / 2, 0, 10, 1, threads);
+    }
+
+    struct WeightSpec weights = {WEIGHT_UNIFORM, 1, 10};
+    struct EdgeList list;
+    initEdgeList(&list, E + 16);
+    if (workload == WORKLOAD_RMAT) {
+        generateRMAT(V, E, &weights, 1, &list);
+    } else if (workload == WORKLOAD_GRID) {
+        generateGrid(V, E, &weights, 1, &list);
+    } else {
+        generateGeometric(V, E, &weights, 1, &list);
+    }
+    struct CSRGraph* csr = buildCSRGraph(V, &list, 1, threads);
+    freeEdgeList(&list);
+    return csr;
+}
+
+int main(int argc, char* argv[]) {
+    int workload = parseWorkload(argc > 1 ? argv[1] : "geometric");
+    int V = argc > 2 ? atoi(argv[2]) : 1000000;
+    long E = argc > 3 ? atol(argv[3]) : 8L * V;
+    int sources = argc > 4 ? atoi(argv[4]) : 4;
+    int threads = defaultThreadCount();
+
+    if (workload < 0) {
+        fprintf(stderr, "Unknown workload, expected uniform, rmat, grid or geometric.\n");
+        return 1;
+    }
+
+    // The shuffled graph stands in for generateRandomGraph()'s arbitrary ids
+    struct CSRGraph* generated = generateCSR(workload, V, E, threads);
+    struct Relabeling* shuffle = computeRelabeling(generated, ORDER_RANDOM, 1);
+    struct CSRGraph* base = relabelCSRGraph(generated, shuffle);
+    freeRelabeling(shuffle);
+    freeCSRGraph(generated);
+    printf("%s graph: V=%d E=%ld, %d sources\n", workloadName(workload), base->V, base->E, sources);
+
+    int counter = openCacheMissCounter();
+    if (counter < 0) {
+        printf("LLC miss counter unavailable (perf_event_open not permitted), reporting time only\n");
+    }
+
+    int* src = (int*) malloc(sources * sizeof(int));
+    struct Rng rng;
+    rngSeed(&rng, 2, 0);
+    for (int s = 0; s < sources; ++s) {
+        src[s] = (int) rngBounded(&rng, V);
+    }
+
+    // Reference distances on the shuffled graph, one row per source
+    int** expected = (int**) malloc(sources * sizeof(int*));
+    int* dist = (int*) malloc(V * sizeof(int));
+    int* restored = (int*) malloc(V * sizeof(int));
+    for (int s = 0; s < sources; ++s) {
+        int comparisonCount = 0;
+        expected[s] = (int*) malloc(V * sizeof(int));
+        dijkstraCSR(base, src[s], expected[s], &comparisonCount);
+    }
+
+    FILE* file = fopen("reorder_results.csv", "w");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening file for writing.\n");
+        return 1;
+    }
+    fprintf(file, "Workload,Order,Relabel (ms),Engine,Avg Time (ms),Avg LLC Misses\n");
+    printf("%-8s %12s %-10s %14s %16s %9s\n", "order", "relabel (ms)", "engine", "avg time (ms)",
+           "avg LLC misses", "speedup");
+
+    double baseTime[2] = {0, 0};
+    int mismatches = 0;
+
+    for (int order = 0; order < NUM_ORDERS; ++order) {
+        // ORDER_RANDOM is the shuffled graph as it is
+        struct Relabeling* relabeling = NULL;
+        struct CSRGraph* csr = base;
+        double start = nowMillis();
+        if (order != ORDER_RANDOM) {
+            relabeling = computeRelabeling(base, order, 0);
+            csr = relabelCSRGraph(base, relabeling);
+        }
+        double relabelMs = nowMillis() - start;
+
+        // The adjacency list is rebuilt from the relabeled rows, so its arena follows the new order too
+        struct Graph* graph = csrToGraph(csr);
+
+        for (int engine = 0; engine < 2; ++engine) {
+            double elapsed = 0;
+            long long misses = 0;
+
+            for (int s = 0; s < sources; ++s) {
+                int source = relabeling ? relabeling->newId[src[s]] : src[s];
+                int comparisonCount = 0;
+
+                startCounter(counter);
+                start = nowMillis();
+                if (engine == 0) {
+                    dijkstraCSR(csr, source, dist, &comparisonCount);
+                } else {
+                    dijkstraDist(graph, source, dist, &comparisonCount);
+                }
+                elapsed += nowMillis() - start;
+                misses += stopCounter(counter);
+
+                // Results are compared in the shuffled graph's ids
+                if (relabeling) {
+                    restoreOriginalOrder(relabeling, dist, restored);
+                } else {
+                    memcpy(restored, dist, V * sizeof(int));
+                }
+                if (memcmp(restored, expected[s], V * sizeof(int)) != 0) {
+                    fprintf(stderr, "Mismatch for order %s from source %d\n", vertexOrderName(order), src[s]);
+                    mismatches++;
+                }
+            }
+
+            const char* engineName = engine == 0 ? "csr" : "list";
+            double avg = elapsed / sources;
+            if (order == ORDER_RANDOM) {
+                baseTime[engine] = avg;
+            }
+            char missText[32] = "n/a";
+            if (counter >= 0) {
+                snprintf(missText, sizeof(missText), "%.0f", (double) misses / sources);
+            }
+            printf("%-8s %12.1f %-10s %14.1f %16s %8.2fx\n", vertexOrderName(order), relabelMs, engineName,
+                   avg, missText, baseTime[engine] / avg);
+            fprintf(file, "%s,%s,%f,%s,%f,%f\n", workloadName(workload), vertexOrderName(order), relabelMs,
+                    engineName, avg, counter >= 0 ? (double) misses / sources : -1.0);
+        }
+
+        freeGraph(graph);
+        if (relabeling) {
+            freeRelabeling(relabeling);
+            freeCSRGraph(csr);
+        }
+    }
+    fclose(file);
+    printf("Results have been saved to reorder_results.csv (%d mismatches)\n", mismatches);
+
+    if (counter >= 0) {
+        close(counter);
+    }
+    for (int s = 0; s < sources; ++s) {
+        free(expected[s]);
+    }
+    free(expected);
+    free(dist);
+    free(restored);
+    free(src);
+    freeCSRGraph(base);
+
+    return mismatches != 0;
+}
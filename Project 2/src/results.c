@@ -0,0 +1,560 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <math.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "results.h"
+
+// Columnar layout, little-endian: "RSCL", uint32 version, uint32 column count, then per column
+// a uint8 type, a uint16 name length and the name. After that come blocks of up to
+// RESULTS_BLOCK_ROWS rows: a uint32 row count followed by each column's values as an array
+// of int64 or double, or for text columns an array of uint32 lengths followed by the bytes.
+#define RESULTS_VERSION 1
+#define RESULTS_BLOCK_ROWS 4096
+
+// A buffer is handed to the writer once it holds this much, and the producer waits while
+// more than RESULTS_MAX_PENDING buffers are queued
+#define RESULTS_FLUSH_BYTES (1 << 20)
+#define RESULTS_MAX_PENDING 4
+
+union ResultsValue {
+    int64_t i;
+    double d;
+    const char *s;  // The caller's string in row[], a copy owned by the sink in block[]
+};
+
+struct ResultsBuffer {
+    char *data;
+    size_t length;
+    size_t capacity;
+    struct ResultsBuffer *next;
+};
+
+struct ResultsSink {
+    int fd;
+    enum ResultsFormat format;
+    int numColumns;
+    struct ResultsColumn *columns;
+
+    // The row being filled in, touched by the producer only
+    union ResultsValue *row;
+    int filled;
+
+    // Guarded by lock: the columnar block and buffer being filled, and the writer's queue
+    pthread_mutex_t lock;
+    pthread_cond_t work;     // Signalled when a buffer is queued or the sink closes
+    pthread_cond_t drained;  // Signalled when the writer finished a buffer
+    union ResultsValue *block;
+    int blockRows;
+    struct ResultsBuffer *current;
+    struct ResultsBuffer *queueHead, *queueTail;
+    struct ResultsBuffer *spare;
+    int pending;             // Buffers queued or being written
+    int closing;
+    int error;
+
+    pthread_t writer;
+    struct ResultsSink *nextOpen;
+};
+
+// Every open sink, for the exit and signal handlers
+static pthread_mutex_t registryLock = PTHREAD_MUTEX_INITIALIZER;
+static struct ResultsSink *openSinks = NULL;
+static pthread_once_t handlersOnce = PTHREAD_ONCE_INIT;
+
+int parseResultsFormat(const char* name) {
+    if (strcmp(name, "csv") == 0) return RESULTS_CSV;
+    if (strcmp(name, "jsonl") == 0) return RESULTS_JSONL;
+    if (strcmp(name, "columnar") == 0) return RESULTS_COLUMNAR;
+    return -1;
+}
+
+const char* resultsFormatExtension(enum ResultsFormat format) {
+    switch (format) {
+    case RESULTS_JSONL: return "jsonl";
+    case RESULTS_COLUMNAR: return "cols";
+    default: return "csv";
+    }
+}
+
+enum ResultsFormat defaultResultsFormat(void) {
+    const char* name = getenv("RESULTS_FORMAT");
+    if (name == NULL || *name == '\0') {
+        return RESULTS_CSV;
+    }
+    int format = parseResultsFormat(name);
+    if (format < 0) {
+        fprintf(stderr, "Unknown RESULTS_FORMAT %s, writing CSV.\n", name);
+        return RESULTS_CSV;
+    }
+    return (enum ResultsFormat) format;
+}
+
+static void reserve(struct ResultsBuffer *buffer, size_t extra) {
+    if (buffer->length + extra > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity : RESULTS_FLUSH_BYTES + 4096;
+        while (buffer->length + extra > capacity) {
+            capacity *= 2;
+        }
+        buffer->data = (char *) realloc(buffer->data, capacity);
+        buffer->capacity = capacity;
+    }
+}
+
+static void appendBytes(struct ResultsBuffer *buffer, const void *data, size_t length) {
+    reserve(buffer, length);
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+}
+
+static void appendText(struct ResultsBuffer *buffer, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    reserve(buffer, 64);
+    int n = vsnprintf(buffer->data + buffer->length, buffer->capacity - buffer->length, format, args);
+    va_end(args);
+
+    if ((size_t) n >= buffer->capacity - buffer->length) {
+        reserve(buffer, (size_t) n + 1);
+        va_start(args, format);
+        vsnprintf(buffer->data + buffer->length, buffer->capacity - buffer->length, format, args);
+        va_end(args);
+    }
+    buffer->length += (size_t) n;
+}
+
+static void encodeHeader(struct ResultsSink *sink) {
+    struct ResultsBuffer *buffer = sink->current;
+
+    if (sink->format == RESULTS_CSV) {
+        for (int c = 0; c < sink->numColumns; ++c) {
+            appendText(buffer, c ? ",%s" : "%s", sink->columns[c].name);
+        }
+        appendText(buffer, "\n");
+    } else if (sink->format == RESULTS_COLUMNAR) {
+        uint32_t version = RESULTS_VERSION, count = (uint32_t) sink->numColumns;
+        appendBytes(buffer, "RSCL", 4);
+        appendBytes(buffer, &version, sizeof(version));
+        appendBytes(buffer, &count, sizeof(count));
+        for (int c = 0; c < sink->numColumns; ++c) {
+            uint8_t type = (uint8_t) sink->columns[c].type;
+            uint16_t length = (uint16_t) strlen(sink->columns[c].name);
+            appendBytes(buffer, &type, sizeof(type));
+            appendBytes(buffer, &length, sizeof(length));
+            appendBytes(buffer, sink->columns[c].name, length);
+        }
+    }
+}
+
+static void encodeBlock(struct ResultsSink *sink) {
+    uint32_t rows = (uint32_t) sink->blockRows;
+    if (rows == 0) {
+        return;
+    }
+    appendBytes(sink->current, &rows, sizeof(rows));
+    for (int c = 0; c < sink->numColumns; ++c) {
+        union ResultsValue *column = &sink->block[(size_t) c * RESULTS_BLOCK_ROWS];
+        if (sink->columns[c].type != RESULTS_TEXT) {
+            appendBytes(sink->current, column, rows * sizeof(union ResultsValue));
+            continue;
+        }
+        for (uint32_t r = 0; r < rows; ++r) {
+            uint32_t length = (uint32_t) strlen(column[r].s);
+            appendBytes(sink->current, &length, sizeof(length));
+        }
+        for (uint32_t r = 0; r < rows; ++r) {
+            appendBytes(sink->current, column[r].s, strlen(column[r].s));
+            free((char *) column[r].s);
+        }
+    }
+    sink->blockRows = 0;
+}
+
+// Function to write a CSV field, quoted if it contains a separator, quote or line break
+static void appendCSVText(struct ResultsBuffer *buffer, const char *text) {
+    if (strpbrk(text, ",\"\r\n") == NULL) {
+        appendText(buffer, "%s", text);
+        return;
+    }
+    appendText(buffer, "\"");
+    for (const char *p = text; *p; ++p) {
+        appendText(buffer, *p == '"' ? "\"\"" : "%c", *p);
+    }
+    appendText(buffer, "\"");
+}
+
+static void appendJSONText(struct ResultsBuffer *buffer, const char *text) {
+    appendText(buffer, "\"");
+    for (const char *p = text; *p; ++p) {
+        if (*p == '"' || *p == '\\') {
+            appendText(buffer, "\\%c", *p);
+        } else if ((unsigned char) *p < 0x20) {
+            appendText(buffer, "\\u%04x", (unsigned char) *p);
+        } else {
+            appendText(buffer, "%c", *p);
+        }
+    }
+    appendText(buffer, "\"");
+}
+
+static void encodeRow(struct ResultsSink *sink) {
+    struct ResultsBuffer *buffer = sink->current;
+
+    switch (sink->format) {
+    case RESULTS_CSV:
+        for (int c = 0; c < sink->numColumns; ++c) {
+            if (c > 0) {
+                appendText(buffer, ",");
+            }
+            if (sink->columns[c].type == RESULTS_INT) {
+                appendText(buffer, "%lld", (long long) sink->row[c].i);
+            } else if (sink->columns[c].type == RESULTS_DOUBLE) {
+                appendText(buffer, "%f", sink->row[c].d);
+            } else {
+                appendCSVText(buffer, sink->row[c].s);
+            }
+        }
+        appendText(buffer, "\n");
+        break;
+    case RESULTS_JSONL:
+        for (int c = 0; c < sink->numColumns; ++c) {
+            appendText(buffer, c ? ",\"%s\":" : "{\"%s\":", sink->columns[c].name);
+            if (sink->columns[c].type == RESULTS_INT) {
+                appendText(buffer, "%lld", (long long) sink->row[c].i);
+            } else if (sink->columns[c].type == RESULTS_TEXT) {
+                appendJSONText(buffer, sink->row[c].s);
+            } else if (isfinite(sink->row[c].d)) {
+                appendText(buffer, "%.17g", sink->row[c].d);
+            } else {
+                appendText(buffer, "null");
+            }
+        }
+        appendText(buffer, "}\n");
+        break;
+    case RESULTS_COLUMNAR:
+        for (int c = 0; c < sink->numColumns; ++c) {
+            union ResultsValue value = sink->row[c];
+            if (sink->columns[c].type == RESULTS_TEXT) {
+                value.s = strdup(value.s);
+            }
+            sink->block[(size_t) c * RESULTS_BLOCK_ROWS + sink->blockRows] = value;
+        }
+        if (++sink->blockRows == RESULTS_BLOCK_ROWS) {
+            encodeBlock(sink);
+        }
+        break;
+    }
+}
+
+// Function to queue the current buffer for the writer (lock held)
+static void handOff(struct ResultsSink *sink) {
+    if (sink->current->length == 0) {
+        return;
+    }
+
+    struct ResultsBuffer *buffer = sink->current;
+    if (sink->queueTail != NULL) {
+        sink->queueTail->next = buffer;
+    } else {
+        sink->queueHead = buffer;
+    }
+    sink->queueTail = buffer;
+    sink->pending++;
+    pthread_cond_signal(&sink->work);
+
+    if (sink->spare != NULL) {
+        sink->current = sink->spare;
+        sink->spare = sink->spare->next;
+    } else {
+        sink->current = (struct ResultsBuffer *) calloc(1, sizeof(struct ResultsBuffer));
+    }
+    sink->current->next = NULL;
+
+    while (sink->pending > RESULTS_MAX_PENDING) {
+        pthread_cond_wait(&sink->drained, &sink->lock);
+    }
+}
+
+// Function to write everything buffered and wait until it is on disk (lock held)
+static int flushLocked(struct ResultsSink *sink) {
+    encodeBlock(sink);
+    handOff(sink);
+    while (sink->pending > 0) {
+        pthread_cond_wait(&sink->drained, &sink->lock);
+    }
+    // Pipes and character devices cannot be synced, which is fine
+    if (fsync(sink->fd) != 0 && errno != EINVAL && errno != EROFS) {
+        sink->error = 1;
+    }
+    return sink->error ? -1 : 0;
+}
+
+static int writeAll(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t n = write(fd, data, length);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        data += n;
+        length -= (size_t) n;
+    }
+    return 0;
+}
+
+static void* writerMain(void *arg) {
+    struct ResultsSink *sink = (struct ResultsSink *) arg;
+
+    pthread_mutex_lock(&sink->lock);
+    for (;;) {
+        while (sink->queueHead == NULL && !sink->closing) {
+            pthread_cond_wait(&sink->work, &sink->lock);
+        }
+        struct ResultsBuffer *buffer = sink->queueHead;
+        if (buffer == NULL) {
+            break;
+        }
+        sink->queueHead = buffer->next;
+        if (sink->queueHead == NULL) {
+            sink->queueTail = NULL;
+        }
+        pthread_mutex_unlock(&sink->lock);
+
+        int failed = writeAll(sink->fd, buffer->data, buffer->length) != 0;
+
+        pthread_mutex_lock(&sink->lock);
+        if (failed && !sink->error) {
+            sink->error = 1;
+            perror("Error writing results");
+        }
+        buffer->length = 0;
+        buffer->next = sink->spare;
+        sink->spare = buffer;
+        sink->pending--;
+        pthread_cond_broadcast(&sink->drained);
+    }
+    pthread_mutex_unlock(&sink->lock);
+    return NULL;
+}
+
+// Function to flush every open sink, used by the exit and signal handlers
+static void flushAllResultsSinks(void) {
+    pthread_mutex_lock(&registryLock);
+    for (struct ResultsSink *sink = openSinks; sink != NULL; sink = sink->nextOpen) {
+        pthread_mutex_lock(&sink->lock);
+        flushLocked(sink);
+        pthread_mutex_unlock(&sink->lock);
+    }
+    pthread_mutex_unlock(&registryLock);
+}
+
+static void* signalMain(void *arg) {
+    sigset_t *signals = (sigset_t *) arg;
+    int sig;
+
+    while (sigwait(signals, &sig) != 0) {
+    }
+    flushAllResultsSinks();
+
+    // Let the signal do what it would have done without us
+    sigset_t one;
+    sigemptyset(&one);
+    sigaddset(&one, sig);
+    signal(sig, SIG_DFL);
+    pthread_sigmask(SIG_UNBLOCK, &one, NULL);
+    raise(sig);
+    return NULL;
+}
+
+static void installHandlers(void) {
+    static sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGHUP);
+
+    atexit(flushAllResultsSinks);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, signalMain, &signals) == 0) {
+        pthread_detach(thread);
+    } else {
+        pthread_sigmask(SIG_UNBLOCK, &signals, NULL);
+    }
+}
+
+static void freeBuffers(struct ResultsBuffer *buffer) {
+    while (buffer != NULL) {
+        struct ResultsBuffer *next = buffer->next;
+        free(buffer->data);
+        free(buffer);
+        buffer = next;
+    }
+}
+
+struct ResultsSink* openResultsSink(const char* filename, enum ResultsFormat format,
+                                    const struct ResultsColumn columns[], int numColumns, int append) {
+    pthread_once(&handlersOnce, installHandlers);
+
+    int fd = open(filename, O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC), 0644);
+    if (fd < 0) {
+        fprintf(stderr, "Error opening %s for writing.\n", filename);
+        return NULL;
+    }
+    struct stat st;
+    int empty = fstat(fd, &st) != 0 || st.st_size == 0;
+
+    struct ResultsSink *sink = (struct ResultsSink *) calloc(1, sizeof(struct ResultsSink));
+    sink->fd = fd;
+    sink->format = format;
+    sink->numColumns = numColumns;
+    sink->columns = (struct ResultsColumn *) malloc(numColumns * sizeof(struct ResultsColumn));
+    for (int c = 0; c < numColumns; ++c) {
+        sink->columns[c].name = strdup(columns[c].name);
+        sink->columns[c].type = columns[c].type;
+    }
+    sink->row = (union ResultsValue *) calloc(numColumns, sizeof(union ResultsValue));
+    if (format == RESULTS_COLUMNAR) {
+        sink->block = (union ResultsValue *) malloc((size_t) numColumns * RESULTS_BLOCK_ROWS * sizeof(union ResultsValue));
+    }
+    sink->current = (struct ResultsBuffer *) calloc(1, sizeof(struct ResultsBuffer));
+    pthread_mutex_init(&sink->lock, NULL);
+    pthread_cond_init(&sink->work, NULL);
+    pthread_cond_init(&sink->drained, NULL);
+    if (empty) {
+        encodeHeader(sink);
+    }
+
+    if (pthread_create(&sink->writer, NULL, writerMain, sink) != 0) {
+        fprintf(stderr, "Failed to start the results writer for %s.\n", filename);
+        close(fd);
+        freeBuffers(sink->current);
+        for (int c = 0; c < numColumns; ++c) {
+            free((char *) sink->columns[c].name);
+        }
+        free(sink->columns);
+        free(sink->row);
+        free(sink->block);
+        free(sink);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&registryLock);
+    sink->nextOpen = openSinks;
+    openSinks = sink;
+    pthread_mutex_unlock(&registryLock);
+    return sink;
+}
+
+// Values are converted to the column's type; a number for a text column becomes ""
+void addResultInt(struct ResultsSink* sink, long value) {
+    if (sink->filled < sink->numColumns) {
+        union ResultsValue *slot = &sink->row[sink->filled];
+        switch (sink->columns[sink->filled].type) {
+        case RESULTS_INT: slot->i = value; break;
+        case RESULTS_DOUBLE: slot->d = (double) value; break;
+        default: slot->s = ""; break;
+        }
+    }
+    sink->filled++;
+}
+
+void addResultDouble(struct ResultsSink* sink, double value) {
+    if (sink->filled < sink->numColumns) {
+        union ResultsValue *slot = &sink->row[sink->filled];
+        switch (sink->columns[sink->filled].type) {
+        case RESULTS_INT: slot->i = (int64_t) value; break;
+        case RESULTS_DOUBLE: slot->d = value; break;
+        default: slot->s = ""; break;
+        }
+    }
+    sink->filled++;
+}
+
+// The string only needs to stay valid until endResultsRow()
+void addResultText(struct ResultsSink* sink, const char* value) {
+    if (sink->filled < sink->numColumns) {
+        union ResultsValue *slot = &sink->row[sink->filled];
+        switch (sink->columns[sink->filled].type) {
+        case RESULTS_INT: slot->i = 0; break;
+        case RESULTS_DOUBLE: slot->d = 0; break;
+        default: slot->s = value != NULL ? value : ""; break;
+        }
+    }
+    sink->filled++;
+}
+
+int endResultsRow(struct ResultsSink* sink) {
+    if (sink->filled != sink->numColumns) {
+        fprintf(stderr, "Results row has %d values for %d columns, dropped.\n", sink->filled, sink->numColumns);
+        sink->filled = 0;
+        return -1;
+    }
+    sink->filled = 0;
+
+    pthread_mutex_lock(&sink->lock);
+    encodeRow(sink);
+    if (sink->current->length >= RESULTS_FLUSH_BYTES) {
+        handOff(sink);
+    }
+    int error = sink->error;
+    pthread_mutex_unlock(&sink->lock);
+    return error ? -1 : 0;
+}
+
+int flushResultsSink(struct ResultsSink* sink) {
+    pthread_mutex_lock(&sink->lock);
+    int status = flushLocked(sink);
+    pthread_mutex_unlock(&sink->lock);
+    return status;
+}
+
+int closeResultsSink(struct ResultsSink* sink) {
+    pthread_mutex_lock(&registryLock);
+    for (struct ResultsSink **link = &openSinks; *link != NULL; link = &(*link)->nextOpen) {
+        if (*link == sink) {
+            *link = sink->nextOpen;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&registryLock);
+
+    pthread_mutex_lock(&sink->lock);
+    int status = flushLocked(sink);
+    sink->closing = 1;
+    pthread_cond_signal(&sink->work);
+    pthread_mutex_unlock(&sink->lock);
+    pthread_join(sink->writer, NULL);
+
+    if (close(sink->fd) != 0) {
+        status = -1;
+    }
+    freeBuffers(sink->current);
+    freeBuffers(sink->spare);
+    pthread_mutex_destroy(&sink->lock);
+    pthread_cond_destroy(&sink->work);
+    pthread_cond_destroy(&sink->drained);
+    for (int c = 0; c < sink->numColumns; ++c) {
+        free((char *) sink->columns[c].name);
+    }
+    free(sink->columns);
+    free(sink->row);
+    free(sink->block);
+    free(sink);
+
+    if (status != 0) {
+        fprintf(stderr, "Error writing results.\n");
+    }
+    return status;
+}
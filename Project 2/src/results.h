@@ -0,0 +1,60 @@
+#ifndef RESULTS_H
+#define RESULTS_H
+
+// Buffered results sink for the benchmark drivers. Rows are encoded into an in-memory buffer
+// and handed to a background thread that writes them out in large writes, so a sweep costs
+// one open and a handful of write() calls instead of an fopen/fclose per data point.
+//
+// Everything still buffered is written and fsync'ed by closeResultsSink(), on exit() and on
+// SIGINT, SIGTERM or SIGHUP: the first openResultsSink() blocks those signals in the calling
+// thread (and so in every thread it starts afterwards) and leaves them to a thread of its own,
+// which flushes every open sink and then lets the signal take its default action. Open the
+// sink before starting other threads. SIGKILL and crashes can still lose buffered rows.
+
+enum ResultsFormat {
+    RESULTS_CSV,       // Header line, then one comma separated line per row
+    RESULTS_JSONL,     // One JSON object per row
+    RESULTS_COLUMNAR   // Binary blocks of column arrays, see results.c; results_dump prints them
+};
+
+enum ResultsColumnType {
+    RESULTS_INT,       // Written with addResultInt(), stored as int64
+    RESULTS_DOUBLE,    // Written with addResultDouble(), stored as a double
+    RESULTS_TEXT       // Written with addResultText(), stored as length-prefixed bytes
+};
+
+struct ResultsColumn {
+    const char* name;
+    enum ResultsColumnType type;
+};
+
+struct ResultsSink;
+
+// Function to parse "csv", "jsonl" or "columnar", returns -1 if unknown
+int parseResultsFormat(const char* name);
+
+// Function to get the file extension of a format: "csv", "jsonl" or "cols"
+const char* resultsFormatExtension(enum ResultsFormat format);
+
+// Function to pick the format from the RESULTS_FORMAT environment variable, CSV if unset
+enum ResultsFormat defaultResultsFormat(void);
+
+// Function to open a sink. With append, rows go after the existing contents and the header is
+// only written if the file is empty; otherwise the file is truncated. Returns NULL on failure.
+struct ResultsSink* openResultsSink(const char* filename, enum ResultsFormat format,
+                                    const struct ResultsColumn columns[], int numColumns, int append);
+
+// Functions to fill in the columns of the next row in order, then finish it.
+// endResultsRow() returns 0, or -1 if the row was incomplete or an earlier write failed.
+void addResultInt(struct ResultsSink* sink, long value);
+void addResultDouble(struct ResultsSink* sink, double value);
+void addResultText(struct ResultsSink* sink, const char* value);
+int endResultsRow(struct ResultsSink* sink);
+
+// Function to write out and fsync everything buffered so far, returns 0 on success
+int flushResultsSink(struct ResultsSink* sink);
+
+// Function to flush and close a sink, returns 0 if every row reached the file
+int closeResultsSink(struct ResultsSink* sink);
+
+#endif
@@ -0,0 +1,107 @@
+// Build: gcc -O2 -o results_dump results_dump.c
+// Usage: ./results_dump <results.cols>
+// Prints a columnar results file written by results.c as CSV.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "results.h"
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: results_dump <results.cols>\n");
+        return 1;
+    }
+    FILE* file = fopen(argv[1], "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening %s for reading.\n", argv[1]);
+        return 1;
+    }
+
+    char magic[4];
+    uint32_t version, numColumns;
+    if (fread(magic, 1, 4, file) != 4 || memcmp(magic, "RSCL", 4) != 0 ||
+        fread(&version, sizeof(version), 1, file) != 1 || version != 1 ||
+        fread(&numColumns, sizeof(numColumns), 1, file) != 1 || numColumns == 0 || numColumns > 4096) {
+        fprintf(stderr, "%s is not a version 1 columnar results file.\n", argv[1]);
+        fclose(file);
+        return 1;
+    }
+
+    uint8_t* types = (uint8_t*) malloc(numColumns);
+    for (uint32_t c = 0; c < numColumns; ++c) {
+        uint16_t length;
+        char name[65536];
+        if (fread(&types[c], 1, 1, file) != 1 || fread(&length, sizeof(length), 1, file) != 1 ||
+            fread(name, 1, length, file) != length) {
+            fprintf(stderr, "%s has a truncated header.\n", argv[1]);
+            return 1;
+        }
+        printf(c ? ",%.*s" : "%.*s", (int) length, name);
+    }
+    printf("\n");
+
+    // Each block holds its columns one after the other
+    long rows = 0;
+    uint32_t count;
+    int64_t** numbers = (int64_t**) calloc(numColumns, sizeof(int64_t*));
+    uint32_t** lengths = (uint32_t**) calloc(numColumns, sizeof(uint32_t*));
+    char** texts = (char**) calloc(numColumns, sizeof(char*));
+    while (fread(&count, sizeof(count), 1, file) == 1) {
+        int ok = 1;
+        for (uint32_t c = 0; c < numColumns && ok; ++c) {
+            if (types[c] != RESULTS_TEXT) {
+                numbers[c] = (int64_t*) realloc(numbers[c], (count + 1) * sizeof(int64_t));
+                ok = fread(numbers[c], sizeof(int64_t), count, file) == count;
+                continue;
+            }
+            lengths[c] = (uint32_t*) realloc(lengths[c], (count + 1) * sizeof(uint32_t));
+            ok = fread(lengths[c], sizeof(uint32_t), count, file) == count;
+            size_t total = 0;
+            for (uint32_t r = 0; ok && r < count; ++r) {
+                total += lengths[c][r];
+            }
+            texts[c] = (char*) realloc(texts[c], total + 1);
+            ok = ok && fread(texts[c], 1, total, file) == total;
+        }
+        if (!ok) {
+            fprintf(stderr, "%s ends in a truncated block after %ld rows.\n", argv[1], rows);
+            return 1;
+        }
+
+        size_t* offsets = (size_t*) calloc(numColumns, sizeof(size_t));
+        for (uint32_t r = 0; r < count; ++r) {
+            for (uint32_t c = 0; c < numColumns; ++c) {
+                if (c > 0) {
+                    printf(",");
+                }
+                if (types[c] == RESULTS_TEXT) {
+                    printf("%.*s", (int) lengths[c][r], texts[c] + offsets[c]);
+                    offsets[c] += lengths[c][r];
+                } else if (types[c] == RESULTS_DOUBLE) {
+                    double d;
+                    memcpy(&d, &numbers[c][r], sizeof(d));
+                    printf("%f", d);
+                } else {
+                    printf("%lld", (long long) numbers[c][r]);
+                }
+            }
+            printf("\n");
+        }
+        free(offsets);
+        rows += count;
+    }
+
+    for (uint32_t c = 0; c < numColumns; ++c) {
+        free(numbers[c]);
+        free(lengths[c]);
+        free(texts[c]);
+    }
+    free(numbers);
+    free(lengths);
+    free(texts);
+    free(types);
+    fclose(file);
+    return 0;
+}
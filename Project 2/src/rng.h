@@ -0,0 +1,56 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// A small seedable random number generator (xoshiro256**), so that every
+// generator thread gets its own reproducible stream instead of sharing rand()
+struct Rng {
+    uint64_t s[4];
+};
+
+// SplitMix64 step, used to expand one seed into the four state words
+static inline uint64_t splitMix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Function to seed a generator; different (seed, stream) pairs give independent sequences
+static inline void rngSeed(struct Rng* rng, uint64_t seed, uint64_t stream) {
+    uint64_t x = seed ^ (stream * 0xd1342543de82ef95ULL);
+    for (int i = 0; i < 4; ++i) {
+        rng->s[i] = splitMix64(&x);
+    }
+}
+
+static inline uint64_t rotl64(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// Function to draw the next 64 random bits
+static inline uint64_t rngNext(struct Rng* rng) {
+    uint64_t* s = rng->s;
+    uint64_t result = rotl64(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl64(s[3], 45);
+    return result;
+}
+
+// Function to draw a uniform integer in [0, n)
+static inline uint64_t rngBounded(struct Rng* rng, uint64_t n) {
+    return (uint64_t) (((unsigned __int128) rngNext(rng) * n) >> 64);
+}
+
+// Function to draw a uniform double in [0, 1)
+static inline double rngDouble(struct Rng* rng) {
+    return (rngNext(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+#endif
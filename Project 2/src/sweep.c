@@ -0,0 +1,762 @@
+// Build: gcc -O2 -pthread -o sweep sweep.c engine.c results.c graph.c arena.c minheap.c dheap.c trace.c dijkstra.c dijkstra_variants.c csr.c undirected.c workload.c memprofile.c "../../Project 1/src/sort.c" -lm
+// Usage: ./sweep [-a algorithms] [-s sizes] [-t thresholds] [-w workloads] [-V vertices]
+//                [-W weights] [-M max value] [-r repetitions] [-j jobs] [-c cpus] [-i] [-x] [-R]
+//                [-o output] [-S seed] [-l]
+// Benchmarks the engines registered in engine.c over the grid algorithm x size x threshold x
+// workload (x vertices for the shortest path engines) x repetition, several points at a time,
+// and writes one row per point.
+//   -a  engines, comma separated (default hybrid); -l lists them with their workloads
+//   -s  sizes: array length for the sorters, E for the shortest path engines
+//   -t  insertion sort thresholds, only used by the engines that take one (default 16)
+//   -w  workloads, each used by the engines it applies to (default random,uniform)
+//   -V  vertex counts for the shortest path engines (default 1000)
+//   -W  edge weight distribution: uniform, exponential, constant, euclidean (default uniform)
+//   -M  largest value of the random sorting workload (default 1000000)
+//   -j  points run at once (default one per CPU in -c), -c CPUs to pin them to, e.g. 0-3,6
+//   -i  isolate: points are set up concurrently but their timed sections never overlap
+//   -x  run the points one at a time in this process, for profilers, debuggers and PGO
+//       training runs (children leave with _exit() and write no profiles); peak RSS is then
+//       the largest since the previous timed section, and a crash ends the sweep
+//   -R  resume: skip points that already have an ok row in the output file
+//   -o  output file (default sweep_results.<ext>; RESULTS_FORMAT picks csv or jsonl)
+// Lists take single values and start:end:step ranges, e.g. -s 1000:1000000:1000,2000000.
+// Every point runs in a child process of its own, pinned to one CPU, so that points do not
+// share heaps, rand() state or the global key_comparisons counter.
+//
+// Memory columns (memprofile.h): peak_rss_kb is the peak resident set of the whole point,
+// input generation included; call_peak_rss_kb that of the timed call alone. allocations,
+// frees, alloc_bytes, alloc_peak_bytes (most heap bytes the call held at once), alloc_largest
+// and alloc_sizes ("class:count" with class c up to 2^c bytes) cover the allocations the
+// timed call made; they are -1 in sanitizer builds, which keep their own allocator.
+//
+// The grids of the coursework drivers (same points, per-point seeds), in one schema:
+//   withTime       ./sweep -a hybrid,heap -s 1000:10000000:10000 -t 1000 -M 10000000 -w random
+//   Cpart2         ./sweep -a hybrid -s 1000000 -t 1:100:1 -w random
+//   partB          ./sweep -a dijkstra -s 1000:999000:1000 -V 1000 -w uniform
+//   partB_fixedE   ./sweep -a dijkstra -s 500000 -V 1000:499000:1000 -w uniform
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <sched.h>
+#include <signal.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "graph.h"
+#include "dijkstra.h"
+#include "workload.h"
+#include "results.h"
+#include "engine.h"
+#include "memprofile.h"
+
+// One point of the grid
+struct SweepPoint {
+    const struct Engine* engine;
+    const char* workload;
+    long size;
+    int vertices;  // 0 for the sorters
+    int threshold; // 0 when the algorithm has none
+    int repetition;
+    uint64_t seed;
+};
+
+// What the child process measured
+struct PointResult {
+    double seconds;
+    long comparisons;
+    long peakRSS;
+    long callPeakRSS;
+    struct AllocStats alloc;
+    unsigned long checksum;
+    int ok;
+};
+
+// A growable list of longs parsed from the command line
+struct LongList {
+    long* values;
+    int count;
+};
+
+static const struct ResultsColumn sweepColumns[] = {
+    {"algorithm", RESULTS_TEXT}, {"workload", RESULTS_TEXT}, {"size", RESULTS_INT},
+    {"vertices", RESULTS_INT}, {"threshold", RESULTS_INT}, {"repetition", RESULTS_INT},
+    {"seed", RESULTS_INT}, {"cpu", RESULTS_INT}, {"comparisons", RESULTS_INT},
+    {"seconds", RESULTS_DOUBLE}, {"peak_rss_kb", RESULTS_INT}, {"call_peak_rss_kb", RESULTS_INT},
+    {"allocations", RESULTS_INT}, {"frees", RESULTS_INT}, {"alloc_bytes", RESULTS_INT},
+    {"alloc_peak_bytes", RESULTS_INT}, {"alloc_largest", RESULTS_INT}, {"alloc_sizes", RESULTS_TEXT},
+    {"checksum", RESULTS_INT}, {"status", RESULTS_TEXT},
+};
+static const int numSweepColumns = sizeof(sweepColumns) / sizeof(sweepColumns[0]);
+
+// Shared by the runner threads
+struct Sweep {
+    struct SweepPoint* points;
+    long numPoints;
+    long nextPoint;
+    long finished;
+    long failures;
+    int* cpus;
+    pthread_mutex_t outputLock;
+    struct ResultsSink* results;
+    pthread_mutex_t* timedLock;  // Process-shared, set with -i
+    int maxValue;                // Largest value of the random sorting workload
+    struct WeightSpec weights;   // Edge weights of the shortest path workloads
+    int inProcess;               // -x: no child processes, one point at a time
+};
+
+struct Runner {
+    struct Sweep* sweep;
+    int cpu;
+    pthread_t thread;
+};
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Function to parse "a,b,start:end:step,..." into list, returns -1 on a malformed item
+static int parseLongList(const char* text, struct LongList* list) {
+    char* copy = strdup(text);
+    int capacity = 16;
+    list->values = (long*) malloc(capacity * sizeof(long));
+    list->count = 0;
+
+    for (char* item = strtok(copy, ","); item != NULL; item = strtok(NULL, ",")) {
+        long start, end, step = 1;
+        int fields = sscanf(item, "%ld:%ld:%ld", &start, &end, &step);
+        if (fields == 1) {
+            end = start;
+        } else if (fields != 3 || step <= 0 || end < start) {
+            fprintf(stderr, "Bad list item %s, expected a value or start:end:step\n", item);
+            free(copy);
+            return -1;
+        }
+        for (long v = start; v <= end; v += step) {
+            if (list->count == capacity) {
+                capacity *= 2;
+                list->values = (long*) realloc(list->values, capacity * sizeof(long));
+            }
+            list->values[list->count++] = v;
+        }
+    }
+    free(copy);
+    return list->count > 0 ? 0 : -1;
+}
+
+// Function to parse a CPU list such as "0-3,6", returns the number of CPUs
+static int parseCPUList(const char* text, int** cpus) {
+    int count = 0;
+    *cpus = (int*) malloc(CPU_SETSIZE * sizeof(int));
+    char* copy = strdup(text);
+    for (char* item = strtok(copy, ","); item != NULL; item = strtok(NULL, ",")) {
+        int first, last;
+        if (sscanf(item, "%d-%d", &first, &last) != 2) {
+            last = first = atoi(item);
+        }
+        for (int c = first; c <= last && count < CPU_SETSIZE; ++c) {
+            (*cpus)[count++] = c;
+        }
+    }
+    free(copy);
+    return count;
+}
+
+// Function to derive the input seed of a point; every algorithm sees the same input
+static uint64_t pointSeed(uint64_t base, const char* workload, long size, int vertices, int repetition) {
+    uint64_t h = base ^ 0x9e3779b97f4a7c15ULL;
+    for (const char* p = workload; *p; ++p) {
+        h = (h ^ (unsigned char) *p) * 0x100000001b3ULL;
+    }
+    h = (h ^ (uint64_t) size) * 0x100000001b3ULL;
+    h = (h ^ (uint64_t) vertices) * 0x100000001b3ULL;
+    h = (h ^ (uint64_t) repetition) * 0x100000001b3ULL;
+    return h >> 33;  // Fits srand() and stays positive in an int64 column
+}
+
+// Function to build the key that identifies a point in the output, for resuming
+static void pointKey(char* key, size_t length, const char* algorithm, const char* workload, long size,
+                     long vertices, long threshold, long repetition) {
+    snprintf(key, length, "%s|%s|%ld|%ld|%ld|%ld", algorithm, workload, size, vertices, threshold, repetition);
+}
+
+static int compareKeys(const void* a, const void* b) {
+    return strcmp(*(char* const*) a, *(char* const*) b);
+}
+
+// Function to find the value of "name" in a JSON line, copied into value
+static int jsonField(const char* line, const char* name, char* value, size_t length) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", name);
+    const char* p = strstr(line, pattern);
+    if (p == NULL) {
+        return -1;
+    }
+    p += strlen(pattern);
+    if (*p == '"') {
+        p++;
+    }
+    size_t n = strcspn(p, "\",}");
+    if (n >= length) {
+        n = length - 1;
+    }
+    memcpy(value, p, n);
+    value[n] = '\0';
+    return 0;
+}
+
+// Function to split a CSV line in place into at most max fields, returns the number of fields.
+// Empty fields are kept, and quoted fields (as appendCSVText() in results.c writes them) are
+// unquoted, so every field lands at its column.
+static int splitCSVLine(char* line, char** fields, int max) {
+    int count = 0;
+    char* p = line;
+    while (count < max) {
+        char* out = p;
+        fields[count++] = out;
+        if (*p == '"') {
+            p++;
+            while (*p != '\0' && !(*p == '"' && p[1] != '"')) {
+                if (*p == '"') {
+                    p++;  // "" stands for one quote
+                }
+                *out++ = *p++;
+            }
+            if (*p == '"') {
+                p++;
+            }
+        }
+        while (*p != '\0' && *p != ',' && *p != '\r' && *p != '\n') {
+            *out++ = *p++;
+        }
+        char end = *p;
+        *out = '\0';
+        if (end != ',') {
+            break;
+        }
+        p++;
+    }
+    return count;
+}
+
+// Function to collect the keys of the points that finished ok in an earlier run.
+// Returns the number of keys (sorted for bsearch), 0 if the file does not exist.
+static long loadFinishedKeys(const char* filename, enum ResultsFormat format, char*** keys) {
+    *keys = NULL;
+    FILE* file = fopen(filename, "r");
+    if (file == NULL) {
+        return 0;
+    }
+
+    static const char* keyColumns[] = {"algorithm", "workload", "size", "vertices", "threshold", "repetition", "status"};
+    int index[7];
+    char line[4096];
+    char* fields[256];
+    long count = 0, capacity = 0;
+
+    if (format == RESULTS_CSV) {
+        if (fgets(line, sizeof(line), file) == NULL) {
+            fclose(file);
+            return 0;
+        }
+        int numFields = splitCSVLine(line, fields, 256);
+        for (int k = 0; k < 7; ++k) {
+            index[k] = -1;
+            for (int column = 0; column < numFields; ++column) {
+                if (strcmp(fields[column], keyColumns[k]) == 0) {
+                    index[k] = column;
+                }
+            }
+            if (index[k] < 0) {
+                fprintf(stderr, "%s has no %s column, not resuming from it.\n", filename, keyColumns[k]);
+                fclose(file);
+                return -1;
+            }
+        }
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char values[7][256];
+        int found = 0;
+        if (format == RESULTS_CSV) {
+            int numFields = splitCSVLine(line, fields, 256);
+            for (int k = 0; k < 7; ++k) {
+                if (index[k] < numFields) {
+                    snprintf(values[k], sizeof(values[k]), "%s", fields[index[k]]);
+                    found++;
+                }
+            }
+        } else {
+            for (int k = 0; k < 7; ++k) {
+                found += jsonField(line, keyColumns[k], values[k], sizeof(values[k])) == 0;
+            }
+        }
+        if (found != 7 || strcmp(values[6], "ok") != 0) {
+            continue;
+        }
+
+        if (count == capacity) {
+            capacity = capacity ? 2 * capacity : 1024;
+            *keys = (char**) realloc(*keys, capacity * sizeof(char*));
+        }
+        char key[1024];
+        pointKey(key, sizeof(key), values[0], values[1], atol(values[2]), atol(values[3]), atol(values[4]),
+                 atol(values[5]));
+        (*keys)[count++] = strdup(key);
+    }
+    fclose(file);
+    qsort(*keys, count, sizeof(char*), compareKeys);
+    return count;
+}
+
+static unsigned long mixChecksum(unsigned long checksum, long value) {
+    return (checksum ^ (unsigned long) value) * 0x100000001b3UL;
+}
+
+static void lockTimed(pthread_mutex_t* lock) {
+    if (lock != NULL && pthread_mutex_lock(lock) == EOWNERDEAD) {
+        pthread_mutex_consistent(lock);  // A child died while timing; the lock is still good
+    }
+}
+
+static void unlockTimed(pthread_mutex_t* lock) {
+    if (lock != NULL) {
+        pthread_mutex_unlock(lock);
+    }
+}
+
+// Function to start measuring the memory of a timed section. Resetting the peak resident set
+// also resets ru_maxrss, so the peak of the point so far is taken first.
+static void beginMemoryProfile(struct PointResult* result) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    result->peakRSS = usage.ru_maxrss;
+    resetPeakRSS();
+    resetAllocStats();
+}
+
+// Function to finish measuring the memory of a timed section; allocations first, since
+// reading the resident set allocates
+static void endMemoryProfile(struct PointResult* result) {
+    readAllocStats(&result->alloc);
+    result->callPeakRSS = readPeakRSS();
+}
+
+// Function to run a sorting point, in the child
+static void runSortPoint(const struct Sweep* sweep, const struct SweepPoint* point, struct PointResult* result) {
+    struct SortInput input;
+    input.n = (int) point->size;
+    input.threshold = point->threshold;
+    input.arr = (int*) malloc((input.n > 0 ? input.n : 1) * sizeof(int));
+    input.scratchSize = point->engine->scratchSize != NULL ? point->engine->scratchSize(input.n) : 0;
+    input.scratch = (int*) malloc((input.scratchSize > 0 ? input.scratchSize : 1) * sizeof(int));
+    generateSortInput(point->workload, input.arr, input.n, sweep->maxValue, point->seed);
+
+    lockTimed(sweep->timedLock);
+    beginMemoryProfile(result);
+    double start = nowSeconds();
+    result->comparisons = point->engine->sort(&input);
+    result->seconds = nowSeconds() - start;
+    endMemoryProfile(result);
+    unlockTimed(sweep->timedLock);
+
+    result->ok = 1;
+    for (int i = 0; i < input.n; i++) {
+        if (i > 0 && input.arr[i - 1] > input.arr[i]) {
+            result->ok = 0;
+        }
+        result->checksum = mixChecksum(result->checksum, input.arr[i]);
+    }
+    free(input.scratch);
+    free(input.arr);
+}
+
+// Function to run a shortest path point, in the child
+static void runSSSPPoint(const struct Sweep* sweep, const struct SweepPoint* point, struct PointResult* result) {
+    struct SSSPInput input;
+    input.graph = generateWorkloadGraph((enum WorkloadType) parseWorkload(point->workload), point->vertices,
+                                        point->size, &sweep->weights, point->seed);
+    input.csr = point->engine->needsCSR ? graphToCSR(input.graph) : NULL;
+    input.csr16 = point->engine->needsCSR == 2 ? narrowCSRWeights(input.csr) : NULL;
+    input.src = 0;
+    input.wideDist = point->engine->distSize ? malloc((size_t) point->vertices * point->engine->distSize) : NULL;
+    int* dist = (int*) malloc(point->vertices * sizeof(int));
+
+    lockTimed(sweep->timedLock);
+    beginMemoryProfile(result);
+    double start = nowSeconds();
+    result->comparisons = point->engine->sssp(&input, dist);
+    result->seconds = nowSeconds() - start;
+    endMemoryProfile(result);
+    unlockTimed(sweep->timedLock);
+    narrowDistances(point->engine, &input, dist);
+
+    result->ok = dist[input.src] == 0;
+    for (int v = 0; v < point->vertices; ++v) {
+        result->checksum = mixChecksum(result->checksum, dist[v]);
+    }
+    free(dist);
+    free(input.wideDist);
+    if (input.csr16 != NULL) {
+        freeCSRGraph16(input.csr16);
+    }
+    if (input.csr != NULL) {
+        freeCSRGraph(input.csr);
+    }
+    freeGraph(input.graph);
+}
+
+// Function to run one point on cpu in the calling process
+static void measurePoint(const struct Sweep* sweep, const struct SweepPoint* point, int cpu, struct PointResult* result) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+
+    if (point->engine->family == ENGINE_SORT) {
+        runSortPoint(sweep, point, result);
+    } else {
+        runSSSPPoint(sweep, point, result);
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    if (usage.ru_maxrss > result->peakRSS) {
+        result->peakRSS = usage.ru_maxrss;
+    }
+}
+
+// Function to run one point in a child pinned to cpu (or in this process with -x),
+// returns 0 if the child reported back
+static int runPoint(const struct Sweep* sweep, const struct SweepPoint* point, int cpu, struct PointResult* result) {
+    if (sweep->inProcess) {
+        measurePoint(sweep, point, cpu, result);
+        return 0;
+    }
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        return -1;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+    if (pid == 0) {
+        // Die with the runner, and take the default action on the signals the results sink
+        // keeps for itself in the runner
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        sigaddset(&signals, SIGHUP);
+        pthread_sigmask(SIG_UNBLOCK, &signals, NULL);
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+
+        close(fds[0]);
+        struct PointResult child;
+        memset(&child, 0, sizeof(child));
+        measurePoint(sweep, point, cpu, &child);
+        // _exit: exit() would run the results sink's atexit flush, whose writer thread
+        // does not exist in the child
+        _exit(write(fds[1], &child, sizeof(child)) == sizeof(child) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    ssize_t got = read(fds[0], result, sizeof(*result));
+    close(fds[0]);
+    int status;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+    return got == sizeof(*result) && WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : -1;
+}
+
+static void* runnerMain(void* arg) {
+    struct Runner* runner = (struct Runner*) arg;
+    struct Sweep* sweep = runner->sweep;
+
+    for (;;) {
+        long i = __atomic_fetch_add(&sweep->nextPoint, 1, __ATOMIC_RELAXED);
+        if (i >= sweep->numPoints) {
+            break;
+        }
+        const struct SweepPoint* point = &sweep->points[i];
+        struct PointResult result;
+        memset(&result, 0, sizeof(result));
+        int reported = runPoint(sweep, point, runner->cpu, &result) == 0;
+        const char* status = !reported ? "crashed" : result.ok ? "ok" : "wrong";
+
+        pthread_mutex_lock(&sweep->outputLock);
+        addResultText(sweep->results, point->engine->name);
+        addResultText(sweep->results, point->workload);
+        addResultInt(sweep->results, point->size);
+        addResultInt(sweep->results, point->vertices);
+        addResultInt(sweep->results, point->threshold);
+        addResultInt(sweep->results, point->repetition);
+        addResultInt(sweep->results, (long) point->seed);
+        addResultInt(sweep->results, runner->cpu);
+        addResultInt(sweep->results, result.comparisons);
+        addResultDouble(sweep->results, result.seconds);
+        addResultInt(sweep->results, result.peakRSS);
+        addResultInt(sweep->results, result.callPeakRSS);
+        const struct AllocStats* alloc = &result.alloc;
+        int counted = allocStatsEnabled();
+        char sizes[512];
+        formatSizeClasses(alloc, sizes, sizeof(sizes));
+        addResultInt(sweep->results, counted ? alloc->allocations : -1);
+        addResultInt(sweep->results, counted ? alloc->frees : -1);
+        addResultInt(sweep->results, counted ? alloc->bytes : -1);
+        addResultInt(sweep->results, counted ? alloc->peakBytes : -1);
+        addResultInt(sweep->results, counted ? alloc->largest : -1);
+        addResultText(sweep->results, counted ? sizes : "");
+        addResultInt(sweep->results, (long) (result.checksum >> 1));
+        addResultText(sweep->results, status);
+        endResultsRow(sweep->results);
+
+        sweep->finished++;
+        sweep->failures += strcmp(status, "ok") != 0;
+        printf("[%ld/%ld] cpu %d %s %s size=%ld V=%d threshold=%d rep=%d: %.6f s, %ld comparisons, %s\n",
+               sweep->finished, sweep->numPoints, runner->cpu, point->engine->name,
+               point->workload, point->size, point->vertices, point->threshold, point->repetition,
+               result.seconds, result.comparisons, status);
+        fflush(stdout);
+        pthread_mutex_unlock(&sweep->outputLock);
+    }
+    return NULL;
+}
+
+// Function to print the registered engines and the workloads they take
+static void listEngines(void) {
+    printf("Engines:\n");
+    for (int i = 0; i < numEngines; ++i) {
+        printf("  %-20s %-5s %s%s\n", engines[i].name, engines[i].family == ENGINE_SORT ? "sort" : "sssp",
+               engines[i].description, engines[i].usesThreshold ? " (takes -t)" : "");
+    }
+    printf("Sort workloads:");
+    for (int w = 0; w < numSortWorkloads; ++w) {
+        printf(" %s", sortWorkloads[w]);
+    }
+    printf("\nSSSP workloads:");
+    for (int w = WORKLOAD_UNIFORM; w <= WORKLOAD_GEOMETRIC; ++w) {
+        printf(" %s", workloadName((enum WorkloadType) w));
+    }
+    printf("\n");
+}
+
+int main(int argc, char* argv[]) {
+    const char* algorithmList = "hybrid";
+    const char* sizeList = "1000:100000:1000";
+    const char* thresholdList = "16";
+    const char* workloadList = "random,uniform";
+    const char* vertexList = "1000";
+    const char* output = NULL;
+    const char* cpuList = NULL;
+    int repetitions = 1, jobs = 0, isolate = 0, resume = 0, inProcess = 0, maxValue = 1000000;
+    struct WeightSpec weights = {WEIGHT_UNIFORM, 1, 10};
+    uint64_t seedBase = 1;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "a:s:t:w:V:W:M:r:j:c:ixRo:S:l")) != -1) {
+        switch (opt) {
+        case 'a': algorithmList = optarg; break;
+        case 's': sizeList = optarg; break;
+        case 't': thresholdList = optarg; break;
+        case 'w': workloadList = optarg; break;
+        case 'V': vertexList = optarg; break;
+        case 'W': weights.distribution = (enum WeightDistribution) parseWeightDistribution(optarg); break;
+        case 'M': maxValue = atoi(optarg); break;
+        case 'r': repetitions = atoi(optarg); break;
+        case 'j': jobs = atoi(optarg); break;
+        case 'c': cpuList = optarg; break;
+        case 'i': isolate = 1; break;
+        case 'x': inProcess = 1; break;
+        case 'R': resume = 1; break;
+        case 'o': output = optarg; break;
+        case 'S': seedBase = strtoull(optarg, NULL, 10); break;
+        case 'l': listEngines(); return 0;
+        default:
+            fprintf(stderr, "Usage: sweep [-a algorithms] [-s sizes] [-t thresholds] [-w workloads] [-V vertices]\n"
+                            "             [-W weights] [-M max value] [-r repetitions] [-j jobs] [-c cpus] [-i] [-x] [-R]\n"
+                            "             [-o output] [-S seed] [-l]\n");
+            return 1;
+        }
+    }
+    if ((int) weights.distribution < 0 || maxValue <= 0) {
+        fprintf(stderr, "Unknown weight distribution or bad maximum value.\n");
+        return 1;
+    }
+
+    struct LongList sizes, thresholds, vertices;
+    if (parseLongList(sizeList, &sizes) != 0 || parseLongList(thresholdList, &thresholds) != 0 ||
+        parseLongList(vertexList, &vertices) != 0 || repetitions <= 0) {
+        return 1;
+    }
+
+    // CPUs: the -c list, or every CPU this process may run on
+    int* cpus;
+    int numCPUs;
+    if (cpuList != NULL) {
+        numCPUs = parseCPUList(cpuList, &cpus);
+    } else {
+        cpu_set_t allowed;
+        sched_getaffinity(0, sizeof(allowed), &allowed);
+        cpus = (int*) malloc(CPU_SETSIZE * sizeof(int));
+        numCPUs = 0;
+        for (int c = 0; c < CPU_SETSIZE; ++c) {
+            if (CPU_ISSET(c, &allowed)) {
+                cpus[numCPUs++] = c;
+            }
+        }
+    }
+    if (numCPUs == 0) {
+        fprintf(stderr, "No CPUs to run on.\n");
+        return 1;
+    }
+    if (jobs <= 0 || inProcess) {
+        jobs = inProcess ? 1 : numCPUs;
+    }
+
+    enum ResultsFormat format = defaultResultsFormat();
+    if (format == RESULTS_COLUMNAR && resume) {
+        fprintf(stderr, "Resuming needs csv or jsonl output.\n");
+        return 1;
+    }
+    char defaultOutput[64];
+    if (output == NULL) {
+        snprintf(defaultOutput, sizeof(defaultOutput), "sweep_results.%s", resultsFormatExtension(format));
+        output = defaultOutput;
+    }
+
+    char** finishedKeys = NULL;
+    long numFinished = resume ? loadFinishedKeys(output, format, &finishedKeys) : 0;
+    if (numFinished < 0) {
+        return 1;
+    }
+
+    // Expand the grid, skipping workloads that do not apply and points already done
+    char* workloads = strdup(workloadList);
+    const char* workloadNames[64];
+    int numWorkloads = 0;
+    for (char* w = strtok(workloads, ","); w != NULL && numWorkloads < 64; w = strtok(NULL, ",")) {
+        if (!isSortWorkload(w) && parseWorkload(w) < 0) {
+            fprintf(stderr, "Unknown workload %s\n", w);
+            return 1;
+        }
+        workloadNames[numWorkloads++] = w;
+    }
+
+    struct Sweep sweep;
+    memset(&sweep, 0, sizeof(sweep));
+    sweep.maxValue = maxValue;
+    sweep.weights = weights;
+    sweep.inProcess = inProcess;
+    long capacity = 1024, skipped = 0;
+    sweep.points = (struct SweepPoint*) malloc(capacity * sizeof(struct SweepPoint));
+
+    char* algorithmCopy = strdup(algorithmList);
+    for (char* name = strtok(algorithmCopy, ","); name != NULL; name = strtok(NULL, ",")) {
+        const struct Engine* engine = findEngine(name);
+        if (engine == NULL) {
+            fprintf(stderr, "Unknown algorithm %s, see sweep -l\n", name);
+            return 1;
+        }
+        int sort = engine->family == ENGINE_SORT;
+        for (int w = 0; w < numWorkloads; ++w) {
+            if (isSortWorkload(workloadNames[w]) != sort) {
+                continue;
+            }
+            for (int s = 0; s < sizes.count; ++s) {
+                for (int t = 0; t < (engine->usesThreshold ? thresholds.count : 1); ++t) {
+                    for (int v = 0; v < (sort ? 1 : vertices.count); ++v) {
+                        for (int r = 0; r < repetitions; ++r) {
+                            struct SweepPoint point = {engine, workloadNames[w], sizes.values[s],
+                                                       sort ? 0 : (int) vertices.values[v],
+                                                       engine->usesThreshold ? (int) thresholds.values[t] : 0, r, 0};
+                            point.seed = pointSeed(seedBase, point.workload, point.size, point.vertices, r);
+
+                            char key[1024];
+                            char* keyPointer = key;
+                            pointKey(key, sizeof(key), name, point.workload, point.size, point.vertices,
+                                     point.threshold, r);
+                            if (numFinished > 0 &&
+                                bsearch(&keyPointer, finishedKeys, numFinished, sizeof(char*), compareKeys) != NULL) {
+                                skipped++;
+                                continue;
+                            }
+                            if (sweep.numPoints == capacity) {
+                                capacity *= 2;
+                                sweep.points = (struct SweepPoint*) realloc(sweep.points, capacity * sizeof(struct SweepPoint));
+                            }
+                            sweep.points[sweep.numPoints++] = point;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    printf("%ld points to run (%ld already done) on %d CPUs with %d jobs%s, results in %s\n", sweep.numPoints,
+           skipped, numCPUs, jobs, isolate ? ", timed sections isolated" : "", output);
+
+    // Open the sink before starting any thread, so that they all leave the signals to it
+    sweep.results = openResultsSink(output, format, sweepColumns, numSweepColumns, resume);
+    if (sweep.results == NULL) {
+        return 1;
+    }
+    pthread_mutex_init(&sweep.outputLock, NULL);
+
+    if (isolate) {
+        // A robust, process-shared mutex in shared memory that every child can take
+        sweep.timedLock = (pthread_mutex_t*) mmap(NULL, sizeof(pthread_mutex_t), PROT_READ | PROT_WRITE,
+                                                  MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(sweep.timedLock, &attr);
+        pthread_mutexattr_destroy(&attr);
+    }
+
+    double start = nowSeconds();
+    struct Runner* runners = (struct Runner*) malloc(jobs * sizeof(struct Runner));
+    for (int j = 0; j < jobs; ++j) {
+        runners[j].sweep = &sweep;
+        runners[j].cpu = cpus[j % numCPUs];
+        pthread_create(&runners[j].thread, NULL, runnerMain, &runners[j]);
+    }
+    for (int j = 0; j < jobs; ++j) {
+        pthread_join(runners[j].thread, NULL);
+    }
+    double elapsed = nowSeconds() - start;
+
+    int status = closeResultsSink(sweep.results);
+    printf("Ran %ld points in %.3f s (%ld failed)\n", sweep.finished, elapsed, sweep.failures);
+    printf("Results have been saved to %s\n", output);
+
+    for (long i = 0; i < numFinished; ++i) {
+        free(finishedKeys[i]);
+    }
+    free(finishedKeys);
+    free(runners);
+    free(sweep.points);
+    free(sizes.values);
+    free(thresholds.values);
+    free(vertices.values);
+    free(cpus);
+    free(workloads);
+    free(algorithmCopy);
+    return status != 0 || sweep.failures != 0;
+}
@@ -0,0 +1,368 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+
+#include "trace.h"
+#include "minheap.h"
+#include "dheap.h"
+
+// File layout: "PQTR", uint32 version, uint64 operation count, then one record per operation:
+// a varint of (v << 2 | type), followed for every type but TRACE_RESET by a zigzag varint of
+// the key minus the last extracted key. Dijkstra's keys stay close to the last extracted one,
+// so most records take two to four bytes.
+#define TRACE_VERSION 1
+
+// Function to set up an empty trace
+void initTrace(struct Trace* trace) {
+    trace->count = 0;
+    trace->capacity = 0;
+    trace->ops = NULL;
+    trace->file = NULL;
+    trace->lastPopped = 0;
+}
+
+static void writeVarint(FILE* file, uint64_t x) {
+    while (x >= 0x80) {
+        putc((int) (x & 0x7f) | 0x80, file);
+        x >>= 7;
+    }
+    putc((int) x, file);
+}
+
+// Function to read a varint, returns -1 at end of file
+static int readVarint(FILE* file, uint64_t* x) {
+    *x = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = getc(file);
+        if (c == EOF) {
+            return -1;
+        }
+        *x |= (uint64_t) (c & 0x7f) << shift;
+        if (!(c & 0x80)) {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// Function to encode one operation record
+static void writeOp(struct Trace* trace, int type, int v, int key) {
+    writeVarint(trace->file, ((uint64_t) v << 2) | (uint64_t) type);
+    if (type == TRACE_RESET) {
+        trace->lastPopped = 0;
+        return;
+    }
+
+    int64_t delta = (int64_t) key - trace->lastPopped;
+    writeVarint(trace->file, ((uint64_t) delta << 1) ^ (uint64_t) (delta >> 63));
+    if (type == TRACE_POP) {
+        trace->lastPopped = key;
+    }
+}
+
+// Function to append one operation
+void appendTraceOp(struct Trace* trace, int type, int v, int key) {
+    if (trace->file != NULL) {
+        writeOp(trace, type, v, key);
+        trace->count++;
+        return;
+    }
+
+    if (trace->count == trace->capacity) {
+        trace->capacity = trace->capacity ? 2 * trace->capacity : 4096;
+        trace->ops = (struct TraceOp*) realloc(trace->ops, trace->capacity * sizeof(struct TraceOp));
+    }
+    trace->ops[trace->count].type = type;
+    trace->ops[trace->count].v = v;
+    trace->ops[trace->count].key = key;
+    trace->count++;
+}
+
+void freeTrace(struct Trace* trace) {
+    free(trace->ops);
+    initTrace(trace);
+}
+
+// Function to write the file header; the count is patched in by closeTraceFile()
+static void writeHeader(FILE* file, uint64_t count) {
+    uint32_t version = TRACE_VERSION;
+    fwrite("PQTR", 1, 4, file);
+    fwrite(&version, sizeof(version), 1, file);
+    fwrite(&count, sizeof(count), 1, file);
+}
+
+// Function to start streaming a trace to a file
+int openTraceFile(struct Trace* trace, const char* filename) {
+    initTrace(trace);
+    trace->file = fopen(filename, "wb");
+    if (trace->file == NULL) {
+        fprintf(stderr, "Error opening %s for writing.\n", filename);
+        return -1;
+    }
+    writeHeader(trace->file, 0);
+    return 0;
+}
+
+// Function to finish a streaming trace
+int closeTraceFile(struct Trace* trace) {
+    FILE* file = trace->file;
+    trace->file = NULL;
+
+    fseek(file, 0, SEEK_SET);
+    writeHeader(file, (uint64_t) trace->count);
+    if (ferror(file) | fclose(file)) {
+        fprintf(stderr, "Error writing the trace file.\n");
+        return -1;
+    }
+    return 0;
+}
+
+// Function to write an in-memory trace to a file
+int saveTrace(struct Trace* trace, const char* filename) {
+    struct Trace stream;
+    if (openTraceFile(&stream, filename) != 0) {
+        return -1;
+    }
+    for (long i = 0; i < trace->count; ++i) {
+        appendTraceOp(&stream, trace->ops[i].type, trace->ops[i].v, trace->ops[i].key);
+    }
+    return closeTraceFile(&stream);
+}
+
+// What a trace being read has done to its heap so far, to turn down operations that would make
+// a backend index out of bounds. Every operation must fit a Dijkstra run: the first one is a
+// RESET, vertices are below its capacity, a vertex is pushed once, decreased or popped only while
+// it is in the heap, keys only go down and never below the last popped key.
+struct TraceCheck {
+    int capacity;     // Of the last RESET, -1 before the first one
+    int allocated;
+    char *state;      // 0 not pushed yet, 1 in the heap, 2 popped
+    int *keys;
+    int64_t lastPopped;
+};
+
+// Function to check one decoded operation, returns NULL if it is valid or else what is wrong
+static const char* checkTraceOp(struct TraceCheck* check, int type, uint64_t v, int64_t key) {
+    if (type == TRACE_RESET) {
+        if (v >= INT_MAX) {
+            return "heap capacity out of range";
+        }
+        if ((int) v > check->allocated) {
+            check->allocated = (int) v;
+            check->state = (char*) realloc(check->state, v);
+            check->keys = (int*) realloc(check->keys, v * sizeof(int));
+        }
+        check->capacity = (int) v;
+        if (v > 0) {
+            memset(check->state, 0, v);
+        }
+        check->lastPopped = 0;
+        return NULL;
+    }
+
+    if (check->capacity < 0) {
+        return "operation before the first RESET";
+    }
+    if (v >= (uint64_t) check->capacity) {
+        return "vertex beyond the heap capacity";
+    }
+    if (key < check->lastPopped || key > INT_MAX) {
+        return "key out of range";
+    }
+    char* state = &check->state[v];
+    if (type == TRACE_PUSH) {
+        if (*state != 0) {
+            return "vertex pushed twice";
+        }
+        *state = 1;
+    } else if (*state != 1) {
+        return "vertex not in the heap";
+    } else if (type == TRACE_DECREASE) {
+        if (key >= check->keys[v]) {
+            return "key does not decrease";
+        }
+    } else {
+        if (key != check->keys[v]) {
+            return "popped key differs from the pushed one";
+        }
+        *state = 2;
+        check->lastPopped = key;
+    }
+    check->keys[v] = (int) key;
+    return NULL;
+}
+
+// Function to read a trace written by saveTrace()
+int loadTrace(struct Trace* trace, const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening %s for reading.\n", filename);
+        return -1;
+    }
+
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+    if (fread(magic, 1, 4, file) != 4 || memcmp(magic, "PQTR", 4) != 0 ||
+        fread(&version, sizeof(version), 1, file) != 1 || version != TRACE_VERSION ||
+        fread(&count, sizeof(count), 1, file) != 1) {
+        fprintf(stderr, "%s is not a version %d PQTR trace.\n", filename, TRACE_VERSION);
+        fclose(file);
+        return -1;
+    }
+
+    initTrace(trace);
+    struct TraceCheck check = {-1, 0, NULL, NULL, 0};
+    const char* problem = NULL;
+    for (uint64_t i = 0; i < count && problem == NULL; ++i) {
+        uint64_t head, zigzag = 0;
+        if (readVarint(file, &head) != 0) {
+            break;
+        }
+        int type = (int) (head & 3);
+        uint64_t v = head >> 2;
+        int64_t key = 0;
+        if (type != TRACE_RESET) {
+            if (readVarint(file, &zigzag) != 0) {
+                break;
+            }
+            int64_t delta = (int64_t) ((zigzag >> 1) ^ -(zigzag & 1));
+            key = delta > INT_MAX || delta < INT_MIN ? -1 : check.lastPopped + delta;
+        }
+
+        problem = checkTraceOp(&check, type, v, key);
+        if (problem == NULL) {
+            appendTraceOp(trace, type, (int) v, (int) key);
+        }
+    }
+    fclose(file);
+    free(check.state);
+    free(check.keys);
+
+    if (problem != NULL) {
+        fprintf(stderr, "%s: operation %ld: %s.\n", filename, trace->count, problem);
+        freeTrace(trace);
+        return -1;
+    }
+    if ((uint64_t) trace->count != count) {
+        fprintf(stderr, "%s is truncated: %ld of %llu operations.\n", filename, trace->count,
+                (unsigned long long) count);
+        freeTrace(trace);
+        return -1;
+    }
+    return 0;
+}
+
+// struct MinHeap as a backend, with one preallocated node per vertex
+struct BinaryPQ {
+    struct MinHeap *minHeap;
+    struct MinHeapNode *nodes;
+};
+
+static void* binaryCreate(int capacity) {
+    struct BinaryPQ* pq = (struct BinaryPQ*) malloc(sizeof(struct BinaryPQ));
+    pq->minHeap = createMinHeap(capacity);
+    pq->nodes = (struct MinHeapNode*) malloc(capacity * sizeof(struct MinHeapNode));
+    return pq;
+}
+
+static void binaryDestroy(void* pq) {
+    struct BinaryPQ* binary = (struct BinaryPQ*) pq;
+    freeMinHeap(binary->minHeap);
+    free(binary->nodes);
+    free(binary);
+}
+
+static void binaryPush(void* pq, int v, int key, int* comparisonCount) {
+    struct BinaryPQ* binary = (struct BinaryPQ*) pq;
+    binary->nodes[v].v = v;
+    binary->nodes[v].dist = key;
+    insertMinHeap(binary->minHeap, &binary->nodes[v], comparisonCount);
+}
+
+static void binaryDecrease(void* pq, int v, int key, int* comparisonCount) {
+    decreaseKey(((struct BinaryPQ*) pq)->minHeap, v, key, comparisonCount);
+}
+
+static int binaryPop(void* pq, int* key, int* comparisonCount) {
+    struct MinHeapNode* node = extractMin(((struct BinaryPQ*) pq)->minHeap, comparisonCount);
+    *key = node->dist;
+    return node->v;
+}
+
+// struct DaryHeap as a backend
+static void* daryCreate(int capacity) {
+    return createDaryHeap(capacity);
+}
+
+static void daryDestroy(void* pq) {
+    freeDaryHeap((struct DaryHeap*) pq);
+}
+
+static void daryPushOp(void* pq, int v, int key, int* comparisonCount) {
+    daryPush((struct DaryHeap*) pq, v, key, comparisonCount);
+}
+
+static void daryDecreaseOp(void* pq, int v, int key, int* comparisonCount) {
+    daryDecreaseKey((struct DaryHeap*) pq, v, key, comparisonCount);
+}
+
+static int daryPopOp(void* pq, int* key, int* comparisonCount) {
+    return daryPopMin((struct DaryHeap*) pq, key, comparisonCount);
+}
+
+const struct PQBackend pqBackends[] = {
+    {"binary", binaryCreate, binaryDestroy, binaryPush, binaryDecrease, binaryPop},
+    {"4ary", daryCreate, daryDestroy, daryPushOp, daryDecreaseOp, daryPopOp},
+};
+const int numPQBackends = sizeof(pqBackends) / sizeof(pqBackends[0]);
+
+// Function to look a backend up by name, NULL if unknown
+const struct PQBackend* findPQBackend(const char* name) {
+    for (int i = 0; i < numPQBackends; ++i) {
+        if (strcmp(pqBackends[i].name, name) == 0) {
+            return &pqBackends[i];
+        }
+    }
+    return NULL;
+}
+
+// Function to replay a trace on a backend, returning a checksum of the popped keys
+unsigned long replayTrace(struct Trace* trace, const struct PQBackend* backend,
+                          int* comparisonCount, long* mismatches) {
+    void* pq = NULL;
+    unsigned long checksum = 0;
+
+    for (long i = 0; i < trace->count; ++i) {
+        struct TraceOp* op = &trace->ops[i];
+        switch (op->type) {
+        case TRACE_RESET:
+            if (pq != NULL) {
+                backend->destroy(pq);
+            }
+            pq = backend->create(op->v);
+            break;
+        case TRACE_PUSH:
+            backend->push(pq, op->v, op->key, comparisonCount);
+            break;
+        case TRACE_DECREASE:
+            backend->decrease(pq, op->v, op->key, comparisonCount);
+            break;
+        default: {
+            // Ties may come out in another order, but the keys must match
+            int key;
+            backend->pop(pq, &key, comparisonCount);
+            checksum = checksum * 31 + (unsigned long) key;
+            *mismatches += key != op->key;
+            break;
+        }
+        }
+    }
+
+    if (pq != NULL) {
+        backend->destroy(pq);
+    }
+    return checksum;
+}
@@ -0,0 +1,70 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+
+// Priority queue traces: the push / decrease-key / extract-min sequence of Dijkstra runs,
+// with keys, so that heap implementations can be compared on exactly the same workload.
+
+enum TraceOpType {
+    TRACE_RESET,     // A new run starts with an empty heap; v is the heap capacity
+    TRACE_PUSH,      // Insert v with key
+    TRACE_DECREASE,  // Lower the key of v to key
+    TRACE_POP        // Extract the minimum; key is the key that came out
+};
+
+struct TraceOp {
+    int type;
+    int v;
+    int key;
+};
+
+// A trace either holds its operations in ops[] or, after openTraceFile(), streams them to a file
+struct Trace {
+    long count;
+    long capacity;
+    struct TraceOp *ops;
+    FILE *file;      // Output of a streaming trace, NULL otherwise
+    int lastPopped;  // Encoder state of a streaming trace
+};
+
+// A priority queue implementation the replayer can drive
+struct PQBackend {
+    const char* name;
+    void* (*create)(int capacity);
+    void (*destroy)(void* pq);
+    void (*push)(void* pq, int v, int key, int* comparisonCount);
+    void (*decrease)(void* pq, int v, int key, int* comparisonCount);
+    int (*pop)(void* pq, int* key, int* comparisonCount);  // Returns the vertex, stores its key
+};
+
+// Every backend the replayer knows about
+extern const struct PQBackend pqBackends[];
+extern const int numPQBackends;
+
+// Function to look a backend up by name, NULL if unknown
+const struct PQBackend* findPQBackend(const char* name);
+
+// Functions to build a trace
+void initTrace(struct Trace* trace);
+void appendTraceOp(struct Trace* trace, int type, int v, int key);
+void freeTrace(struct Trace* trace);
+
+// Function to start streaming a trace to a file in the compact "PQTR" format, so that long
+// runs need no memory for it; closeTraceFile() finishes the file. Both return 0 on success.
+int openTraceFile(struct Trace* trace, const char* filename);
+int closeTraceFile(struct Trace* trace);
+
+// Function to write an in-memory trace to a file, returns 0 on success
+int saveTrace(struct Trace* trace, const char* filename);
+
+// Function to read a trace written by saveTrace(), returns 0 on success. Traces whose operations
+// could not come from a Dijkstra run (and could make a backend index out of bounds) are refused.
+int loadTrace(struct Trace* trace, const char* filename);
+
+// Function to replay a trace on a backend. Returns a checksum of the popped keys, which is
+// the same for every correct backend; *mismatches counts pops whose key differs from the trace.
+unsigned long replayTrace(struct Trace* trace, const struct PQBackend* backend,
+                          int* comparisonCount, long* mismatches);
+
+#endif
@@ -0,0 +1,77 @@
+// Build: gcc -O2 -o trace_replay trace_replay.c trace.c minheap.c dheap.c arena.c
+// Usage: ./trace_replay <trace file> [backend|all] [repetitions]
+// Replays a heap trace recorded by partB / partB_fixedE (or any driver that calls
+// setDijkstraTrace()) on the priority queues listed in pqBackends[].
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "trace.h"
+
+// Function to read a monotonic clock in seconds
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: trace_replay <trace file> [backend|all] [repetitions]\n");
+        return 1;
+    }
+    const char* which = argc > 2 ? argv[2] : "all";
+    int repetitions = argc > 3 ? atoi(argv[3]) : 3;
+    if (strcmp(which, "all") != 0 && findPQBackend(which) == NULL) {
+        fprintf(stderr, "Unknown backend %s\n", which);
+        return 1;
+    }
+
+    struct Trace trace;
+    double start = nowSeconds();
+    if (loadTrace(&trace, argv[1]) != 0) {
+        return 1;
+    }
+
+    long counts[4] = {0, 0, 0, 0};
+    for (long i = 0; i < trace.count; ++i) {
+        counts[trace.ops[i].type]++;
+    }
+    printf("Loaded %s in %.3f s: %ld runs, %ld push, %ld decrease-key, %ld extract-min\n", argv[1],
+           nowSeconds() - start, counts[TRACE_RESET], counts[TRACE_PUSH], counts[TRACE_DECREASE],
+           counts[TRACE_POP]);
+    printf("%-8s %12s %10s %14s %10s\n", "backend", "seconds", "ns/op", "comparisons", "checksum");
+
+    long failures = 0;
+    for (int b = 0; b < numPQBackends; ++b) {
+        const struct PQBackend* backend = &pqBackends[b];
+        if (strcmp(which, "all") != 0 && strcmp(which, backend->name) != 0) {
+            continue;
+        }
+
+        double best = 0;
+        int comparisonCount = 0;
+        unsigned long checksum = 0;
+        long mismatches = 0;
+        for (int r = 0; r < repetitions; ++r) {
+            comparisonCount = 0;
+            mismatches = 0;
+            start = nowSeconds();
+            checksum = replayTrace(&trace, backend, &comparisonCount, &mismatches);
+            double elapsed = nowSeconds() - start;
+            if (r == 0 || elapsed < best) {
+                best = elapsed;
+            }
+        }
+
+        printf("%-8s %12.3f %10.1f %14d %10lx\n", backend->name, best,
+               trace.count > 0 ? best * 1e9 / trace.count : 0, comparisonCount, checksum & 0xffffffffUL);
+        if (mismatches != 0) {
+            fprintf(stderr, "%s popped %ld keys that differ from the trace\n", backend->name, mismatches);
+            failures++;
+        }
+    }
+    freeTrace(&trace);
+    return failures != 0;
+}
@@ -0,0 +1,89 @@
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "undirected.h"
+
+// Order of the edge array: by lower end, then higher end, then weight
+static int compareEdges(const void* a, const void* b) {
+    const struct EdgeRecord* x = (const struct EdgeRecord*) a;
+    const struct EdgeRecord* y = (const struct EdgeRecord*) b;
+    if (x->src != y->src) {
+        return x->src < y->src ? -1 : 1;
+    }
+    if (x->dest != y->dest) {
+        return x->dest < y->dest ? -1 : 1;
+    }
+    return (x->weight > y->weight) - (x->weight < y->weight);
+}
+
+// Function to build an undirected graph from an edge list, each edge in either orientation
+struct UndirectedGraph* buildUndirectedGraph(int V, const struct EdgeList* list) {
+    long E = list->count;
+    if (E > INT_MAX) {
+        return NULL;  // Edge numbers are ints in reverseEdges
+    }
+
+    // Sort the edges with the lower end first
+    struct EdgeRecord* sorted = (struct EdgeRecord*) malloc((E > 0 ? E : 1) * sizeof(struct EdgeRecord));
+    for (long i = 0; i < E; ++i) {
+        const struct EdgeRecord* edge = &list->edges[i];
+        sorted[i].src = edge->src < edge->dest ? edge->src : edge->dest;
+        sorted[i].dest = edge->src < edge->dest ? edge->dest : edge->src;
+        sorted[i].weight = edge->weight;
+    }
+    qsort(sorted, E, sizeof(struct EdgeRecord), compareEdges);
+
+    struct UndirectedGraph* graph = (struct UndirectedGraph*) malloc(sizeof(struct UndirectedGraph));
+    graph->V = V;
+    graph->E = E;
+    graph->offsets = (long*) calloc(V + 1, sizeof(long));
+    graph->reverseOffsets = (long*) calloc(V + 1, sizeof(long));
+    graph->ends = (int*) malloc((E > 0 ? E : 1) * sizeof(int));
+    graph->weights = (int*) malloc((E > 0 ? E : 1) * sizeof(int));
+
+    // Degrees in both directions, then prefix sums
+    for (long e = 0; e < E; ++e) {
+        graph->offsets[sorted[e].src + 1]++;
+        if (sorted[e].src != sorted[e].dest) {
+            graph->reverseOffsets[sorted[e].dest + 1]++;
+        }
+    }
+    for (int x = 0; x < V; ++x) {
+        graph->offsets[x + 1] += graph->offsets[x];
+        graph->reverseOffsets[x + 1] += graph->reverseOffsets[x];
+    }
+
+    // The rows are the sorted array itself; reverse rows come out ordered by lower end
+    long reverseCount = graph->reverseOffsets[V];
+    graph->reverseEdges = (int*) malloc((reverseCount > 0 ? reverseCount : 1) * sizeof(int));
+    long* cursor = (long*) malloc((V > 0 ? V : 1) * sizeof(long));
+    memcpy(cursor, graph->reverseOffsets, V * sizeof(long));
+    for (long e = 0; e < E; ++e) {
+        graph->ends[e] = sorted[e].src ^ sorted[e].dest;
+        graph->weights[e] = sorted[e].weight;
+        if (sorted[e].src != sorted[e].dest) {
+            graph->reverseEdges[cursor[sorted[e].dest]++] = (int) e;
+        }
+    }
+
+    free(cursor);
+    free(sorted);
+    return graph;
+}
+
+// Function to get the bytes an undirected graph takes
+long undirectedGraphBytes(const struct UndirectedGraph* graph) {
+    return (long) sizeof(struct UndirectedGraph) + 2 * (graph->V + 1) * (long) sizeof(long) +
+           graph->E * (long) (2 * sizeof(int)) + graph->reverseOffsets[graph->V] * (long) sizeof(int);
+}
+
+// Function to free an undirected graph
+void freeUndirectedGraph(struct UndirectedGraph* graph) {
+    free(graph->offsets);
+    free(graph->ends);
+    free(graph->weights);
+    free(graph->reverseOffsets);
+    free(graph->reverseEdges);
+    free(graph);
+}
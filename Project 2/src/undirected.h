@@ -0,0 +1,34 @@
+#ifndef UNDIRECTED_H
+#define UNDIRECTED_H
+
+#include "csr.h"
+
+// An undirected graph that stores every edge once. The edges are sorted by (lower, higher)
+// endpoint and grouped into rows by their lower endpoint, like a CSR graph; a second index
+// lists, for each vertex, the edges in which it is the higher endpoint. An edge keeps
+// low ^ high instead of either endpoint: coming from x, ends[e] ^ x is the other end.
+//
+// Memory: 12 bytes per edge (ends, weights, one reverse entry) plus 16 per vertex. Adjacency
+// lists holding both directions take 16 bytes per edge ({vertex, weight} twice), and an int
+// adjacency matrix 4 V^2 bytes in all.
+struct UndirectedGraph {
+    int V;                 // Number of vertices
+    long E;                // Number of edges, each counted once
+    long *offsets;         // V + 1 entries: edges offsets[x] .. offsets[x+1] have x as lower end
+    int *ends;             // low ^ high of every edge
+    int *weights;
+    long *reverseOffsets;  // V + 1 entries into reverseEdges
+    int *reverseEdges;     // Edges with x as higher end, by lower end; self-loops are only in rows
+};
+
+// Function to build an undirected graph from an edge list (filled with pushEdge(), which grows
+// it as needed), each edge in either orientation. NULL if there are more than INT_MAX edges.
+struct UndirectedGraph* buildUndirectedGraph(int V, const struct EdgeList* list);
+
+// Function to get the bytes an undirected graph takes
+long undirectedGraphBytes(const struct UndirectedGraph* graph);
+
+// Function to free an undirected graph
+void freeUndirectedGraph(struct UndirectedGraph* graph);
+
+#endif
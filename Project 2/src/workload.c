@@ -0,0 +1,285 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "workload.h"
+#include "rng.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static const char* workloadNames[] = {"uniform", "rmat", "grid", "geometric"};
+static const char* weightNames[] = {"uniform", "exponential", "constant", "euclidean"};
+
+// Function to parse a workload or weight distribution name, returns -1 if unknown
+int parseWorkload(const char* name) {
+    for (int i = 0; i < 4; ++i) {
+        if (strcmp(name, workloadNames[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int parseWeightDistribution(const char* name) {
+    for (int i = 0; i < 4; ++i) {
+        if (strcmp(name, weightNames[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const char* workloadName(enum WorkloadType type) {
+    return workloadNames[type];
+}
+
+// Function to draw one weight. length/maxLength describe the edge geometry,
+// length is negative for graphs without coordinates.
+static int drawWeight(struct Rng* rng, const struct WeightSpec* spec, double length, double maxLength) {
+    int lo = spec->minWeight;
+    int hi = spec->maxWeight;
+    double w;
+
+    switch (spec->distribution) {
+    case WEIGHT_CONSTANT:
+        return lo;
+    case WEIGHT_EXPONENTIAL:
+        w = -((lo + hi) / 2.0) * log1p(-rngDouble(rng));
+        break;
+    case WEIGHT_EUCLIDEAN:
+        if (length >= 0) {
+            w = lo + (hi - lo) * fmin(1.0, length / maxLength);
+            break;
+        }
+        // No coordinates to measure, so draw uniformly
+        return lo + (int) rngBounded(rng, hi - lo + 1);
+    default:
+        return lo + (int) rngBounded(rng, hi - lo + 1);
+    }
+
+    int rounded = (int) (w + 0.5);
+    return rounded < lo ? lo : (rounded > hi ? hi : rounded);
+}
+
+// Function to generate E uniform random pairs, self-loops dropped
+void generateUniform(int V, long E, const struct WeightSpec* weights, uint64_t seed, struct EdgeList* list) {
+    struct Rng rng;
+    rngSeed(&rng, seed, 3);
+
+    for (long i = 0; i < E; ++i) {
+        int u = (int) rngBounded(&rng, V);
+        int v = (int) rngBounded(&rng, V);
+        int weight = drawWeight(&rng, weights, -1, 0);
+        if (u != v) {
+            pushEdge(list, u, v, weight);
+        }
+    }
+}
+
+// Function to generate an R-MAT graph with E directed edges
+void generateRMAT(int V, long E, const struct WeightSpec* weights, uint64_t seed, struct EdgeList* list) {
+    const double a = 0.57, b = 0.19, c = 0.19;
+    struct Rng rng;
+    rngSeed(&rng, seed, 0);
+
+    int levels = 1;
+    while ((1L << levels) < V) {
+        levels++;
+    }
+    if (V < 2) {
+        return;
+    }
+
+    long added = 0;
+    while (added < E) {
+        int u = 0, v = 0;
+
+        // Descend into one quadrant of the adjacency matrix per level
+        for (int level = 0; level < levels; ++level) {
+            double r = rngDouble(&rng);
+            int row = 0, col = 0;
+            if (r < a) {
+                // Top-left quadrant
+            } else if (r < a + b) {
+                col = 1;
+            } else if (r < a + b + c) {
+                row = 1;
+            } else {
+                row = col = 1;
+            }
+            u = 2 * u + row;
+            v = 2 * v + col;
+        }
+
+        // Resample ids past V (V need not be a power of two) and self-loops
+        if (u >= V || v >= V || u == v) {
+            continue;
+        }
+        pushEdge(list, u, v, drawWeight(&rng, weights, -1, 0));
+        added++;
+    }
+}
+
+// Function to generate a road-like grid with about E directed edges
+void generateGrid(int V, long E, const struct WeightSpec* weights, uint64_t seed, struct EdgeList* list) {
+    struct Rng rng;
+    rngSeed(&rng, seed, 1);
+
+    int cols = (int) ceil(sqrt((double) V));
+    double* x = (double*) malloc(V * sizeof(double));
+    double* y = (double*) malloc(V * sizeof(double));
+
+    // Jitter every intersection inside its cell so link lengths vary
+    for (int i = 0; i < V; ++i) {
+        x[i] = i % cols + 0.6 * (rngDouble(&rng) - 0.5);
+        y[i] = i / cols + 0.6 * (rngDouble(&rng) - 0.5);
+    }
+
+    long baseLinks = 0;
+    for (int i = 0; i < V; ++i) {
+        baseLinks += 2 * ((i % cols + 1 < cols && i + 1 < V) + (i + cols < V));
+    }
+
+    // With fewer edges than the grid has, drop directed links at random (one-way streets);
+    // with more, add short links within a window that widens with the surplus
+    double keep = baseLinks > 0 && E < baseLinks ? (double) E / baseLinks : 1.0;
+    long extra = E > baseLinks ? E - baseLinks : 0;
+    int window = 2 + (int) (extra / (V > 0 ? V : 1));
+    if (window > cols) {
+        window = cols;
+    }
+    double maxLength = sqrt(2.0) * (window + 0.6);
+
+    for (int i = 0; i < V; ++i) {
+        int neighbors[2] = {i % cols + 1 < cols && i + 1 < V ? i + 1 : -1, i + cols < V ? i + cols : -1};
+        for (int k = 0; k < 2; ++k) {
+            int j = neighbors[k];
+            if (j < 0) {
+                continue;
+            }
+            double length = hypot(x[i] - x[j], y[i] - y[j]);
+            if (rngDouble(&rng) < keep) {
+                pushEdge(list, i, j, drawWeight(&rng, weights, length, maxLength));
+            }
+            if (rngDouble(&rng) < keep) {
+                pushEdge(list, j, i, drawWeight(&rng, weights, length, maxLength));
+            }
+        }
+    }
+
+    while (extra > 0 && V > 1) {
+        int u = (int) rngBounded(&rng, V);
+        int row = u / cols + (int) rngBounded(&rng, 2 * window + 1) - window;
+        int col = u % cols + (int) rngBounded(&rng, 2 * window + 1) - window;
+        int v = row * cols + col;
+        if (row < 0 || col < 0 || col >= cols || v >= V || v == u) {
+            continue;
+        }
+        pushEdge(list, u, v, drawWeight(&rng, weights, hypot(x[u] - x[v], y[u] - y[v]), maxLength));
+        extra--;
+    }
+
+    free(x);
+    free(y);
+}
+
+// Function to generate a random geometric graph with about E directed edges
+void generateGeometric(int V, long E, const struct WeightSpec* weights, uint64_t seed, struct EdgeList* list) {
+    if (V < 2 || E <= 0) {
+        return;  // E = 0 would make the radius 0 and the cell count infinite
+    }
+    struct Rng rng;
+    rngSeed(&rng, seed, 2);
+
+    // Expected directed edges is about V (V - 1) pi r^2, ignoring the border
+    double radius = fmin(1.5, sqrt(E / (M_PI * V * (double) (V - 1))));
+    double* x = (double*) malloc(V * sizeof(double));
+    double* y = (double*) malloc(V * sizeof(double));
+    for (int i = 0; i < V; ++i) {
+        x[i] = rngDouble(&rng);
+        y[i] = rngDouble(&rng);
+    }
+
+    // Bucket the points into cells at least radius wide, so only adjacent cells can hold neighbours
+    int cells = (int) (1.0 / radius);
+    int maxCells = (int) sqrt((double) V) + 1;
+    if (cells > maxCells) {
+        cells = maxCells;
+    }
+    if (cells < 1) {
+        cells = 1;
+    }
+
+    int* cellOf = (int*) malloc(V * sizeof(int));
+    int* cellStart = (int*) calloc(cells * cells + 1, sizeof(int));
+    int* order = (int*) malloc(V * sizeof(int));
+    for (int i = 0; i < V; ++i) {
+        int cx = (int) (x[i] * cells);
+        int cy = (int) (y[i] * cells);
+        cellOf[i] = (cy < cells ? cy : cells - 1) * cells + (cx < cells ? cx : cells - 1);
+        cellStart[cellOf[i] + 1]++;
+    }
+    for (int c = 0; c < cells * cells; ++c) {
+        cellStart[c + 1] += cellStart[c];
+    }
+    int* fill = (int*) malloc(cells * cells * sizeof(int));
+    memcpy(fill, cellStart, cells * cells * sizeof(int));
+    for (int i = 0; i < V; ++i) {
+        order[fill[cellOf[i]]++] = i;
+    }
+
+    for (int i = 0; i < V; ++i) {
+        int cx = cellOf[i] % cells;
+        int cy = cellOf[i] / cells;
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                int nx = cx + dx, ny = cy + dy;
+                if (nx < 0 || ny < 0 || nx >= cells || ny >= cells) {
+                    continue;
+                }
+                int c = ny * cells + nx;
+                for (int k = cellStart[c]; k < cellStart[c + 1]; ++k) {
+                    int j = order[k];
+                    double length = hypot(x[i] - x[j], y[i] - y[j]);
+                    if (j > i && length < radius) {
+                        pushEdge(list, i, j, drawWeight(&rng, weights, length, radius));
+                        pushEdge(list, j, i, drawWeight(&rng, weights, length, radius));
+                    }
+                }
+            }
+        }
+    }
+
+    free(x);
+    free(y);
+    free(cellOf);
+    free(cellStart);
+    free(order);
+    free(fill);
+}
+
+// Function to generate a workload straight into the adjacency list struct Graph
+struct Graph* generateWorkloadGraph(enum WorkloadType type, int V, long E,
+                                    const struct WeightSpec* weights, uint64_t seed) {
+    struct Graph* graph = createGraph(V);
+    struct EdgeList list;
+    initEdgeList(&list, E + 16);
+    if (type == WORKLOAD_UNIFORM) {
+        generateUniform(V, E, weights, seed, &list);
+    } else if (type == WORKLOAD_RMAT) {
+        generateRMAT(V, E, weights, seed, &list);
+    } else if (type == WORKLOAD_GRID) {
+        generateGrid(V, E, weights, seed, &list);
+    } else {
+        generateGeometric(V, E, weights, seed, &list);
+    }
+
+    for (long i = 0; i < list.count; ++i) {
+        addEdge(graph, list.edges[i].src, list.edges[i].dest, list.edges[i].weight);
+    }
+    freeEdgeList(&list);
+    return graph;
+}
@@ -0,0 +1,57 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stdint.h>
+
+#include "csr.h"
+#include "graph.h"
+
+// How edge weights are drawn
+enum WeightDistribution {
+    WEIGHT_UNIFORM,      // Uniform in [minWeight, maxWeight]
+    WEIGHT_EXPONENTIAL,  // Exponential with mean (minWeight + maxWeight) / 2, clamped to the range
+    WEIGHT_CONSTANT,     // Always minWeight
+    WEIGHT_EUCLIDEAN     // Scaled edge length for grid and geometric graphs, uniform otherwise
+};
+
+struct WeightSpec {
+    enum WeightDistribution distribution;
+    int minWeight;
+    int maxWeight;
+};
+
+// The workload families the sweep drivers can select
+enum WorkloadType {
+    WORKLOAD_UNIFORM,    // E uniform random (src, dest) pairs, self-loops dropped
+    WORKLOAD_RMAT,       // Recursive matrix (Kronecker) power-law graph
+    WORKLOAD_GRID,       // Road-like 2D grid with jittered coordinates and local extra edges
+    WORKLOAD_GEOMETRIC   // Random geometric graph in the unit square
+};
+
+// Function to parse a workload or weight distribution name, returns -1 if unknown
+int parseWorkload(const char* name);
+int parseWeightDistribution(const char* name);
+const char* workloadName(enum WorkloadType type);
+
+// Function to generate a uniform random graph the way generateRandomGraph() does: E random
+// (src, dest) pairs, of which the self-loops are dropped, but with seeded weights from the spec
+void generateUniform(int V, long E, const struct WeightSpec* weights, uint64_t seed, struct EdgeList* list);
+
+// Function to generate an R-MAT graph with E directed edges (no self-loops, parallel edges allowed)
+// using the Graph500 probabilities a=0.57, b=c=0.19
+void generateRMAT(int V, long E, const struct WeightSpec* weights, uint64_t seed, struct EdgeList* list);
+
+// Function to generate a road-like grid: about sqrt(V) x sqrt(V) vertices with jittered
+// coordinates, both directions of every 4-neighbour link, and extra short-range links
+// (or randomly removed links) to bring the edge count to about E
+void generateGrid(int V, long E, const struct WeightSpec* weights, uint64_t seed, struct EdgeList* list);
+
+// Function to generate a random geometric graph: V points in the unit square, each pair
+// closer than a radius chosen for about E directed edges is linked in both directions
+void generateGeometric(int V, long E, const struct WeightSpec* weights, uint64_t seed, struct EdgeList* list);
+
+// Function to generate a workload straight into the adjacency list struct Graph
+struct Graph* generateWorkloadGraph(enum WorkloadType type, int V, long E,
+                                    const struct WeightSpec* weights, uint64_t seed);
+
+#endif
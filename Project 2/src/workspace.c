@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "workspace.h"
+#include "distance.h"
+
+// Function to allocate a workspace for graphs with up to V vertices
+struct DijkstraWorkspace* createDijkstraWorkspace(int V) {
+    struct DijkstraWorkspace* ws = (struct DijkstraWorkspace*) malloc(sizeof(struct DijkstraWorkspace));
+    ws->V = V;
+    ws->generation = 0;
+    ws->stamp = (unsigned int*) calloc(V, sizeof(unsigned int));
+    ws->nodes = (struct MinHeapNode*) malloc(V * sizeof(struct MinHeapNode));
+    ws->minHeap = createMinHeap(V);
+    return ws;
+}
+
+// Function to free the workspace
+void freeDijkstraWorkspace(struct DijkstraWorkspace* ws) {
+    free(ws->stamp);
+    free(ws->nodes);
+    freeMinHeap(ws->minHeap);
+    free(ws);
+}
+
+// Function to start a new query: every stamp becomes stale at once
+static void beginQuery(struct DijkstraWorkspace* ws) {
+    ws->minHeap->size = 0;
+    ws->generation += 2;
+
+    // Once every 2^31 queries the stamps would wrap around, so clear them for real
+    if (ws->generation >= UINT_MAX - 2) {
+        memset(ws->stamp, 0, ws->V * sizeof(unsigned int));
+        ws->generation = 2;
+    }
+}
+
+// Function to offer v a tentative distance, inserting or decreasing it in the heap
+static void relaxVertex(struct DijkstraWorkspace* ws, int v, int candidate, int* comparisonCount) {
+    unsigned int stamp = ws->stamp[v];
+
+    (*comparisonCount)++;
+    if (candidate >= INF) {
+        return;  // Too long to hold: v stays unreached, as in the other engines
+    }
+    if (stamp < ws->generation) {
+        // First time this query sees v
+        ws->stamp[v] = ws->generation;
+        ws->nodes[v].v = v;
+        ws->nodes[v].dist = candidate;
+        insertMinHeap(ws->minHeap, &ws->nodes[v], comparisonCount);
+    } else if (stamp == ws->generation && candidate < ws->nodes[v].dist) {
+        decreaseKey(ws->minHeap, v, candidate, comparisonCount);
+    }
+}
+
+// Function to pop the vertex with the smallest distance and mark it settled
+static int popVertex(struct DijkstraWorkspace* ws, int* settled, int* comparisonCount) {
+    int u = extractMin(ws->minHeap, comparisonCount)->v;
+    ws->stamp[u] = ws->generation + 1;
+    (*settled)++;
+    return u;
+}
+
+// Function to run Dijkstra from src until target is settled (target -1 runs to the end)
+int dijkstraQuery(struct Graph* graph, struct DijkstraWorkspace* ws, int src, int target,
+                  int* settled, int* comparisonCount) {
+    beginQuery(ws);
+    relaxVertex(ws, src, 0, comparisonCount);
+
+    while (ws->minHeap->size > 0) {
+        int u = popVertex(ws, settled, comparisonCount);
+        if (u == target) {
+            return ws->nodes[u].dist;
+        }
+
+        int du = ws->nodes[u].dist;
+        struct Edge* pCrawl = graph->array[u].head;
+        while (pCrawl != NULL) {
+            relaxVertex(ws, pCrawl->dest, addDistInt(du, pCrawl->weight, INF), comparisonCount);
+            pCrawl = pCrawl->next;
+        }
+    }
+    return INF;
+}
+
+// Function to run dijkstraQuery() on a CSR graph
+int dijkstraQueryCSR(struct CSRGraph* csr, struct DijkstraWorkspace* ws, int src, int target,
+                     int* settled, int* comparisonCount) {
+    beginQuery(ws);
+    relaxVertex(ws, src, 0, comparisonCount);
+
+    while (ws->minHeap->size > 0) {
+        int u = popVertex(ws, settled, comparisonCount);
+        if (u == target) {
+            return ws->nodes[u].dist;
+        }
+
+        int du = ws->nodes[u].dist;
+        for (long i = csr->offsets[u]; i < csr->offsets[u + 1]; ++i) {
+            relaxVertex(ws, csr->targets[i], addDistInt(du, csr->weights[i], INF), comparisonCount);
+        }
+    }
+    return INF;
+}
+
+// Function to read the distance of v found by the last query, INF if it was not reached
+int workspaceDist(struct DijkstraWorkspace* ws, int v) {
+    return ws->stamp[v] >= ws->generation ? ws->nodes[v].dist : INF;
+}
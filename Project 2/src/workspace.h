@@ -0,0 +1,39 @@
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include "graph.h"
+#include "csr.h"
+#include "minheap.h"
+
+// Buffers for running many Dijkstra queries on graphs with up to V vertices.
+// Every vertex carries a stamp instead of being reset between queries: a stamp older
+// than the current generation means "unreached", so starting a query is O(1) and the
+// cost of a query depends only on the vertices it touches.
+struct DijkstraWorkspace {
+    int V;
+    unsigned int generation;    // Stamp base of the current query
+    unsigned int *stamp;        // generation: in the heap, generation + 1: settled, older: unreached
+    struct MinHeapNode *nodes;  // nodes[v] is the heap node of v and holds its distance;
+                                // valid only for vertices stamped in the current query
+    struct MinHeap *minHeap;    // minHeap->pos[v] is likewise only read for stamped vertices
+};
+
+// Function to allocate a workspace for graphs with up to V vertices
+struct DijkstraWorkspace* createDijkstraWorkspace(int V);
+
+// Function to free the workspace
+void freeDijkstraWorkspace(struct DijkstraWorkspace* ws);
+
+// Function to run Dijkstra from src until target is settled (target -1 runs to the end).
+// Returns dist(src, target), or INF if target is unreachable or -1.
+int dijkstraQuery(struct Graph* graph, struct DijkstraWorkspace* ws, int src, int target,
+                  int* settled, int* comparisonCount);
+
+// Function to run dijkstraQuery() on a CSR graph
+int dijkstraQueryCSR(struct CSRGraph* csr, struct DijkstraWorkspace* ws, int src, int target,
+                     int* settled, int* comparisonCount);
+
+// Function to read the distance of v found by the last query, INF if it was not reached
+int workspaceDist(struct DijkstraWorkspace* ws, int v);
+
+#endif
@@ -0,0 +1,130 @@
+// Build: gcc -O2 -o workspace_bench workspace_bench.c graph.c arena.c minheap.c dheap.c trace.c dijkstra.c p2p.c csr.c generator.c workspace.c -lpthread -lm
+// Usage: ./workspace_bench [V] [E] [queries] [hops] [baseline every]
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "graph.h"
+#include "csr.h"
+#include "generator.h"
+#include "p2p.h"
+#include "rng.h"
+#include "workspace.h"
+
+// Function to read a monotonic clock in seconds
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Function to pick the target of a short query: the end of a random walk from src
+static int walkTarget(struct CSRGraph* csr, int src, int hops, struct Rng* rng) {
+    int v = src;
+    for (int h = 0; h < hops; ++h) {
+        long degree = csr->offsets[v + 1] - csr->offsets[v];
+        if (degree == 0) {
+            break;
+        }
+        v = csr->targets[csr->offsets[v] + rngBounded(rng, degree)];
+    }
+    return v;
+}
+
+int main(int argc, char* argv[]) {
+    int V = argc > 1 ? atoi(argv[1]) : 1000000;
+    long E = argc > 2 ? atol(argv[2]) : 4L * V;
+    int queries = argc > 3 ? atoi(argv[3]) : 1000000;
+    int hops = argc > 4 ? atoi(argv[4]) : 2;
+    int baselineEvery = argc > 5 ? atoi(argv[5]) : 1000;
+
+    struct CSRGraph* csr = generateGnmCSR(V, E, 1, 10, 1, defaultThreadCount());
+    if (csr == NULL) {
+        return 1;
+    }
+    struct Graph* graph = csrToGraph(csr);
+    struct DijkstraWorkspace* ws = createDijkstraWorkspace(V);
+
+    // The query list is generated up front so that only the searches are timed
+    int* src = (int*) malloc(queries * sizeof(int));
+    int* target = (int*) malloc(queries * sizeof(int));
+    int* answer = (int*) malloc(queries * sizeof(int));
+    struct Rng rng;
+    rngSeed(&rng, 1, 0);
+    for (int q = 0; q < queries; ++q) {
+        src[q] = (int) rngBounded(&rng, V);
+        target[q] = walkTarget(csr, src[q], hops, &rng);
+    }
+
+    FILE* file = fopen("workspace_results.csv", "w");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening file for writing.\n");
+        return 1;
+    }
+    fprintf(file, "Engine,Queries,Seconds,Queries/s,Avg Settled,Avg Comparisons\n");
+    printf("%-18s %10s %10s %12s %12s\n", "engine", "queries", "seconds", "queries/s", "avg settled");
+
+    // Workspace queries on the adjacency list and on the CSR graph
+    for (int engine = 0; engine < 2; ++engine) {
+        const char* name = engine == 0 ? "workspace" : "workspace_csr";
+        long settled = 0;
+        long comparisons = 0;
+
+        double start = nowSeconds();
+        for (int q = 0; q < queries; ++q) {
+            int querySettled = 0;
+            int comparisonCount = 0;
+            if (engine == 0) {
+                answer[q] = dijkstraQuery(graph, ws, src[q], target[q], &querySettled, &comparisonCount);
+            } else if (dijkstraQueryCSR(csr, ws, src[q], target[q], &querySettled, &comparisonCount) != answer[q]) {
+                fprintf(stderr, "Mismatch on query %d between the list and CSR searches\n", q);
+                return 1;
+            }
+            settled += querySettled;
+            comparisons += comparisonCount;
+        }
+        double elapsed = nowSeconds() - start;
+
+        printf("%-18s %10d %10.3f %12.0f %12.1f\n", name, queries, elapsed, queries / elapsed,
+               (double) settled / queries);
+        fprintf(file, "%s,%d,%f,%f,%f,%f\n", name, queries, elapsed, queries / elapsed,
+                (double) settled / queries, (double) comparisons / queries);
+    }
+
+    // dijkstraTo() allocates and initializes O(V) state per query, so only a sample is run
+    int mismatches = 0;
+    int sampled = 0;
+    long settled = 0;
+    long comparisons = 0;
+    double start = nowSeconds();
+    for (int q = 0; q < queries; q += baselineEvery > 0 ? baselineEvery : queries) {
+        int querySettled = 0;
+        int comparisonCount = 0;
+        int expected = dijkstraTo(graph, src[q], target[q], &querySettled, &comparisonCount);
+        if (expected != answer[q]) {
+            fprintf(stderr, "Mismatch on query %d (%d -> %d): workspace gave %d, expected %d\n",
+                    q, src[q], target[q], answer[q], expected);
+            mismatches++;
+        }
+        settled += querySettled;
+        comparisons += comparisonCount;
+        sampled++;
+    }
+    double elapsed = nowSeconds() - start;
+
+    printf("%-18s %10d %10.3f %12.0f %12.1f\n", "dijkstraTo", sampled, elapsed, sampled / elapsed,
+           (double) settled / sampled);
+    fprintf(file, "dijkstraTo,%d,%f,%f,%f,%f\n", sampled, elapsed, sampled / elapsed,
+            (double) settled / sampled, (double) comparisons / sampled);
+    fclose(file);
+    printf("Results have been saved to workspace_results.csv (%d mismatches)\n", mismatches);
+
+    free(src);
+    free(target);
+    free(answer);
+    freeDijkstraWorkspace(ws);
+    freeGraph(graph);
+    freeCSRGraph(csr);
+
+    return mismatches != 0;
+}
@@ -11,7 +11,7 @@ int key_comparisons = 0;
 
 // Function to find the vertex with the minimum distance that is not yet processed
 int minDistance(int dist[], int visited[]) {
-    int min = INF, min_index;
+    int min = INF, min_index = -1;
 
     for (int v = 0; v < V; v++) {
         key_comparisons++;  // Count this comparison
@@ -67,6 +67,7 @@ void dijkstra(int graph[V][V], int src) {
 }
 
 
+void generateRandomGraph(int graph[][V], int E);
 
 int main() {
 //    // Example adjacency matrix representing the graph
@@ -93,7 +94,7 @@ int main() {
     return 0;
 }
 
-void generateRandomGraph(int graph[][5], int E) {
+void generateRandomGraph(int graph[][V], int E) {
     // Initialize the adjacency matrix to all 0 (no edges)
     for (int i = 0; i < V; i++) {
         for (int j = 0; j < V; j++) {
@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <time.h>
 
+#include "../src/arena.h"
+
 #define V 10
 
 //create minimizing heap based on lect slides
@@ -20,11 +22,12 @@ typedef struct _graph {
     int vSize;                // Number of vertices
     int eSize;                // Number of edges
     ListNode **adjL;          // Array of adjacency lists
+    struct Arena nodes;       // Every ListNode lives here and is freed with the graph
 } Graph;
 
 // Function to create a new ListNode for the adjacency list
-ListNode* createListNode(int id, int weight) {
-    ListNode* newNode = (ListNode*)malloc(sizeof(ListNode));
+ListNode* createListNode(struct Arena* arena, int id, int weight) {
+    ListNode* newNode = (ListNode*)arenaAlloc(arena, sizeof(ListNode));
     newNode->id = id;
     newNode->weight = weight;
     newNode->next = NULL;
@@ -44,6 +47,7 @@ Graph* createGraph(int vSize) {
     for (int i = 0; i < vSize; i++) {
         graph->adjL[i] = NULL;
     }
+    arenaInit(&graph->nodes, 4096);
 
     return graph;
 }
@@ -51,7 +55,7 @@ Graph* createGraph(int vSize) {
 // Function to add a directed edge to the graph
 void addEdge(Graph* graph, int src, int dest, int weight) {
     // Add an edge from src to dest (directed)
-    ListNode* newNode = createListNode(dest, weight);
+    ListNode* newNode = createListNode(&graph->nodes, dest, weight);
     newNode->next = graph->adjL[src];  // Point the new node to the current head
     graph->adjL[src] = newNode;        // Update the head to point to the new node
 
@@ -75,14 +79,7 @@ void printGraph(Graph* graph) {
 
 // Function to free the graph memory
 void freeGraph(Graph* graph) {
-    for (int v = 0; v < graph->vSize; v++) {
-        ListNode* temp = graph->adjL[v];
-        while (temp) {
-            ListNode* toFree = temp;
-            temp = temp->next;
-            free(toFree);
-        }
-    }
+    arenaFree(&graph->nodes);
     free(graph->adjL);
     free(graph);
 }
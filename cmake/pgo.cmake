@@ -0,0 +1,63 @@
+# Two-stage profile guided build, run by the pgo target:
+#   cmake -DSOURCE_DIR=... -DBINARY_DIR=... [-DC_COMPILER=...] [-DGENERATOR=...] [-DLTO=ON] -P pgo.cmake
+# 1. configure BINARY_DIR with BENCH_PGO=GENERATE and build the instrumented binaries
+# 2. run them on the training workloads below (in-process, so that the profiles get written)
+# 3. reconfigure the same directory with BENCH_PGO=USE and rebuild
+cmake_minimum_required(VERSION 3.16)
+
+if(NOT SOURCE_DIR OR NOT BINARY_DIR)
+    message(FATAL_ERROR "pgo.cmake needs -DSOURCE_DIR and -DBINARY_DIR")
+endif()
+set(PROFILE_DIR "${BINARY_DIR}/profiles")
+set(TRAIN_DIR "${BINARY_DIR}/training")
+
+set(CONFIGURE_ARGS -S "${SOURCE_DIR}" -B "${BINARY_DIR}" -DCMAKE_BUILD_TYPE=Release "-DBENCH_PGO_DIR=${PROFILE_DIR}")
+if(C_COMPILER)
+    list(APPEND CONFIGURE_ARGS "-DCMAKE_C_COMPILER=${C_COMPILER}")
+endif()
+if(GENERATOR)
+    list(APPEND CONFIGURE_ARGS -G "${GENERATOR}")
+endif()
+if(DEFINED LTO)
+    list(APPEND CONFIGURE_ARGS "-DBENCH_LTO=${LTO}")
+endif()
+if(DEFINED NATIVE)
+    list(APPEND CONFIGURE_ARGS "-DBENCH_NATIVE=${NATIVE}")
+endif()
+
+function(run)
+    execute_process(COMMAND ${ARGN} WORKING_DIRECTORY "${TRAIN_DIR}" RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        list(JOIN ARGN " " command)
+        message(FATAL_ERROR "pgo: '${command}' failed (${result})")
+    endif()
+endfunction()
+
+# Stage 1: instrumented build
+file(REMOVE_RECURSE "${PROFILE_DIR}" "${TRAIN_DIR}")
+file(MAKE_DIRECTORY "${PROFILE_DIR}" "${TRAIN_DIR}")
+run(${CMAKE_COMMAND} ${CONFIGURE_ARGS} -DBENCH_PGO=GENERATE)
+run(${CMAKE_COMMAND} --build "${BINARY_DIR}" --clean-first --parallel)
+
+# Training: the engines on every workload family at moderate sizes
+message(STATUS "pgo: training")
+run("${BINARY_DIR}/sweep" -x -a hybrid,heap,lowmem -s 10000:1000000:330000 -t 8,32
+    -w random,sorted,reversed,few -o train_sort.csv)
+run("${BINARY_DIR}/sweep" -x -a dijkstra,dijkstra-csr,dijkstra-4ary -s 20000:200000:60000 -V 10000
+    -w uniform,rmat,grid,geometric -o train_sssp.csv)
+run("${BINARY_DIR}/batch_bench" 100 10000 300000 0 16 1)
+run("${BINARY_DIR}/select_bench" 200000)
+run("${BINARY_DIR}/heap_bench" 10000 100000)
+
+get_filename_component(COMPILER_NAME "${C_COMPILER}" NAME)
+if(COMPILER_NAME MATCHES "clang")
+    # Clang writes raw profiles that have to be merged first
+    find_program(LLVM_PROFDATA NAMES llvm-profdata REQUIRED)
+    file(GLOB RAW_PROFILES "${PROFILE_DIR}/*.profraw")
+    run("${LLVM_PROFDATA}" merge "-output=${PROFILE_DIR}/default.profdata" ${RAW_PROFILES})
+endif()
+
+# Stage 2: optimized with the profiles
+run(${CMAKE_COMMAND} ${CONFIGURE_ARGS} -DBENCH_PGO=USE)
+run(${CMAKE_COMMAND} --build "${BINARY_DIR}" --clean-first --parallel)
+message(STATUS "pgo: optimized binaries are in ${BINARY_DIR}")
@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+
+#include "check.h"
+
+#define MAX_REPORTED 20  // Failures printed in full; the rest are only counted
+
+long checkCount = 0;
+long checkFailures = 0;
+
+int parseTestOptions(int argc, char* argv[], const int defaultRounds[2], struct TestOptions* options) {
+    memset(options, 0, sizeof(*options));
+    options->seed = 1;
+    options->rounds = -1;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--long") == 0) {
+            options->longMode = 1;
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options->seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+            options->rounds = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [--long] [--seed N] [--rounds N]\n", argv[0]);
+            return -1;
+        }
+    }
+    if (options->seed == 0) {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        options->seed = (uint64_t) ts.tv_sec * 1000000007ULL + ts.tv_nsec;
+    }
+    if (options->rounds < 0) {
+        options->rounds = defaultRounds[options->longMode];
+    }
+    printf("%s: seed %llu, %d rounds%s\n", argv[0], (unsigned long long) options->seed, options->rounds,
+           options->longMode ? ", long mode" : "");
+    return 0;
+}
+
+void checkFailed(const struct TestOptions* options, const char* file, int line, const char* format, ...) {
+    if (++checkFailures > MAX_REPORTED) {
+        return;
+    }
+    fprintf(stderr, "FAILED %s:%d (seed %llu, round %d): ", file, line, (unsigned long long) options->seed,
+            options->round);
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    fprintf(stderr, "\n");
+}
+
+int checkSummary(const char* name, const struct TestOptions* options) {
+    printf("%s: %ld checks in %d rounds, %ld failed\n", name, checkCount, options->rounds, checkFailures);
+    if (checkFailures > 0) {
+        printf("Reproduce with --seed %llu%s\n", (unsigned long long) options->seed, options->longMode ? " --long" : "");
+    }
+    return checkFailures != 0;
+}
@@ -0,0 +1,43 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+// Support for the property tests. A failed CHECK() is reported with the seed and round that
+// reproduce it and counted, so one run shows every broken property instead of only the first.
+//
+// Every test program takes [--long] [--seed N] [--rounds N]:
+//   --long    nightly mode: larger inputs and more rounds
+//   --seed    seed of the run, 0 for one taken from the clock (printed either way)
+//   --rounds  number of random cases instead of the mode's default
+
+#include <stdint.h>
+
+struct TestOptions {
+    int longMode;
+    uint64_t seed;
+    int rounds;
+    int round;  // The round being run, for failure reports
+};
+
+extern long checkCount;
+extern long checkFailures;
+
+// Function to parse the common options, defaultRounds[0] short and [1] long. Returns -1 on a
+// bad argument.
+int parseTestOptions(int argc, char* argv[], const int defaultRounds[2], struct TestOptions* options);
+
+// Function to report a failed check; printing stops after the first few failures
+void checkFailed(const struct TestOptions* options, const char* file, int line, const char* format, ...)
+    __attribute__((format(printf, 4, 5)));
+
+// Function to print the totals, returns the exit status of the test program
+int checkSummary(const char* name, const struct TestOptions* options);
+
+#define CHECK(options, condition, ...)                                      \
+    do {                                                                    \
+        checkCount++;                                                       \
+        if (!(condition)) {                                                 \
+            checkFailed((options), __FILE__, __LINE__, __VA_ARGS__);        \
+        }                                                                   \
+    } while (0)
+
+#endif
@@ -0,0 +1,257 @@
+// Property tests for the sorting engines: random sizes and value distributions, every engine of
+// the registry (engine.c) plus the Project 1 entry points, all checked against qsort() and
+// against each other.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "check.h"
+#include "rng.h"
+#include "engine.h"
+#include "sort.h"
+#include "select.h"
+#include "batch.h"
+
+enum Distribution {
+    DIST_RANDOM,     // Full int range, negatives and extremes included
+    DIST_SMALL,      // 0 .. 9, lots of duplicates
+    DIST_SORTED,
+    DIST_REVERSED,
+    DIST_EQUAL,
+    DIST_ORGAN,      // Ascending then descending
+    DIST_SAWTOOTH,   // Sorted runs of random length
+    DIST_NEARLY,     // Sorted with a few random swaps
+    NUM_DISTRIBUTIONS
+};
+
+static const char* distributionNames[] = {"random", "small", "sorted", "reversed", "equal", "organ",
+                                          "sawtooth", "nearly"};
+
+static const int thresholds[] = {1, 2, 3, 8, 16, 64, 1000};
+
+static int compareInts(const void* a, const void* b) {
+    int x = *(const int*) a, y = *(const int*) b;
+    return (x > y) - (x < y);
+}
+
+// Function to draw an input size: mostly small, sometimes up to maxSize
+static int drawSize(struct Rng* rng, int maxSize) {
+    uint64_t kind = rngBounded(rng, 10);
+    if (kind < 3) {
+        return (int) rngBounded(rng, 17);
+    }
+    if (kind < 7) {
+        return (int) rngBounded(rng, 1001);
+    }
+    return (int) rngBounded(rng, maxSize + 1);
+}
+
+static void fillInput(struct Rng* rng, int* arr, int n, enum Distribution distribution) {
+    static const int extremes[] = {INT_MIN, INT_MIN + 1, -1, 0, 1, INT_MAX - 1, INT_MAX};
+    for (int i = 0; i < n; i++) {
+        switch (distribution) {
+        case DIST_RANDOM:
+            arr[i] = rngBounded(rng, 20) == 0 ? extremes[rngBounded(rng, 7)] : (int) rngNext(rng);
+            break;
+        case DIST_SMALL: arr[i] = (int) rngBounded(rng, 10); break;
+        case DIST_SORTED: arr[i] = i; break;
+        case DIST_REVERSED: arr[i] = n - i; break;
+        case DIST_EQUAL: arr[i] = 42; break;
+        case DIST_ORGAN: arr[i] = i < n / 2 ? i : n - i; break;
+        default: arr[i] = i; break;
+        }
+    }
+    if (distribution == DIST_SAWTOOTH) {
+        int run = 1 + (int) rngBounded(rng, 64);
+        for (int i = 0; i < n; i++) arr[i] = i % run;
+    } else if (distribution == DIST_NEARLY) {
+        for (int s = 0; s < n / 50 + 1 && n > 1; s++) {
+            int a = (int) rngBounded(rng, n), b = (int) rngBounded(rng, n);
+            int t = arr[a];
+            arr[a] = arr[b];
+            arr[b] = t;
+        }
+    }
+}
+
+// Function to check one engine of the registry on input against the sorted reference
+static void checkEngine(const struct TestOptions* options, const struct Engine* engine, const int* input,
+                        const int* expected, int n, int threshold, const char* what) {
+    struct SortInput sortInput;
+    sortInput.n = n;
+    sortInput.threshold = threshold;
+    sortInput.arr = (int*) malloc((n + 1) * sizeof(int));
+    sortInput.scratchSize = engine->scratchSize != NULL ? engine->scratchSize(n) : 0;
+    sortInput.scratch = (int*) malloc((sortInput.scratchSize + 1) * sizeof(int));
+    memcpy(sortInput.arr, input, n * sizeof(int));
+
+    long comparisons = engine->sort(&sortInput);
+    CHECK(options, memcmp(sortInput.arr, expected, n * sizeof(int)) == 0, "%s: wrong order for %s", engine->name, what);
+    CHECK(options, comparisons >= 0 && (n > 1 || comparisons == 0), "%s: %ld comparisons for %s",
+          engine->name, comparisons, what);
+
+    free(sortInput.scratch);
+    free(sortInput.arr);
+}
+
+// Function to check the counting entry points of Project 1 against the reentrant ones
+static void checkGlobalVersions(const struct TestOptions* options, struct Rng* rng, const int* input,
+                                const int* expected, int n, int threshold, const char* what) {
+    int* arr = (int*) malloc((n + 1) * sizeof(int));
+    int* scratch = (int*) malloc((n / 2 + 2) * sizeof(int));
+    long comparisons = 0;
+
+    memcpy(arr, input, n * sizeof(int));
+    hybrid_merge_sort_r(arr, 0, n - 1, threshold, scratch, &comparisons);
+    memcpy(arr, input, n * sizeof(int));
+    key_comparisons = 0;
+    hybrid_merge_sort(arr, 0, n - 1, threshold);
+    CHECK(options, memcmp(arr, expected, n * sizeof(int)) == 0, "hybrid_merge_sort: wrong order for %s", what);
+    CHECK(options, key_comparisons == comparisons, "hybrid_merge_sort counted %d, hybrid_merge_sort_r %ld for %s",
+          key_comparisons, comparisons, what);
+
+    comparisons = 0;
+    memcpy(arr, input, n * sizeof(int));
+    heap_sort_r(arr, n, &comparisons);
+    memcpy(arr, input, n * sizeof(int));
+    key_comparisons = 0;
+    heap_sort(arr, n);
+    CHECK(options, memcmp(arr, expected, n * sizeof(int)) == 0, "heap_sort: wrong order for %s", what);
+    CHECK(options, key_comparisons == comparisons, "heap_sort counted %d, heap_sort_r %ld for %s",
+          key_comparisons, comparisons, what);
+
+    memcpy(arr, input, n * sizeof(int));
+    hybrid_merge_sort_low_memory(arr, 0, n - 1, threshold);
+    CHECK(options, memcmp(arr, expected, n * sizeof(int)) == 0, "hybrid_merge_sort_low_memory: wrong order for %s", what);
+
+    // Any buffer size works, down to none at all
+    int bufferSize = (int) rngBounded(rng, 4) == 0 ? 0 : (int) rngBounded(rng, n / 2 + 2);
+    comparisons = 0;
+    memcpy(arr, input, n * sizeof(int));
+    hybrid_merge_sort_low_memory_r(arr, 0, n - 1, threshold, scratch, bufferSize, &comparisons);
+    CHECK(options, memcmp(arr, expected, n * sizeof(int)) == 0,
+          "hybrid_merge_sort_low_memory_r: wrong order for %s with a %d int buffer", what, bufferSize);
+
+    free(scratch);
+    free(arr);
+}
+
+// Function to check nth_element, partial_sort and the streaming top-k for a random k
+static void checkSelection(const struct TestOptions* options, struct Rng* rng, const int* input,
+                           const int* expected, int n, const char* what) {
+    if (n == 0) {
+        return;
+    }
+    int k = (int) rngBounded(rng, n);
+    int* arr = (int*) malloc(n * sizeof(int));
+    long comparisons = 0;
+
+    memcpy(arr, input, n * sizeof(int));
+    nth_element(arr, n, k, &comparisons);
+    int ok = arr[k] == expected[k];
+    for (int i = 0; i < n && ok; i++) {
+        ok = i < k ? arr[i] <= arr[k] : arr[i] >= arr[k];
+    }
+    CHECK(options, ok, "nth_element: k = %d is not in place for %s", k, what);
+
+    memcpy(arr, input, n * sizeof(int));
+    partial_sort(arr, n, k, &comparisons);
+    CHECK(options, memcmp(arr, expected, k * sizeof(int)) == 0, "partial_sort: k = %d wrong prefix for %s", k, what);
+
+    // Feed the stream in chunks of random length
+    struct topk acc;
+    int keep = 1 + (int) rngBounded(rng, n);
+    topk_init(&acc, keep);
+    for (int i = 0; i < n;) {
+        int chunk = 1 + (int) rngBounded(rng, 4096);
+        if (chunk > n - i) {
+            chunk = n - i;
+        }
+        topk_add(&acc, input + i, chunk);
+        i += chunk;
+    }
+    int got = topk_result(&acc, arr);
+    CHECK(options, got == keep && memcmp(arr, expected, keep * sizeof(int)) == 0,
+          "topk: k = %d kept %d wrong elements for %s", keep, got, what);
+    topk_free(&acc);
+    free(arr);
+}
+
+// Function to sort a batch of random arrays with the batch sorter and check each of them
+static void checkBatch(const struct TestOptions* options, struct Rng* rng, int maxSize) {
+    int count = 1 + (int) rngBounded(rng, 40);
+    int threads = 1 + (int) rngBounded(rng, 4);
+    int threshold = thresholds[rngBounded(rng, sizeof(thresholds) / sizeof(thresholds[0]))];
+    struct sort_job* jobs = (struct sort_job*) malloc(count * sizeof(struct sort_job));
+    int** expected = (int**) malloc(count * sizeof(int*));
+
+    for (int i = 0; i < count; i++) {
+        // Now and then one large enough to be split across the workers
+        int size = rngBounded(rng, 8) == 0 ? 262144 + (int) rngBounded(rng, maxSize + 1) : drawSize(rng, maxSize);
+        jobs[i].size = size;
+        jobs[i].arr = (int*) malloc((size + 1) * sizeof(int));
+        expected[i] = (int*) malloc((size + 1) * sizeof(int));
+        fillInput(rng, jobs[i].arr, size, (enum Distribution) rngBounded(rng, NUM_DISTRIBUTIONS));
+        memcpy(expected[i], jobs[i].arr, size * sizeof(int));
+        qsort(expected[i], size, sizeof(int), compareInts);
+    }
+
+    struct batch_sorter* sorter = batch_sorter_create(threads, threshold);
+    CHECK(options, sorter != NULL, "batch_sorter_create(%d, %d) failed", threads, threshold);
+    if (sorter != NULL) {
+        batch_sort(sorter, jobs, count);
+        for (int i = 0; i < count; i++) {
+            CHECK(options, memcmp(jobs[i].arr, expected[i], jobs[i].size * sizeof(int)) == 0,
+                  "batch_sort: array %d of %d (size %d, %d threads) is wrong", i, count, jobs[i].size, threads);
+        }
+        batch_sorter_destroy(sorter);
+    }
+    for (int i = 0; i < count; i++) {
+        free(jobs[i].arr);
+        free(expected[i]);
+    }
+    free(expected);
+    free(jobs);
+}
+
+int main(int argc, char* argv[]) {
+    static const int defaultRounds[2] = {400, 4000};
+    struct TestOptions options;
+    if (parseTestOptions(argc, argv, defaultRounds, &options) != 0) {
+        return 2;
+    }
+    int maxSize = options.longMode ? 1 << 20 : 20000;
+
+    struct Rng rng;
+    rngSeed(&rng, options.seed, 0);
+
+    for (options.round = 0; options.round < options.rounds; options.round++) {
+        int n = drawSize(&rng, maxSize);
+        enum Distribution distribution = (enum Distribution) rngBounded(&rng, NUM_DISTRIBUTIONS);
+        int threshold = thresholds[rngBounded(&rng, sizeof(thresholds) / sizeof(thresholds[0]))];
+        char what[96];
+        snprintf(what, sizeof(what), "n = %d, %s input, threshold %d", n, distributionNames[distribution], threshold);
+
+        int* input = (int*) malloc((n + 1) * sizeof(int));
+        int* expected = (int*) malloc((n + 1) * sizeof(int));
+        fillInput(&rng, input, n, distribution);
+        memcpy(expected, input, n * sizeof(int));
+        qsort(expected, n, sizeof(int), compareInts);
+
+        for (int e = 0; e < numEngines; e++) {
+            if (engines[e].family == ENGINE_SORT) {
+                checkEngine(&options, &engines[e], input, expected, n, threshold, what);
+            }
+        }
+        checkGlobalVersions(&options, &rng, input, expected, n, threshold, what);
+        checkSelection(&options, &rng, input, expected, n, what);
+        if (options.round % 20 == 0) {
+            checkBatch(&options, &rng, options.longMode ? maxSize : 2000);
+        }
+
+        free(expected);
+        free(input);
+    }
+    return checkSummary("sort_test", &options);
+}
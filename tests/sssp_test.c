@@ -0,0 +1,790 @@
+// Differential tests for the shortest path engines: random graphs from the workload generators
+// and from a small generator with self-loops, parallel edges and unreachable parts. Every engine
+// of the registry (engine.c) and the point-to-point, contraction hierarchy, workspace, relabeling
+// and dynamic engines are checked against Bellman-Ford, as are the undirected graph and the
+// distance widths on paths far longer than INF.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+
+#include "check.h"
+#include "rng.h"
+#include "graph.h"
+#include "csr.h"
+#include "dijkstra.h"
+#include "dijkstra_variants.h"
+#include "undirected.h"
+#include "distance.h"
+#include "workload.h"
+#include "engine.h"
+#include "p2p.h"
+#include "ch.h"
+#include "workspace.h"
+#include "reorder.h"
+#include "dynamic.h"
+#include "graphio.h"
+#include "trace.h"
+
+// Sizes of one test case
+struct CaseLimits {
+    int maxV;
+    int chMaxV;        // Contraction hierarchies only on graphs up to this size
+    int dynamicMaxV;   // Dynamic updates, with Bellman-Ford after every update, up to this size
+    int updates;
+    int queries;       // Point-to-point targets per graph
+};
+
+// Function to compute reference distances: Bellman-Ford, stopping after a pass with no change
+static void bellmanFord(struct Graph* graph, int src, int* dist) {
+    for (int v = 0; v < graph->V; ++v) {
+        dist[v] = INF;
+    }
+    dist[src] = 0;
+    for (int pass = 0; pass < graph->V; ++pass) {
+        int changed = 0;
+        for (int u = 0; u < graph->V; ++u) {
+            if (dist[u] == INF) {
+                continue;
+            }
+            for (struct Edge* e = graph->array[u].head; e != NULL; e = e->next) {
+                if (dist[u] + e->weight < dist[e->dest]) {
+                    dist[e->dest] = dist[u] + e->weight;
+                    changed = 1;
+                }
+            }
+        }
+        if (!changed) {
+            break;
+        }
+    }
+}
+
+// Function to find the first vertex where two distance arrays differ, -1 if none
+static int firstDifference(const int* dist, const int* expected, int V) {
+    for (int v = 0; v < V; ++v) {
+        if (dist[v] != expected[v]) {
+            return v;
+        }
+    }
+    return -1;
+}
+
+// Function to build a small random graph: self-loops, parallel edges, and often a part
+// that cannot be reached from anywhere else
+static struct Graph* randomSmallGraph(struct Rng* rng, int V, int maxWeight) {
+    struct Graph* graph = createGraph(V);
+    int E = (int) rngBounded(rng, 4 * V + 1);
+    int reachable = rngBounded(rng, 2) ? V : 1 + (int) rngBounded(rng, V);
+    for (int i = 0; i < E; ++i) {
+        int u = (int) rngBounded(rng, V);
+        int v = u < reachable ? (int) rngBounded(rng, reachable) : (int) rngBounded(rng, V);
+        addEdge(graph, u, v, 1 + (int) rngBounded(rng, maxWeight));
+        if (rngBounded(rng, 10) == 0) {
+            addEdge(graph, u, v, 1 + (int) rngBounded(rng, maxWeight));
+        }
+    }
+    return graph;
+}
+
+// Function to make the graph of one case and describe it in what
+static struct Graph* makeGraph(struct Rng* rng, const struct CaseLimits* limits, char* what, size_t length) {
+    int V = 1 + (int) rngBounded(rng, rngBounded(rng, 4) == 0 ? limits->maxV : 200);
+    // Keep the longest possible path below INF
+    int maxWeight = (int) rngBounded(rng, 3) == 0 ? 1 : 1 + (int) rngBounded(rng, 1000);
+    if ((long) maxWeight * V >= INF / 2) {
+        maxWeight = INF / 2 / V;
+    }
+    int kind = (int) rngBounded(rng, 5);
+
+    if (kind == 4 || V < 4) {
+        snprintf(what, length, "small random graph, V = %d, weights up to %d", V, maxWeight);
+        return randomSmallGraph(rng, V, maxWeight);
+    }
+
+    long E = 1 + (long) rngBounded(rng, 8 * (uint64_t) V);
+    struct WeightSpec weights = {(enum WeightDistribution) rngBounded(rng, 4), 1, maxWeight};
+    uint64_t seed = rngNext(rng);
+    snprintf(what, length, "%s workload, V = %d, E = %ld, weights up to %d, seed %llu",
+             workloadName((enum WorkloadType) kind), V, E, maxWeight, (unsigned long long) seed);
+    return generateWorkloadGraph((enum WorkloadType) kind, V, E, &weights, seed);
+}
+
+// Function to check every SSSP engine of the registry, and the CSR form they run on
+static void checkEngines(const struct TestOptions* options, struct Graph* graph, struct CSRGraph* csr, int src,
+                         const int* expected, const char* what) {
+    int* dist = (int*) malloc(graph->V * sizeof(int));
+    CHECK(options, validateCSRGraph(csr) == 0, "graphToCSR made an invalid CSR graph for %s", what);
+
+    // The counted 4-ary template instances run the same search as dijkstraCSRDary(), comparison
+    // for comparison (graphToCSR keeps the adjacency list order), whatever their distance type
+    long quadComparisons = -1;
+    struct SSSPInput input = {graph, csr, src, narrowCSRWeights(csr), malloc(graph->V * sizeof(uint64_t))};
+    CHECK(options, input.csr16 != NULL, "narrowCSRWeights refused weights below 2^16 for %s", what);
+    for (int e = 0; e < numEngines; e++) {
+        if (engines[e].family != ENGINE_SSSP) {
+            continue;
+        }
+        for (int v = 0; v < graph->V; ++v) {
+            dist[v] = -1;
+        }
+        long comparisons = engines[e].sssp(&input, dist);
+        narrowDistances(&engines[e], &input, dist);
+        int v = firstDifference(dist, expected, graph->V);
+        CHECK(options, v < 0, "%s from %d: dist[%d] = %d, Bellman-Ford %d for %s", engines[e].name, src, v,
+              v < 0 ? 0 : dist[v], v < 0 ? 0 : expected[v], what);
+
+        const char* name = engines[e].name;
+        if (strcmp(name, "dijkstra-4ary") == 0) {
+            quadComparisons = comparisons;
+        } else if (strcmp(name, "tmpl-csr-4ary") == 0 || strcmp(name, "tmpl-list-4ary") == 0 ||
+                   strcmp(name, "tmpl-csr16-u32") == 0 || strcmp(name, "tmpl-csr-u64") == 0) {
+            CHECK(options, comparisons == quadComparisons, "%s counted %ld comparisons, dijkstra-4ary %ld for %s",
+                  name, comparisons, quadComparisons, what);
+        } else if (strlen(name) > 5 && strcmp(name + strlen(name) - 5, "-fast") == 0) {
+            CHECK(options, comparisons == 0, "%s counted %ld comparisons without counting for %s", name,
+                  comparisons, what);
+        }
+    }
+    if (input.csr16 != NULL) {
+        freeCSRGraph16(input.csr16);
+    }
+    free(input.wideDist);
+    free(dist);
+}
+
+// Function to check that every int engine stops at INF: paths of INF or more read as unreachable,
+// and weights near INT_MAX do not overflow, also in CH shortcuts (6 is contracted between two
+// of them). Engines on 16-bit weights refuse this graph.
+static void checkSaturation(const struct TestOptions* options) {
+    enum { V = 8 };
+    static const int expected[V] = {0, INF - 1, INF, 5, INF, INF - 1, INF, INF};
+    struct Graph* graph = createGraph(V);
+    addEdge(graph, 0, 1, INF - 1);
+    addEdge(graph, 1, 2, INF - 1);
+    addEdge(graph, 0, 3, 5);
+    addEdge(graph, 3, 4, INT_MAX);
+    addEdge(graph, 3, 5, INF - 6);
+    addEdge(graph, 0, 6, INT_MAX - 1);
+    addEdge(graph, 6, 7, INT_MAX - 1);
+    struct Graph* reverse = reverseGraph(graph);
+    struct CSRGraph* csr = graphToCSR(graph);
+    uint64_t wideDist[V];
+    struct SSSPInput input = {graph, csr, 0, NULL, wideDist};
+    int dist[V];
+    int settled = 0, comparisons = 0;
+
+    for (int e = 0; e < numEngines; e++) {
+        if (engines[e].family != ENGINE_SSSP || engines[e].needsCSR == 2) {
+            continue;
+        }
+        engines[e].sssp(&input, dist);
+        narrowDistances(&engines[e], &input, dist);
+        int v = firstDifference(dist, expected, V);
+        CHECK(options, v < 0, "%s past INF: dist[%d] = %d, expected %d", engines[e].name, v, v < 0 ? 0 : dist[v],
+              v < 0 ? 0 : expected[v]);
+    }
+
+    struct CHGraph* ch = buildCH(graph, &comparisons);
+    struct CHQuery* chState = createCHQuery(ch);
+    struct DijkstraWorkspace* ws = createDijkstraWorkspace(V);
+    for (int t = 0; t < V; ++t) {
+        int got[5] = {
+            dijkstraTo(graph, 0, t, &settled, &comparisons),
+            bidirectionalDijkstra(graph, reverse, 0, t, &settled, &comparisons),
+            aStar(graph, 0, t, zeroHeuristic, NULL, &settled, &comparisons),
+            dijkstraQuery(graph, ws, 0, t, &settled, &comparisons),
+            chQuery(ch, chState, 0, t, &settled, &comparisons),
+        };
+        static const char* names[5] = {"dijkstraTo", "bidirectionalDijkstra", "aStar", "dijkstraQuery", "chQuery"};
+        for (int q = 0; q < 5; ++q) {
+            CHECK(options, got[q] == expected[t], "%s 0 -> %d past INF: %d, expected %d", names[q], t, got[q],
+                  expected[t]);
+        }
+    }
+
+    struct DynamicSSSP* sssp = createDynamicSSSP(graph, 0, &comparisons);
+    int v = firstDifference(sssp->dist, expected, V);
+    CHECK(options, v < 0, "dynamic SSSP past INF: dist[%d] = %d, expected %d", v, v < 0 ? 0 : sssp->dist[v],
+          v < 0 ? 0 : expected[v]);
+    // Lengthening the tree edge 0->3 pushes 5 past INF as well
+    dynamicUpdateWeight(sssp, 0, 3, INF - 3, &comparisons);
+    CHECK(options, sssp->dist[3] == INF - 3 && sssp->dist[5] == INF && sssp->dist[4] == INF,
+          "dynamic SSSP past INF after an update: dist[3] = %d, dist[5] = %d, dist[4] = %d", sssp->dist[3],
+          sssp->dist[5], sssp->dist[4]);
+
+    freeDynamicSSSP(sssp);
+    freeDijkstraWorkspace(ws);
+    freeCHQuery(chState);
+    freeCH(ch);
+    freeCSRGraph(csr);
+    freeGraph(reverse);
+    freeGraph(graph);
+}
+
+// Function to draw a weight for checkDistanceWidths: with 16 bits the upper half of the range,
+// so that a long chain passes UINT32_MAX part way along an edge; otherwise small weights mixed
+// with ones close to INT32_MAX, so that short distances meet edges that overflow int
+static int wideWeight(struct Rng* rng, int narrow) {
+    if (narrow) {
+        return UINT16_MAX - (int) rngBounded(rng, UINT16_MAX / 2);
+    }
+    return rngBounded(rng, 2) ? 1 + (int) rngBounded(rng, 1000) : INT32_MAX - (int) rngBounded(rng, 1000);
+}
+
+// Function to check the distance types where they differ: a chain with random shortcuts whose
+// paths overflow int, and with 16-bit weights sometimes a chain long enough to pass UINT32_MAX.
+// Each type must give the exact 64-bit distance, or its infinity where that does not fit.
+static void checkDistanceWidths(const struct TestOptions* options, struct Rng* rng) {
+    int narrow = (int) rngBounded(rng, 2);
+    int V = narrow && rngBounded(rng, 4) == 0 ? 131073 + (int) rngBounded(rng, 4096) : 2 + (int) rngBounded(rng, 200);
+    struct EdgeList list;
+    initEdgeList(&list, 2 * V);
+    for (int v = 0; v + 1 < V; ++v) {
+        pushEdge(&list, v, v + 1, wideWeight(rng, narrow));
+    }
+    // Shortcuts, but none on the long chains: they would keep every distance short
+    for (int i = 0; i < (V > 65536 ? 0 : V / 4); ++i) {
+        pushEdge(&list, (int) rngBounded(rng, V), (int) rngBounded(rng, V), wideWeight(rng, narrow));
+    }
+    int heaviest = 0;
+    for (long i = 0; i < list.count; ++i) {
+        heaviest = list.edges[i].weight > heaviest ? list.edges[i].weight : heaviest;
+    }
+    struct CSRGraph* csr = buildCSRGraph(V, &list, 1, 1);
+    freeEdgeList(&list);
+
+    // 64-bit Bellman-Ford; no path here comes near UINT64_MAX
+    uint64_t* expected = (uint64_t*) malloc(V * sizeof(uint64_t));
+    for (int v = 0; v < V; ++v) {
+        expected[v] = DIST_INF_U64;
+    }
+    expected[0] = 0;
+    for (int changed = 1; changed;) {
+        changed = 0;
+        for (int u = 0; u < V; ++u) {
+            for (long e = csr->offsets[u]; expected[u] != DIST_INF_U64 && e < csr->offsets[u + 1]; ++e) {
+                if (expected[u] + (uint64_t) csr->weights[e] < expected[csr->targets[e]]) {
+                    expected[csr->targets[e]] = expected[u] + (uint64_t) csr->weights[e];
+                    changed = 1;
+                }
+            }
+        }
+    }
+
+    long comparisons = 0;
+    uint64_t* dist64 = (uint64_t*) malloc(V * sizeof(uint64_t));
+    uint32_t* dist32 = (uint32_t*) malloc(V * sizeof(uint32_t));
+    int* dist = (int*) malloc(V * sizeof(int));
+    dijkstraCSRDist64Fast(csr, 0, dist64, &comparisons);
+    dijkstraCSRQuadFast(csr, 0, dist, &comparisons);
+    for (int v = 0; v < V; ++v) {
+        CHECK(options, dist64[v] == expected[v], "uint64_t distances, V = %d: dist[%d] = %llu, expected %llu", V, v,
+              (unsigned long long) dist64[v], (unsigned long long) expected[v]);
+        int want = expected[v] < INF ? (int) expected[v] : INF;
+        CHECK(options, dist[v] == want, "int distances, V = %d: dist[%d] = %d, expected %d", V, v, dist[v], want);
+    }
+    struct CSRGraph16* csr16 = narrowCSRWeights(csr);
+    CHECK(options, (csr16 != NULL) == (heaviest <= UINT16_MAX), "narrowCSRWeights %s weights up to %d",
+          csr16 != NULL ? "narrowed" : "refused", heaviest);
+    if (csr16 != NULL) {
+        dijkstraCSR16Dist32Fast(csr16, 0, dist32, &comparisons);
+        for (int v = 0; v < V; ++v) {
+            uint32_t want = expected[v] < DIST_INF_U32 ? (uint32_t) expected[v] : DIST_INF_U32;
+            CHECK(options, dist32[v] == want, "uint32_t distances, V = %d: dist[%d] = %u, expected %u", V, v,
+                  dist32[v], want);
+        }
+        freeCSRGraph16(csr16);
+    }
+
+    free(dist);
+    free(dist32);
+    free(dist64);
+    free(expected);
+    freeCSRGraph(csr);
+}
+
+// Function to read the edges of graph as undirected ones, and check the undirected graph built
+// from them, and Dijkstra on it, against Bellman-Ford on the graph with both directions
+static void checkUndirected(const struct TestOptions* options, struct Graph* graph, int src, const char* what) {
+    int V = graph->V;
+    struct Graph* both = createGraph(V);
+    struct EdgeList list;
+    initEdgeList(&list, 16);
+    for (int u = 0; u < V; ++u) {
+        for (struct Edge* e = graph->array[u].head; e != NULL; e = e->next) {
+            pushEdge(&list, u, e->dest, e->weight);
+            addEdge(both, u, e->dest, e->weight);
+            addEdge(both, e->dest, u, e->weight);
+        }
+    }
+    struct UndirectedGraph* undirected = buildUndirectedGraph(V, &list);
+
+    // Each edge once in a row and, unless it is a self-loop, once in a reverse row
+    long selfLoops = 0;
+    for (long i = 0; i < list.count; ++i) {
+        selfLoops += list.edges[i].src == list.edges[i].dest;
+    }
+    CHECK(options, undirected->E == list.count && undirected->offsets[V] == list.count &&
+                   undirected->reverseOffsets[V] == list.count - selfLoops,
+          "undirected graph of %ld edges has %ld in rows, %ld in reverse rows for %s", list.count,
+          undirected->offsets[V], undirected->reverseOffsets[V], what);
+    int sorted = 1;
+    for (int x = 0; x < V && sorted; ++x) {
+        for (long e = undirected->offsets[x]; e < undirected->offsets[x + 1]; ++e) {
+            int high = undirected->ends[e] ^ x;
+            sorted &= high >= x && (e == undirected->offsets[x] || high >= (undirected->ends[e - 1] ^ x));
+        }
+    }
+    CHECK(options, sorted, "undirected graph rows are not sorted by higher end for %s", what);
+
+    int* expected = (int*) malloc(V * sizeof(int));
+    int* dist = (int*) malloc(V * sizeof(int));
+    long comparisons = 0;
+    bellmanFord(both, src, expected);
+    dijkstraUndirectedCounted(undirected, src, dist, &comparisons);
+    int v = firstDifference(dist, expected, V);
+    CHECK(options, v < 0, "dijkstraUndirectedCounted from %d: dist[%d] = %d, Bellman-Ford %d for %s", src, v,
+          v < 0 ? 0 : dist[v], v < 0 ? 0 : expected[v], what);
+    dijkstraUndirectedFast(undirected, src, dist, &comparisons);
+    v = firstDifference(dist, expected, V);
+    CHECK(options, v < 0, "dijkstraUndirectedFast from %d: dist[%d] = %d, Bellman-Ford %d for %s", src, v,
+          v < 0 ? 0 : dist[v], v < 0 ? 0 : expected[v], what);
+
+    free(dist);
+    free(expected);
+    freeUndirectedGraph(undirected);
+    freeEdgeList(&list);
+    freeGraph(both);
+}
+
+// Function to check that every row is sorted by (target, weight); strictly by target if unique
+static int rowsSorted(const struct CSRGraph* csr, int unique) {
+    for (int u = 0; u < csr->V; ++u) {
+        for (long e = csr->offsets[u] + 1; e < csr->offsets[u + 1]; ++e) {
+            int previous = csr->targets[e - 1], target = csr->targets[e];
+            if (previous > target || (previous == target && (unique || csr->weights[e - 1] > csr->weights[e]))) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// Function to check CSR construction from unordered edges: the parallel build over several lists,
+// sorting and deduplicating the rows, and the same through an edge stream file. Heavier copies of
+// the edges and self-loops are mixed in, which must not change any distance.
+static void checkConstruction(const struct TestOptions* options, struct Rng* rng, struct Graph* graph, int src,
+                              const int* expected, const char* what) {
+    int V = graph->V;
+    struct EdgeList all;
+    initEdgeList(&all, 16);
+    for (int u = 0; u < V; ++u) {
+        for (struct Edge* e = graph->array[u].head; e != NULL; e = e->next) {
+            pushEdge(&all, u, e->dest, e->weight);
+            if (rngBounded(rng, 4) == 0 && e->weight < INF / 2) {
+                pushEdge(&all, u, e->dest, e->weight + (int) rngBounded(rng, 3));
+            }
+        }
+        if (rngBounded(rng, 8) == 0) {
+            pushEdge(&all, u, u, (int) rngBounded(rng, 10));
+        }
+    }
+    for (long i = all.count - 1; i > 0; --i) {
+        long j = (long) rngBounded(rng, i + 1);
+        struct EdgeRecord swap = all.edges[i];
+        all.edges[i] = all.edges[j];
+        all.edges[j] = swap;
+    }
+
+    // Three uneven lists, built with two threads
+    struct EdgeList lists[3];
+    long cut1 = all.count / 5, cut2 = all.count / 2;
+    lists[0] = (struct EdgeList) {cut1, cut1, all.edges};
+    lists[1] = (struct EdgeList) {cut2 - cut1, cut2 - cut1, all.edges + cut1};
+    lists[2] = (struct EdgeList) {all.count - cut2, all.count - cut2, all.edges + cut2};
+
+    // Rows keep the order of the lists whatever the thread count
+    struct CSRGraph* serial = buildCSRGraph(V, lists, 3, 1);
+    struct CSRGraph* parallel = buildCSRGraph(V, lists, 3, 2);
+    CHECK(options, memcmp(serial->offsets, parallel->offsets, (V + 1) * sizeof(long)) == 0 &&
+                   memcmp(serial->targets, parallel->targets, all.count * sizeof(int)) == 0 &&
+                   memcmp(serial->weights, parallel->weights, all.count * sizeof(int)) == 0,
+          "CSR built from 3 lists by 2 threads differs from the serial build for %s", what);
+    freeCSRGraph(serial);
+    freeCSRGraph(parallel);
+
+    int* dist = (int*) malloc(V * sizeof(int));
+    int comparisons = 0;
+    struct CSRGraph* sorted = buildCSRGraph(V, lists, 3, 2);
+    normalizeCSRGraph(sorted, CSR_SORT_ROWS, 3);
+    CHECK(options, validateCSRGraph(sorted) == 0 && sorted->E == all.count && rowsSorted(sorted, 0),
+          "sorted CSR of %ld edges is invalid, has %ld edges or unsorted rows for %s", all.count, sorted->E, what);
+    dijkstraCSR(sorted, src, dist, &comparisons);
+    int v = firstDifference(dist, expected, V);
+    CHECK(options, v < 0, "sorted CSR from %d: dist[%d] = %d, Bellman-Ford %d for %s", src, v, v < 0 ? 0 : dist[v],
+          v < 0 ? 0 : expected[v], what);
+
+    struct CSRGraph* unique = buildCSRGraph(V, lists, 3, 3);
+    normalizeCSRGraph(unique, CSR_DEDUP | CSR_DROP_SELF_LOOPS, 2);
+    // Each kept edge is the first, lightest, of its run in the sorted rows
+    long distinct = 0, wrong = 0;
+    for (int u = 0; u < V; ++u) {
+        long e = unique->offsets[u];
+        for (long f = sorted->offsets[u]; f < sorted->offsets[u + 1]; ++f) {
+            int target = sorted->targets[f];
+            if (target == u || (f > sorted->offsets[u] && target == sorted->targets[f - 1])) {
+                continue;
+            }
+            distinct++;
+            wrong += e >= unique->offsets[u + 1] || unique->targets[e] != target ||
+                     unique->weights[e] != sorted->weights[f];
+            e++;
+        }
+        wrong += e != unique->offsets[u + 1];
+    }
+    CHECK(options, validateCSRGraph(unique) == 0 && unique->E == distinct && wrong == 0 && rowsSorted(unique, 1),
+          "deduplicated CSR has %ld edges for %ld distinct, %ld wrong for %s", unique->E, distinct, wrong, what);
+    dijkstraCSR(unique, src, dist, &comparisons);
+    v = firstDifference(dist, expected, V);
+    CHECK(options, v < 0, "deduplicated CSR from %d: dist[%d] = %d, Bellman-Ford %d for %s", src, v,
+          v < 0 ? 0 : dist[v], v < 0 ? 0 : expected[v], what);
+
+    // Through a stream file; its V ends at the largest id that has an edge
+    char path[] = "/tmp/sssp_test_edges_XXXXXX";
+    int fd = mkstemp(path);
+    CHECK(options, fd >= 0, "cannot create an edge stream file for %s", what);
+    if (fd >= 0) {
+        close(fd);
+        struct CSRGraph* streamed = writeEdgeStream(path, lists, 3) == 0
+                                        ? readEdgeStreamGraph(path, CSR_DEDUP | CSR_DROP_SELF_LOOPS, 2)
+                                        : NULL;
+        unlink(path);
+        int same = streamed != NULL && streamed->V <= V && streamed->E == unique->E &&
+                   unique->offsets[streamed->V] == unique->E &&
+                   memcmp(streamed->offsets, unique->offsets, (streamed->V + 1) * sizeof(long)) == 0 &&
+                   memcmp(streamed->targets, unique->targets, unique->E * sizeof(int)) == 0 &&
+                   memcmp(streamed->weights, unique->weights, unique->E * sizeof(int)) == 0;
+        CHECK(options, same, "CSR read from an edge stream differs from the deduplicated build for %s", what);
+        if (streamed != NULL) {
+            freeCSRGraph(streamed);
+        }
+
+        // An edge that alone reaches INF is turned down (with a message on stderr, so only once)
+        if (options->round == 0) {
+            struct EdgeRecord heavy = {0, 0, GRAPH_MAX_WEIGHT + 1};
+            struct EdgeList heavyList = {1, 1, &heavy};
+            streamed = writeEdgeStream(path, &heavyList, 1) == 0 ? readEdgeStreamGraph(path, 0, 1) : NULL;
+            unlink(path);
+            CHECK(options, streamed == NULL, "edge stream with a weight of %d was accepted", GRAPH_MAX_WEIGHT + 1);
+            if (streamed != NULL) {
+                freeCSRGraph(streamed);
+            }
+        }
+    }
+
+    free(dist);
+    freeCSRGraph(unique);
+    freeCSRGraph(sorted);
+    freeEdgeList(&all);
+}
+
+// Function to overwrite the int at position pos of a file, returns 0 on success
+static int patchInt(const char* path, long pos, int value) {
+    FILE* file = fopen(path, "r+b");
+    if (file == NULL) {
+        return -1;
+    }
+    int ok = fseek(file, pos, SEEK_SET) == 0 && fwrite(&value, sizeof(int), 1, file) == 1;
+    return fclose(file) == 0 && ok ? 0 : -1;
+}
+
+// Function to check that a hierarchy comes back unchanged from saveCH() and loadCH(), and that
+// loadCH() turns down a duplicate rank, an out of range target and counts the file cannot hold
+static void checkCHFile(const struct TestOptions* options, struct CHGraph* ch, const char* what) {
+    char path[] = "/tmp/sssp_test_ch_XXXXXX";
+    int fd = mkstemp(path);
+    CHECK(options, fd >= 0, "cannot create a hierarchy file for %s", what);
+    if (fd < 0) {
+        return;
+    }
+    close(fd);
+
+    int V = ch->V, up = ch->upOffsets[V];
+    struct CHGraph* loaded = saveCH(ch, path) == 0 ? loadCH(path) : NULL;
+    int same = loaded != NULL && loaded->V == V && memcmp(loaded->rank, ch->rank, V * sizeof(int)) == 0 &&
+               memcmp(loaded->upOffsets, ch->upOffsets, (V + 1) * sizeof(int)) == 0 &&
+               memcmp(loaded->upTargets, ch->upTargets, up * sizeof(int)) == 0 &&
+               memcmp(loaded->downOffsets, ch->downOffsets, (V + 1) * sizeof(int)) == 0;
+    CHECK(options, same, "hierarchy differs after saveCH() and loadCH() for %s", what);
+    if (loaded != NULL) {
+        freeCH(loaded);
+    }
+
+    // Layout: magic, 4 header ints, rank, upOffsets, upTargets, ...
+    long rankPos = 4 + 4 * sizeof(int);
+    long upTargetsPos = rankPos + (2L * V + 1) * sizeof(int);
+    if (V >= 2 && patchInt(path, rankPos, ch->rank[1]) == 0) {
+        loaded = loadCH(path);
+        CHECK(options, loaded == NULL, "loadCH() accepted a duplicate rank for %s", what);
+        if (loaded != NULL) {
+            freeCH(loaded);
+        }
+        patchInt(path, rankPos, ch->rank[0]);
+    }
+    long countPos[2] = {4 + sizeof(int), 4 + 2 * sizeof(int)};
+    int badCount[2] = {-1, INT_MAX - 1};
+    int goodCount[2] = {ch->shortcuts, up};
+    for (int i = 0; i < 2; ++i) {
+        if (patchInt(path, countPos[i], badCount[i]) == 0) {
+            loaded = loadCH(path);
+            CHECK(options, loaded == NULL, "loadCH() accepted header count %d for %s", badCount[i], what);
+            if (loaded != NULL) {
+                freeCH(loaded);
+            }
+            patchInt(path, countPos[i], goodCount[i]);
+        }
+    }
+    if (up > 0 && patchInt(path, upTargetsPos, V) == 0) {
+        loaded = loadCH(path);
+        CHECK(options, loaded == NULL, "loadCH() accepted an edge to vertex %d of %d for %s", V, V, what);
+        if (loaded != NULL) {
+            freeCH(loaded);
+        }
+    }
+    unlink(path);
+}
+
+// Function to check that a heap trace of real Dijkstra runs survives saveTrace() and loadTrace()
+// and replays on every backend, and that loadTrace() refuses traces that would index out of bounds
+static void checkTraceFile(const struct TestOptions* options, struct Graph* graph, struct CSRGraph* csr, int src,
+                           const char* what) {
+    char path[] = "/tmp/sssp_test_trace_XXXXXX";
+    int fd = mkstemp(path);
+    CHECK(options, fd >= 0, "cannot create a trace file for %s", what);
+    if (fd < 0) {
+        return;
+    }
+    close(fd);
+
+    struct Trace recorded, loaded;
+    int* dist = (int*) malloc(graph->V * sizeof(int));
+    int comparisons = 0;
+    initTrace(&recorded);
+    setDijkstraTrace(&recorded);
+    dijkstraDist(graph, src, dist, &comparisons);
+    dijkstraCSRDary(csr, src, dist, &comparisons);
+    setDijkstraTrace(NULL);
+
+    int ok = saveTrace(&recorded, path) == 0 && loadTrace(&loaded, path) == 0;
+    CHECK(options, ok && loaded.count == recorded.count &&
+                   memcmp(loaded.ops, recorded.ops, recorded.count * sizeof(struct TraceOp)) == 0,
+          "trace of %ld operations differs after saveTrace() and loadTrace() for %s", recorded.count, what);
+    for (int b = 0; b < numPQBackends && ok; ++b) {
+        long mismatches = 0;
+        replayTrace(&loaded, &pqBackends[b], &comparisons, &mismatches);
+        CHECK(options, mismatches == 0, "%s backend popped %ld keys that differ from the trace for %s",
+              pqBackends[b].name, mismatches, what);
+    }
+    if (ok) {
+        freeTrace(&loaded);
+    }
+    freeTrace(&recorded);
+    free(dist);
+
+    // A push before any RESET, a vertex beyond the capacity, a pop from an empty heap
+    static const struct TraceOp bad[3][2] = {
+        {{TRACE_PUSH, 0, 0}, {TRACE_RESET, 4, 0}},
+        {{TRACE_RESET, 4, 0}, {TRACE_PUSH, 4, 0}},
+        {{TRACE_RESET, 4, 0}, {TRACE_POP, 0, 0}},
+    };
+    for (int t = 0; t < 3; ++t) {
+        struct Trace trace = {2, 2, (struct TraceOp*) bad[t], NULL, 0};
+        ok = saveTrace(&trace, path) == 0 && loadTrace(&loaded, path) == 0;
+        CHECK(options, !ok, "loadTrace() accepted malformed trace %d", t);
+        if (ok) {
+            freeTrace(&loaded);
+        }
+    }
+    unlink(path);
+}
+
+// Function to check the query engines against the reference for a few targets
+static void checkQueries(const struct TestOptions* options, const struct CaseLimits* limits, struct Rng* rng,
+                         struct Graph* graph, struct CSRGraph* csr, int src, const int* expected, const char* what) {
+    int V = graph->V;
+    int settled = 0, comparisons = 0;
+    struct Graph* reverse = reverseGraph(graph);
+    struct Landmarks* landmarks = createLandmarks(graph, reverse, V < 4 ? V : 4, &comparisons);
+    struct CHGraph* ch = V <= limits->chMaxV ? buildCH(graph, &comparisons) : NULL;
+    struct CHQuery* chState = ch != NULL ? createCHQuery(ch) : NULL;
+    struct DijkstraWorkspace* ws = createDijkstraWorkspace(V);
+
+    for (int q = 0; q < limits->queries; ++q) {
+        int target = (int) rngBounded(rng, V);
+        int want = expected[target];
+        int got;
+
+        got = dijkstraTo(graph, src, target, &settled, &comparisons);
+        CHECK(options, got == want, "dijkstraTo %d -> %d: %d, expected %d for %s", src, target, got, want, what);
+        got = bidirectionalDijkstra(graph, reverse, src, target, &settled, &comparisons);
+        CHECK(options, got == want, "bidirectionalDijkstra %d -> %d: %d, expected %d for %s", src, target, got, want, what);
+        got = aStar(graph, src, target, zeroHeuristic, NULL, &settled, &comparisons);
+        CHECK(options, got == want, "aStar (zero) %d -> %d: %d, expected %d for %s", src, target, got, want, what);
+        got = aStar(graph, src, target, altHeuristic, landmarks, &settled, &comparisons);
+        CHECK(options, got == want, "aStar (ALT) %d -> %d: %d, expected %d for %s", src, target, got, want, what);
+        if (ch != NULL) {
+            got = chQuery(ch, chState, src, target, &settled, &comparisons);
+            CHECK(options, got == want, "chQuery %d -> %d: %d, expected %d for %s", src, target, got, want, what);
+        }
+        // The workspace is reused across queries, alternating representations
+        got = q % 2 ? dijkstraQueryCSR(csr, ws, src, target, &settled, &comparisons)
+                    : dijkstraQuery(graph, ws, src, target, &settled, &comparisons);
+        CHECK(options, got == want, "dijkstraQuery%s %d -> %d: %d, expected %d for %s", q % 2 ? "CSR" : "", src,
+              target, got, want, what);
+    }
+
+    // A full workspace query leaves every distance behind
+    dijkstraQuery(graph, ws, src, -1, &settled, &comparisons);
+    int bad = -1;
+    for (int v = 0; v < V && bad < 0; ++v) {
+        if (workspaceDist(ws, v) != expected[v]) {
+            bad = v;
+        }
+    }
+    CHECK(options, bad < 0, "workspaceDist(%d) = %d, expected %d after a full query from %d for %s", bad,
+          bad < 0 ? 0 : workspaceDist(ws, bad), bad < 0 ? 0 : expected[bad], src, what);
+
+    freeDijkstraWorkspace(ws);
+    if (ch != NULL) {
+        // A few rounds are enough; loadCH() reports every rejected file on stderr
+        if (options->round < 4) {
+            checkCHFile(options, ch, what);
+        }
+        freeCHQuery(chState);
+        freeCH(ch);
+    }
+    freeLandmarks(landmarks);
+    freeGraph(reverse);
+}
+
+// Function to check that relabeling the vertices does not change any distance
+static void checkRelabeling(const struct TestOptions* options, struct Rng* rng, struct CSRGraph* csr, int src,
+                            const int* expected, const char* what) {
+    enum VertexOrder order = (enum VertexOrder) rngBounded(rng, ORDER_DEGREE + 1);
+    struct Relabeling* relabeling = computeRelabeling(csr, order, rngNext(rng));
+    struct CSRGraph* relabeled = relabelCSRGraph(csr, relabeling);
+    int* byNewId = (int*) malloc(csr->V * sizeof(int));
+    int* dist = (int*) malloc(csr->V * sizeof(int));
+    int comparisons = 0;
+
+    dijkstraCSR(relabeled, relabeling->newId[src], byNewId, &comparisons);
+    restoreOriginalOrder(relabeling, byNewId, dist);
+    int v = firstDifference(dist, expected, csr->V);
+    CHECK(options, v < 0, "%s order: dist[%d] = %d, expected %d for %s", vertexOrderName(order), v,
+          v < 0 ? 0 : dist[v], v < 0 ? 0 : expected[v], what);
+
+    free(dist);
+    free(byNewId);
+    freeCSRGraph(relabeled);
+    freeRelabeling(relabeling);
+}
+
+// Function to apply random insertions, weight changes and deletions to graph and check the
+// dynamic distances against Bellman-Ford on the changed graph after each of them
+static void checkDynamic(const struct TestOptions* options, const struct CaseLimits* limits, struct Rng* rng,
+                         struct Graph* graph, int src, const char* what) {
+    int V = graph->V;
+    int comparisons = 0;
+    int* expected = (int*) malloc(V * sizeof(int));
+    struct DynamicSSSP* sssp = createDynamicSSSP(graph, src, &comparisons);
+
+    for (int i = 0; i < limits->updates; ++i) {
+        int u = (int) rngBounded(rng, V);
+        int kind = (int) rngBounded(rng, 3);
+        int weight = 1 + (int) rngBounded(rng, 20);
+        const char* operation = "insert";
+
+        // Updates and deletions need an existing edge; pick one of u's at random
+        struct Edge* edge = graph->array[u].head;
+        int degree = 0;
+        for (struct Edge* e = edge; e != NULL; e = e->next) {
+            degree++;
+        }
+        if (kind != 0 && degree > 0) {
+            for (int skip = (int) rngBounded(rng, degree); skip > 0; --skip) {
+                edge = edge->next;
+            }
+            int v = edge->dest;
+            if (kind == 1) {
+                operation = "update";
+                CHECK(options, dynamicUpdateWeight(sssp, u, v, weight, &comparisons) >= 0,
+                      "dynamicUpdateWeight(%d, %d) found no edge for %s", u, v, what);
+            } else {
+                operation = "delete";
+                CHECK(options, dynamicDeleteEdge(sssp, u, v, &comparisons) >= 0,
+                      "dynamicDeleteEdge(%d, %d) found no edge for %s", u, v, what);
+            }
+        } else {
+            dynamicInsertEdge(sssp, u, (int) rngBounded(rng, V), weight, &comparisons);
+        }
+
+        bellmanFord(graph, src, expected);
+        int v = firstDifference(sssp->dist, expected, V);
+        CHECK(options, v < 0, "after %s %d of %d at vertex %d: dist[%d] = %d, expected %d for %s", operation, i,
+              limits->updates, u, v, v < 0 ? 0 : sssp->dist[v], v < 0 ? 0 : expected[v], what);
+        if (v >= 0) {
+            break;  // Later updates build on the wrong distances
+        }
+    }
+    freeDynamicSSSP(sssp);
+    free(expected);
+}
+
+int main(int argc, char* argv[]) {
+    static const int defaultRounds[2] = {300, 3000};
+    struct TestOptions options;
+    if (parseTestOptions(argc, argv, defaultRounds, &options) != 0) {
+        return 2;
+    }
+    checkSaturation(&options);
+    struct CaseLimits limits = {3000, 1000, 300, 30, 8};
+    if (options.longMode) {
+        struct CaseLimits nightly = {50000, 10000, 2000, 100, 32};
+        limits = nightly;
+    }
+
+    struct Rng rng;
+    rngSeed(&rng, options.seed, 1);
+
+    for (options.round = 0; options.round < options.rounds; options.round++) {
+        char what[160];
+        struct Graph* graph = makeGraph(&rng, &limits, what, sizeof(what));
+        int src = (int) rngBounded(&rng, graph->V);
+        int* expected = (int*) malloc(graph->V * sizeof(int));
+        bellmanFord(graph, src, expected);
+
+        struct CSRGraph* csr = graphToCSR(graph);
+        checkEngines(&options, graph, csr, src, expected, what);
+        checkQueries(&options, &limits, &rng, graph, csr, src, expected, what);
+        checkRelabeling(&options, &rng, csr, src, expected, what);
+        // loadTrace() reports every refused trace on stderr, so only a few rounds
+        if (options.round < 4) {
+            checkTraceFile(&options, graph, csr, src, what);
+        }
+        freeCSRGraph(csr);
+        checkUndirected(&options, graph, src, what);
+        checkConstruction(&options, &rng, graph, src, expected, what);
+        checkDistanceWidths(&options, &rng);
+
+        // Last, since it changes the graph
+        if (graph->V <= limits.dynamicMaxV) {
+            checkDynamic(&options, &limits, &rng, graph, src, what);
+        }
+
+        free(expected);
+        freeGraph(graph);
+    }
+    return checkSummary("sssp_test", &options);
+}